@@ -7,6 +7,7 @@ container/RSD.icc
 core/Attitude.h
 core/Baseline.h
 core/Basis.h
+core/BlockPipeline.h
 core/Common.h
 core/Constants.h
 core/Cube.h
@@ -18,6 +19,7 @@ core/detail/InterpolateOrbit.h
 core/detail/InterpolateOrbit.icc
 core/Ellipsoid.h
 core/EMatrix.h
+core/EphemerisTable.h
 core/EulerAngles.h
 core/forward.h
 core/Interp1d.h
@@ -61,6 +63,7 @@ fft/FFTPlan.h
 fft/FFTPlan.icc
 fft/FFTUtil.h
 fft/FFTUtil.icc
+fft/PlanCache.h
 focus/Backproject.h
 focus/BistaticDelay.h
 focus/BistaticDelay.icc
@@ -69,6 +72,7 @@ focus/DryTroposphereModel.h
 focus/DryTroposphereModel.icc
 focus/GapMask.h
 focus/RangeComp.h
+geocode/Geo2rdrCache.h
 geocode/baseband.h
 geocode/geocodeSlc.h
 geocode/interpolate.h
@@ -90,6 +94,7 @@ geometry/TopoLayers.h
 image/forward.h
 image/ResampSlc.h
 image/ResampSlc.icc
+image/SincResampler.h
 image/Tile.h
 image/Tile.icc
 io/Constants.h
@@ -113,10 +118,13 @@ io/IH5.icc
 io/Raster.h
 io/Raster.icc
 io/Serialization.h
+io/WriteQueue.h
 matchtemplate/ampcor/correlators/correlators.h
 matchtemplate/ampcor/correlators/kernels.h
 matchtemplate/ampcor/correlators/Sequential.h
 matchtemplate/ampcor/correlators/Sequential.icc
+matchtemplate/ampcor/correlators/Streaming.h
+matchtemplate/ampcor/correlators/Streaming.icc
 matchtemplate/ampcor/dom/dom.h
 matchtemplate/ampcor/dom/Raster.h
 matchtemplate/ampcor/dom/Raster.icc
@@ -138,6 +146,7 @@ signal/Covariance.h
 signal/Covariance.icc
 signal/Crossmul.h
 signal/Crossmul.icc
+signal/FFTPlanCache.h
 signal/fftw3cxx.h
 signal/Filter.h
 signal/forward.h
@@ -3,10 +3,12 @@ core/Attitude.cpp
 core/Baseline.cpp
 core/BicubicInterpolator.cpp
 core/BilinearInterpolator.cpp
+core/BlockPipeline.cpp
 core/Constants.cpp
 core/DateTime.cpp
 core/detail/BuildOrbit.cpp
 core/Ellipsoid.cpp
+core/EphemerisTable.cpp
 core/EulerAngles.cpp
 core/Interpolator.cpp
 core/LUT2d.cpp
@@ -29,11 +31,13 @@ geometry/boundingbox.cpp
 fft/detail/ConfigureFFTLayout.cpp
 fft/detail/FFTWWrapper.cpp
 fft/detail/Threads.cpp
+fft/PlanCache.cpp
 focus/Backproject.cpp
 focus/Chirp.cpp
 focus/DryTroposphereModel.cpp
 focus/GapMask.cpp
 focus/RangeComp.cpp
+geocode/Geo2rdrCache.cpp
 geocode/baseband.cpp
 geocode/geocodeSlc.cpp
 geocode/interpolate.cpp
@@ -45,6 +49,7 @@ geometry/geometry.cpp
 geometry/RTC.cpp
 geometry/Topo.cpp
 image/ResampSlc.cpp
+image/SincResampler.cpp
 io/gdal/Dataset.cpp
 io/gdal/detail/MemoryMap.cpp
 io/gdal/GeoTransform.cpp
@@ -52,8 +57,10 @@ io/gdal/SpatialReference.cpp
 io/IH5.cpp
 io/IH5Dataset.cpp
 io/Raster.cpp
+io/WriteQueue.cpp
 matchtemplate/ampcor/correlators/c2r.cpp
 matchtemplate/ampcor/correlators/correlate.cpp
+matchtemplate/ampcor/correlators/correlateFFT.cpp
 matchtemplate/ampcor/correlators/detect.cpp
 matchtemplate/ampcor/correlators/maxcor.cpp
 matchtemplate/ampcor/correlators/migrate.cpp
@@ -6,6 +6,8 @@
 
 #include "Interpolator.h"
 
+#include <algorithm>
+
 /*
  * Returns the cubic-interpolated value between the middle two
  * of four evenly spaced points.
@@ -49,18 +51,46 @@ U isce3::core::BicubicInterpolator<U>::interp_impl(double x, double y,
     const int x0 = std::floor(x);
     const int y0 = std::floor(y);
 
+    // Neighbors outside of the matrix take the value at its edge (as in the
+    // cell polynomials of LUT2d)
+    const int nrows = z.rows();
+    const int ncols = z.cols();
+    auto clampRow = [nrows](int i) {
+        return std::min(std::max(i, 0), nrows - 1);
+    };
+    auto clampCol = [ncols](int j) {
+        return std::min(std::max(j, 0), ncols - 1);
+    };
+    const int c0 = clampCol(x0 - 1), c1 = clampCol(x0);
+    const int c2 = clampCol(x0 + 1), c3 = clampCol(x0 + 2);
+
     // Compute intermediate interpolation values
     U intp[4];
     for (int i = -1; i < 3; i++) {
-        intp[i+1] = cubicInterpolate<U>(z(y0+i, x0-1),
-                                        z(y0+i, x0  ),
-                                        z(y0+i, x0+1),
-                                        z(y0+i, x0+2), x-x0);
+        const int r = clampRow(y0 + i);
+        intp[i+1] = cubicInterpolate<U>(z(r, c0),
+                                        z(r, c1),
+                                        z(r, c2),
+                                        z(r, c3), x-x0);
     }
     // Compute final result
     return cubicInterpolate<U>(intp[0], intp[1], intp[2], intp[3], y - y0);
 }
 
+/** @param[in] x X-coordinates to interpolate
+  * @param[in] y Y-coordinates to interpolate
+  * @param[in] n Number of points
+  * @param[in] z 2D matrix to interpolate
+  * @param[out] out Interpolated values */
+template<class U>
+void isce3::core::BicubicInterpolator<U>::interp_batch_impl(
+        const double* x, const double* y, size_t n, const Map& z, U* out) const
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = BicubicInterpolator<U>::interp_impl(x[i], y[i], z);
+    }
+}
+
 // Forward declaration of classes
 template class isce3::core::BicubicInterpolator<double>;
 template class isce3::core::BicubicInterpolator<float>;
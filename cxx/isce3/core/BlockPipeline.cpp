@@ -0,0 +1,65 @@
+#include "BlockPipeline.h"
+
+#include <future>
+#include <utility>
+
+namespace isce3 { namespace core {
+
+BlockPipeline & BlockPipeline::compute(StageFn fn)
+{
+    _stages.push_back({std::move(fn), false});
+    return *this;
+}
+
+BlockPipeline & BlockPipeline::io(StageFn fn)
+{
+    _stages.push_back({std::move(fn), true});
+    return *this;
+}
+
+void BlockPipeline::run(int nblocks) const
+{
+    const int nstages = numStages();
+    const int nslots = numSlots();
+    if (nblocks <= 0 || nstages == 0) {
+        return;
+    }
+
+    // stage s of block b runs during step b + s
+    const int nsteps = nblocks + nstages - 1;
+    for (int step = 0; step < nsteps; ++step) {
+
+        // run all I/O stages scheduled for this step, in stage order
+        auto run_io = [&, step]() {
+            for (int s = 0; s < nstages; ++s) {
+                const int block = step - s;
+                if (_stages[s].is_io and block >= 0 and block < nblocks) {
+                    _stages[s].fn(block, block % nslots);
+                }
+            }
+        };
+
+        // launch I/O on the background thread while the compute stages run
+        // on this one (the future's destructor joins the background thread
+        // if a compute stage throws)
+        std::future<void> io_done;
+        if (_async) {
+            io_done = std::async(std::launch::async, run_io);
+        }
+
+        for (int s = 0; s < nstages; ++s) {
+            const int block = step - s;
+            if (not _stages[s].is_io and block >= 0 and block < nblocks) {
+                _stages[s].fn(block, block % nslots);
+            }
+        }
+
+        if (_async) {
+            io_done.get();
+        } else {
+            run_io();
+        }
+    }
+}
+
+}}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "forward.h"
+
+#include <functional>
+#include <vector>
+
+namespace isce3 { namespace core {
+
+/**
+ * Software-pipelined executor for block-wise processing loops.
+ *
+ * A pipeline is an ordered list of stages, each of which is applied to every
+ * block in turn. Compute stages run on the calling thread (and may use OpenMP
+ * internally), while I/O stages run on a single background thread. Stage
+ * \f$s\f$ of block \f$b\f$ is executed during pipeline step \f$b + s\f$, so
+ * that e.g. with stages {read, compute, write} the read of block N+1 and the
+ * write of block N-1 overlap with the computation of block N.
+ *
+ * Within each step all I/O stages are run sequentially on the same background
+ * thread in stage order, so readers and writers never access GDAL datasets
+ * concurrently with each other. Every stage sees the blocks in increasing
+ * order.
+ *
+ * At most numSlots() consecutive blocks are in flight at any time. Each stage
+ * function receives the block index and a slot index in [0, numSlots()) that
+ * is unique among the in-flight blocks, so that callers can preallocate a
+ * fixed set of per-slot buffers and keep memory usage bounded.
+ */
+class BlockPipeline {
+public:
+
+    /** Stage callback, invoked as fn(block, slot) */
+    using StageFn = std::function<void(int, int)>;
+
+    /** Append a stage that runs on the calling thread */
+    BlockPipeline & compute(StageFn fn);
+
+    /** Append a stage that runs on the background I/O thread */
+    BlockPipeline & io(StageFn fn);
+
+    /** Number of stages */
+    int numStages() const { return _stages.size(); }
+
+    /** Number of per-block buffer slots required by the pipeline */
+    int numSlots() const { return _stages.size(); }
+
+    /**
+     * Enable or disable asynchronous execution of I/O stages (default:
+     * enabled). When disabled, all stages run on the calling thread in the
+     * same order, which is useful for debugging and benchmarking.
+     */
+    void async(bool flag) { _async = flag; }
+
+    /** Get asynchronous execution flag */
+    bool async() const { return _async; }
+
+    /**
+     * Run all stages over blocks [0, nblocks).
+     *
+     * Exceptions thrown by any stage are propagated to the caller after all
+     * outstanding work of the current step has completed.
+     *
+     * \param[in] nblocks Number of blocks
+     */
+    void run(int nblocks) const;
+
+private:
+    struct Stage {
+        StageFn fn;
+        bool is_io;
+    };
+
+    std::vector<Stage> _stages;
+    bool _async = true;
+};
+
+}}
@@ -65,6 +65,10 @@ const short LAYOVER_VALUE = 2;
 const int AREA_PROJECTION_RADAR_GRID_MARGIN = 100;
 const float AREA_PROJECTION_MIN_VALID_SAMPLES_RATIO = 0.75;
 
+/** Area projection geogrid block length (before upsampling) used when
+ * results must not depend on the number of threads **/
+const int AREA_PROJECTION_DETERMINISTIC_BLOCK_LENGTH = 64;
+
 /** Convert decimal degrees to meters approximately */
 double inline decimaldeg2meters(double deg) { return deg * (M_PI/180.0) * 6.37e6; }
 
@@ -0,0 +1,210 @@
+#include "EphemerisTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <isce3/except/Error.h>
+
+#include "detail/InterpolateOrbit.h"
+
+using isce3::error::ErrorCode;
+using isce3::error::getErrorString;
+
+namespace isce3 { namespace core {
+
+namespace {
+
+// Fit the polynomial of degree ncoeffs - 1 through samples y at nodes u and
+// return its coefficients in powers of u
+template<int ncoeffs>
+void fitPolynomial(const double (&u)[ncoeffs], double (&y)[ncoeffs],
+                   double (&coeffs)[ncoeffs])
+{
+    // Newton divided differences (computed in place)
+    for (int j = 1; j < ncoeffs; ++j) {
+        for (int i = ncoeffs - 1; i >= j; --i) {
+            y[i] = (y[i] - y[i - 1]) / (u[i] - u[i - j]);
+        }
+    }
+
+    // expand the Newton form into powers of u, starting from the
+    // highest-order divided difference
+    std::fill(coeffs, coeffs + ncoeffs, 0.);
+    coeffs[0] = y[ncoeffs - 1];
+    for (int k = ncoeffs - 2; k >= 0; --k) {
+        // multiply by (u - u[k]) and add y[k]
+        for (int i = ncoeffs - 1; i > 0; --i) {
+            coeffs[i] = coeffs[i - 1] - u[k] * coeffs[i];
+        }
+        coeffs[0] = y[k] - u[k] * coeffs[0];
+    }
+}
+
+// Evaluate a polynomial with Horner's method
+template<int ncoeffs>
+inline double horner(const double (&coeffs)[ncoeffs], double u)
+{
+    double y = coeffs[ncoeffs - 1];
+    for (int i = ncoeffs - 2; i >= 0; --i) {
+        y = y * u + coeffs[i];
+    }
+    return y;
+}
+
+// Evaluate the derivative of a polynomial with Horner's method
+template<int ncoeffs>
+inline double hornerDerivative(const double (&coeffs)[ncoeffs], double u)
+{
+    double y = (ncoeffs - 1) * coeffs[ncoeffs - 1];
+    for (int i = ncoeffs - 2; i >= 1; --i) {
+        y = y * u + i * coeffs[i];
+    }
+    return y;
+}
+
+} // namespace
+
+EphemerisTable::EphemerisTable(const Orbit & orbit)
+:
+    _time(orbit.time()),
+    _interp_method(orbit.interpMethod())
+{
+    // leave the table empty if the interpolant cannot be formed, so that
+    // interpolation reports the same error as the orbit would
+    if (orbit.size() < minStateVecs(_interp_method)) {
+        return;
+    }
+    _valid = true;
+
+    // Chebyshev nodes on [-1/2, 1/2], relative to the interval center
+    double u[ncoeffs];
+    for (int k = 0; k < ncoeffs; ++k) {
+        u[k] = 0.5 * std::cos((2 * k + 1) * M_PI / (2 * ncoeffs));
+    }
+
+    // within each interval the interpolant is a polynomial of degree at most
+    // ncoeffs - 1, so it is fully determined by its values at the nodes
+    _segments.resize(orbit.size() - 1);
+    for (int s = 0; s < orbit.size() - 1; ++s) {
+        Vec3 pos[ncoeffs], vel[ncoeffs];
+        for (int k = 0; k < ncoeffs; ++k) {
+            const double t = _time[s] + (0.5 + u[k]) * spacing();
+            detail::interpolateOrbit(&pos[k], &vel[k], orbit, t,
+                                     OrbitInterpBorderMode::Extrapolate);
+        }
+
+        Segment & segment = _segments[s];
+        for (int i = 0; i < 3; ++i) {
+            double y[ncoeffs];
+            for (int k = 0; k < ncoeffs; ++k) { y[k] = pos[k][i]; }
+            fitPolynomial(u, y, segment.position[i]);
+
+            for (int k = 0; k < ncoeffs; ++k) { y[k] = vel[k][i]; }
+            fitPolynomial(u, y, segment.velocity[i]);
+        }
+    }
+}
+
+ErrorCode EphemerisTable::_check(Vec3 * position, Vec3 * velocity,
+                                 Vec3 * acceleration, double t,
+                                 OrbitInterpBorderMode border_mode) const
+{
+    // make sure we have enough state vectors to form the interpolant
+    if (not _valid) {
+        return ErrorCode::OrbitInterpSizeError;
+    }
+
+    // check if interpolation time is outside orbit domain
+    if (t < startTime() || t > endTime()) {
+        if (border_mode == OrbitInterpBorderMode::FillNaN) {
+            constexpr static double nan = std::numeric_limits<double>::quiet_NaN();
+            if (position) { *position = {nan, nan, nan}; }
+            if (velocity) { *velocity = {nan, nan, nan}; }
+            if (acceleration) { *acceleration = {nan, nan, nan}; }
+        }
+        if (border_mode != OrbitInterpBorderMode::Extrapolate) {
+            return ErrorCode::OrbitInterpDomainError;
+        }
+    }
+
+    return ErrorCode::Success;
+}
+
+void EphemerisTable::_eval(Vec3 * position, Vec3 * velocity,
+                           Vec3 * acceleration, double t) const
+{
+    // locate the interval containing t (extrapolating with the polynomials
+    // of the first and last intervals, like the orbit interpolant)
+    const double tau = (t - startTime()) / spacing();
+    const double last = static_cast<double>(_segments.size() - 1);
+    const double s = std::min(std::max(std::floor(tau), 0.), last);
+    const double u = tau - s - 0.5;
+    const Segment & segment = _segments[static_cast<size_t>(s)];
+
+    if (position) {
+        *position = {horner(segment.position[0], u),
+                     horner(segment.position[1], u),
+                     horner(segment.position[2], u)};
+    }
+    if (velocity) {
+        *velocity = {horner(segment.velocity[0], u),
+                     horner(segment.velocity[1], u),
+                     horner(segment.velocity[2], u)};
+    }
+    if (acceleration) {
+        *acceleration = Vec3{hornerDerivative(segment.velocity[0], u),
+                             hornerDerivative(segment.velocity[1], u),
+                             hornerDerivative(segment.velocity[2], u)}
+                        / spacing();
+    }
+}
+
+ErrorCode EphemerisTable::interpolate(Vec3 * position, Vec3 * velocity,
+                                      Vec3 * acceleration, double t,
+                                      OrbitInterpBorderMode border_mode) const
+{
+    ErrorCode status = _check(position, velocity, acceleration, t, border_mode);
+
+    // check for errors
+    if (status != ErrorCode::Success) {
+        if (border_mode == OrbitInterpBorderMode::Error) {
+            std::string errmsg = getErrorString(status);
+            throw isce3::except::OutOfRange(ISCE_SRCINFO(), errmsg);
+        }
+        return status;
+    }
+
+    _eval(position, velocity, acceleration, t);
+    return status;
+}
+
+ErrorCode EphemerisTable::interpolate(const double * t, size_t n,
+                                      Vec3 * position, Vec3 * velocity,
+                                      Vec3 * acceleration,
+                                      OrbitInterpBorderMode border_mode) const
+{
+    ErrorCode status = ErrorCode::Success;
+    for (size_t i = 0; i < n; ++i) {
+        Vec3 * pos = position ? position + i : nullptr;
+        Vec3 * vel = velocity ? velocity + i : nullptr;
+        Vec3 * acc = acceleration ? acceleration + i : nullptr;
+
+        ErrorCode point_status = _check(pos, vel, acc, t[i], border_mode);
+        if (point_status != ErrorCode::Success) {
+            if (border_mode == OrbitInterpBorderMode::Error) {
+                std::string errmsg = getErrorString(point_status);
+                throw isce3::except::OutOfRange(ISCE_SRCINFO(), errmsg);
+            }
+            if (status == ErrorCode::Success) {
+                status = point_status;
+            }
+            continue;
+        }
+
+        _eval(pos, vel, acc, t[i]);
+    }
+    return status;
+}
+
+}}
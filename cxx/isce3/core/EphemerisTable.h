@@ -0,0 +1,145 @@
+#pragma once
+
+#include <isce3/error/ErrorCode.h>
+#include <vector>
+
+#include "Orbit.h"
+#include "Vector.h"
+
+namespace isce3 { namespace core {
+
+/**
+ * Piecewise polynomial representation of an orbit for fast interpolation
+ *
+ * Within each interval between consecutive state vectors, the Hermite and
+ * Legendre interpolants of an Orbit are polynomials in time (of degree 7 and
+ * 8 respectively). This table computes the coefficients of these polynomials
+ * once, so that interpolation reduces to locating the interval and evaluating
+ * the polynomials, instead of forming the interpolant from the state vectors
+ * on every call. Acceleration is obtained as the derivative of the velocity
+ * polynomial.
+ *
+ * Interpolated values match those of Orbit::interpolate to within rounding
+ * error (well below a micrometer), including when extrapolating a fraction of
+ * an interval outside of the orbit domain. The table provides
+ * the same interface as Orbit for interpolation, so that it can be used
+ * in place of an Orbit in the geometry kernels.
+ */
+class EphemerisTable {
+public:
+
+    EphemerisTable() = default;
+
+    /** Compute the piecewise polynomials of an orbit */
+    explicit
+    EphemerisTable(const Orbit & orbit);
+
+    /** Interpolation method of the orbit */
+    OrbitInterpMethod interpMethod() const { return _interp_method; }
+
+    /** Time of first state vector relative to reference epoch (s) */
+    double startTime() const { return _time.first(); }
+
+    /** Time of center of orbit relative to reference epoch (s) */
+    double midTime() const { return startTime() + 0.5 * (size() - 1) * spacing(); }
+
+    /** Time of last state vector relative to reference epoch (s) */
+    double endTime() const { return _time.last(); }
+
+    /** Time interval between state vectors (s) */
+    double spacing() const { return _time.spacing(); }
+
+    /** Number of state vectors in orbit */
+    int size() const { return _time.size(); }
+
+    /** Get state vector times relative to reference epoch (s) */
+    const Linspace<double> & time() const { return _time; }
+
+    /**
+     * Interpolate platform position and/or velocity
+     *
+     * Equivalent to Orbit::interpolate.
+     *
+     * \param[out] position Interpolated position
+     * \param[out] velocity Interpolated velocity
+     * \param[in] t Interpolation time
+     * \param[in] border_mode Mode for handling interpolation outside orbit
+     * domain
+     * \return Error code indicating exit status
+     */
+    isce3::error::ErrorCode
+    interpolate(Vec3 * position, Vec3 * velocity, double t,
+                OrbitInterpBorderMode border_mode =
+                        OrbitInterpBorderMode::Error) const
+    {
+        return interpolate(position, velocity, nullptr, t, border_mode);
+    }
+
+    /**
+     * Interpolate platform position, velocity and/or acceleration
+     *
+     * Outputs given as null pointers are not computed.
+     *
+     * \param[out] position Interpolated position
+     * \param[out] velocity Interpolated velocity
+     * \param[out] acceleration Interpolated acceleration
+     * \param[in] t Interpolation time
+     * \param[in] border_mode Mode for handling interpolation outside orbit
+     * domain
+     * \return Error code indicating exit status
+     */
+    isce3::error::ErrorCode
+    interpolate(Vec3 * position, Vec3 * velocity, Vec3 * acceleration,
+                double t,
+                OrbitInterpBorderMode border_mode =
+                        OrbitInterpBorderMode::Error) const;
+
+    /**
+     * Interpolate platform position, velocity and/or acceleration at a batch
+     * of times
+     *
+     * Outputs given as null pointers are not computed. Otherwise they must
+     * hold \p n elements.
+     *
+     * \param[in] t Interpolation times
+     * \param[in] n Number of interpolation times
+     * \param[out] position Interpolated positions
+     * \param[out] velocity Interpolated velocities
+     * \param[out] acceleration Interpolated accelerations
+     * \param[in] border_mode Mode for handling interpolation outside orbit
+     * domain
+     * \return Error code of the first time that failed, or Success
+     */
+    isce3::error::ErrorCode
+    interpolate(const double * t, size_t n, Vec3 * position, Vec3 * velocity,
+                Vec3 * acceleration = nullptr,
+                OrbitInterpBorderMode border_mode =
+                        OrbitInterpBorderMode::Error) const;
+
+private:
+    // Number of polynomial coefficients per interval
+    static constexpr int ncoeffs = 9;
+
+    // Coefficients of the position and velocity polynomials of an interval,
+    // in powers of the normalized time from the center of the interval
+    struct Segment {
+        double position[3][ncoeffs];
+        double velocity[3][ncoeffs];
+    };
+
+    // Check the interpolation time, returning the status to report
+    isce3::error::ErrorCode _check(Vec3 * position, Vec3 * velocity,
+                                   Vec3 * acceleration, double t,
+                                   OrbitInterpBorderMode border_mode) const;
+
+    // Evaluate the polynomials of the interval containing t
+    void _eval(Vec3 * position, Vec3 * velocity, Vec3 * acceleration,
+               double t) const;
+
+    Linspace<double> _time;
+    OrbitInterpMethod _interp_method = OrbitInterpMethod::Hermite;
+    bool _valid = false;
+    std::vector<Segment> _segments;
+};
+
+}}
@@ -29,6 +29,15 @@ protected:
     /** Base implementation for all types */
     virtual U interp_impl(double x, double y, const Map& map) const = 0;
 
+    /** Batch implementation (calls interp_impl for each point by default) */
+    virtual void interp_batch_impl(const double* x, const double* y, size_t n,
+                                   const Map& map, U* out) const
+    {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = interp_impl(x[i], y[i], map);
+        }
+    }
+
 public:
 
     /** Interpolate at a given coordinate for an input Eigen::Map */
@@ -63,6 +72,31 @@ public:
         return interp_impl(x, y, z);
     }
 
+    /**
+     * Interpolate at a batch of coordinates for an input Eigen::Map
+     *
+     * Equivalent to interpolating each point in turn, with a single virtual
+     * call for the whole batch.
+     *
+     * @param[in]  x   X-coordinates to interpolate
+     * @param[in]  y   Y-coordinates to interpolate
+     * @param[in]  n   Number of points
+     * @param[in]  map 2D data to interpolate
+     * @param[out] out Interpolated values
+     */
+    void interpolate(const double* x, const double* y, size_t n,
+                     const Map& map, U* out) const
+    {
+        interp_batch_impl(x, y, n, map, out);
+    }
+
+    /** Interpolate at a batch of coordinates for an input isce3::core::Matrix */
+    void interpolate(const double* x, const double* y, size_t n,
+                     const Matrix<U>& z, U* out) const
+    {
+        interp_batch_impl(x, y, n, z.map(), out);
+    }
+
     /** Return interpolation method. */
     dataInterpMethod method() const { return _method; }
 
@@ -82,6 +116,10 @@ class isce3::core::BilinearInterpolator : public isce3::core::Interpolator<U> {
     /** Interpolate at a given coordinate. */
     U interp_impl(double x, double y, const Map& z) const override;
 
+    /** Interpolate at a batch of coordinates. */
+    void interp_batch_impl(const double* x, const double* y, size_t n,
+                           const Map& z, U* out) const override;
+
 public:
     /** Default constructor */
     BilinearInterpolator() : super_t {BILINEAR_METHOD} {}
@@ -100,6 +138,10 @@ class isce3::core::BicubicInterpolator : public isce3::core::Interpolator<U> {
     /** Interpolate at a given coordinate. */
     U interp_impl(double x, double y, const Map& z) const override;
 
+    /** Interpolate at a batch of coordinates. */
+    void interp_batch_impl(const double* x, const double* y, size_t n,
+                           const Map& z, U* out) const override;
+
 public:
     /** Default constructor */
     BicubicInterpolator() : super_t {BICUBIC_METHOD} {}
@@ -119,6 +161,10 @@ class isce3::core::NearestNeighborInterpolator :
     /** Interpolate at a given coordinate. */
     U interp_impl(double x, double y, const Map& z) const override;
 
+    /** Interpolate at a batch of coordinates. */
+    void interp_batch_impl(const double* x, const double* y, size_t n,
+                           const Map& z, U* out) const override;
+
 public:
     /** Default constructor */
     NearestNeighborInterpolator() : super_t {NEAREST_METHOD} {}
@@ -141,20 +187,39 @@ public:
     /** Interpolate at a given coordinate. */
     U interp_impl(double x, double y, const Map& z) const override;
 
+    /**
+     * Interpolate at a batch of coordinates.
+     *
+     * The row splines of a window are reused for consecutive points that
+     * share it.
+     */
+    void interp_batch_impl(const double* x, const double* y, size_t n,
+                           const Map& z, U* out) const override;
+
     // Inherit overloads for other datatypes
     using super_t::interpolate;
 
+    /** Largest supported spline order */
+    static constexpr size_t maxOrder = 20;
+
     // Data members
 private:
     size_t _order;
 
     // Utility spline functions
 private:
-    void _initSpline(const std::valarray<U>&, int, std::valarray<U>&,
-                     std::valarray<U>&) const;
+    void _window(double x, double y, int& i0, int& j0) const;
+
+    void _loadRow(const Map& z, int i, int j0, U* A) const;
 
-    U _spline(double, const std::valarray<U>&, int,
-              const std::valarray<U>&) const;
+    void _loadWindow(const Map& z, int i0, int j0, U* A, U* R) const;
+
+    U _evalWindow(double x, double y, int i0, int j0, const U* A,
+                  const U* R) const;
+
+    void _initSpline(const U*, int, U*, U*) const;
+
+    U _spline(double, const U*, int, const U*) const;
 };
 
 /** Definition of Sinc2dInterpolator */
@@ -167,6 +232,10 @@ class isce3::core::Sinc2dInterpolator : public isce3::core::Interpolator<U> {
     /** Interpolate at a given coordinate. */
     U interp_impl(double x, double y, const Map& z) const override;
 
+    /** Interpolate at a batch of coordinates. */
+    void interp_batch_impl(const double* x, const double* y, size_t n,
+                           const Map& z, U* out) const override;
+
 public:
     /** Default constructor. */
     Sinc2dInterpolator(int sincLen, int sincSub);
@@ -174,6 +243,9 @@ public:
     // Inherit overloads for other datatypes
     using super_t::interpolate;
 
+    /** Normalized kernel, one row of sincLen taps per fractional phase */
+    const Matrix<double>& kernel() const { return _kernel; }
+
 private:
     // Compute sinc coefficients
     void _sinc_coef(double beta, double relfiltlen, int decfactor,
@@ -6,10 +6,75 @@
 
 #include "LUT2d.h"
 
+#include <algorithm>
 #include <complex>
+#include <memory>
 
 #include "Interpolator.h"
 
+namespace {
+
+// Evaluate the bicubic polynomial c[4*p + q] v^p u^q of a cell
+template<typename T>
+inline T evalPatch(const T* c, double v, double u)
+{
+    const T tu(u), tv(v);
+    T row[4];
+    for (int p = 0; p < 4; ++p) {
+        row[p] = ((c[4*p+3] * tu + c[4*p+2]) * tu + c[4*p+1]) * tu + c[4*p];
+    }
+    return ((row[3] * tv + row[2]) * tv + row[1]) * tv + row[0];
+}
+
+// Evaluate the derivative with respect to u of the polynomial of a cell
+template<typename T>
+inline T evalPatchDu(const T* c, double v, double u)
+{
+    const T tu(u), tv(v);
+    T row[4];
+    for (int p = 0; p < 4; ++p) {
+        row[p] = (T(3.0) * c[4*p+3] * tu + T(2.0) * c[4*p+2]) * tu + c[4*p+1];
+    }
+    return ((row[3] * tv + row[2]) * tv + row[1]) * tv + row[0];
+}
+
+// Collapse the polynomial of a cell to a cubic in u at a given v
+template<typename T>
+inline void collapsePatch(const T* c, double v, T* r)
+{
+    const T tv(v);
+    for (int q = 0; q < 4; ++q) {
+        r[q] = ((c[12+q] * tv + c[8+q]) * tv + c[4+q]) * tv + c[q];
+    }
+}
+
+// Form the polynomial C = A P B^T of a cell from a 4x4 matrix P
+template<typename T>
+inline void transformPatch(const double (&A)[4][4], const T (&P)[4][4],
+                           const double (&B)[4][4], T* c)
+{
+    T AP[4][4];
+    for (int p = 0; p < 4; ++p) {
+        for (int b = 0; b < 4; ++b) {
+            AP[p][b] = T(0.0);
+            for (int a = 0; a < 4; ++a) {
+                AP[p][b] += T(A[p][a]) * P[a][b];
+            }
+        }
+    }
+    for (int p = 0; p < 4; ++p) {
+        for (int q = 0; q < 4; ++q) {
+            T sum(0.0);
+            for (int b = 0; b < 4; ++b) {
+                sum += AP[p][b] * T(B[q][b]);
+            }
+            c[4*p + q] = sum;
+        }
+    }
+}
+
+} // namespace
+
 // Constructor with coordinate starting values and spacing
 /** @param[in] xstart Starting X-coordinate
   * @param[in] ystart Starting Y-coordinate
@@ -23,6 +88,7 @@ LUT2d(double xstart, double ystart, double dx, double dy, const isce3::core::Mat
           _haveData(true), _boundsError(boundsError), _refValue(data(0,0)),
           _xstart(xstart), _ystart(ystart), _dx(dx), _dy(dy), _data(data) {
     _setInterpolator(method);
+    _setPatches();
 }
 
 // Constructor with valarrays of X and Y coordinates
@@ -36,10 +102,10 @@ LUT2d(const std::valarray<double> & xcoord, const std::valarray<double> & ycoord
       const isce3::core::Matrix<T> & data, isce3::core::dataInterpMethod method,
       bool boundsError) :
           _haveData(true), _boundsError(boundsError), _refValue(data(0,0)) {
-    // Set the data
-    setFromData(xcoord, ycoord, data);
     // Save interpolation data 
     _setInterpolator(method);
+    // Set the data
+    setFromData(xcoord, ycoord, data);
 }
 
 // Set from external data
@@ -97,6 +163,7 @@ setFromData(const std::valarray<double> & xcoord, const std::valarray<double> &
     _data = data;
     _haveData = true;
     _refValue = data(0,0);
+    _setPatches();
 } 
 
 // Evaluate LUT at coordinate
@@ -117,9 +184,154 @@ eval(double y, double x) const {
     }
 
     // Get matrix indices corresponding to requested coordinates
-    double x_idx = (x - _xstart) / _dx;
-    double y_idx = (y - _ystart) / _dy;
+    double x_idx, y_idx;
+    _index(y, x, y_idx, x_idx);
+
+    // Evaluate polynomial of cell if available
+    if (_patches) {
+        double v, u;
+        const T * c = _patch(_cells(), y_idx, x_idx, v, u);
+        return evalPatch(c, v, u);
+    }
+
+    // Call interpolator
+    value = _interp->interpolate(x_idx, y_idx, _data);
+    return value;
+}
+
+// Evaluate LUT at a batch of coordinates
+/** @param[in] y Y-coordinates for evaluation
+  * @param[in] x X-coordinates for evaluation
+  * @param[in] n Number of coordinates
+  * @param[out] out Interpolated values */
+template <typename T>
+void isce3::core::LUT2d<T>::
+eval(const double* y, const double* x, size_t n, T* out) const {
+
+    // Check if data are available; if not, return ref value
+    if (!_haveData) {
+        std::fill(out, out + n, _refValue);
+        return;
+    }
+
+    // Evaluate polynomials of cells if available
+    if (_patches) {
+        const T * cells = _cells();
+        for (size_t i = 0; i < n; ++i) {
+            double x_idx, y_idx, v, u;
+            _index(y[i], x[i], y_idx, x_idx);
+            const T * c = _patch(cells, y_idx, x_idx, v, u);
+            out[i] = evalPatch(c, v, u);
+        }
+        return;
+    }
+
+    // Convert coordinates to matrix indices in chunks small enough to stay
+    // in cache, and interpolate each chunk in a single call
+    constexpr size_t chunk = 256;
+    double x_idx[chunk], y_idx[chunk];
+    for (size_t start = 0; start < n; start += chunk) {
+        const size_t count = std::min(chunk, n - start);
+        for (size_t i = 0; i < count; ++i) {
+            _index(y[start + i], x[start + i], y_idx[i], x_idx[i]);
+        }
+        _interp->interpolate(x_idx, y_idx, count, _data, out + start);
+    }
+}
+
+// Evaluate LUT along a line of constant Y-coordinate
+/** @param[in] y Y-coordinate for evaluation
+  * @param[in] x X-coordinates for evaluation
+  * @param[in] n Number of coordinates
+  * @param[out] out Interpolated values */
+template <typename T>
+void isce3::core::LUT2d<T>::
+eval(double y, const double* x, size_t n, T* out) const {
+
+    // Check if data are available; if not, return ref value
+    if (!_haveData) {
+        std::fill(out, out + n, _refValue);
+        return;
+    }
+
+    // Without polynomials of cells, evaluate in chunks with the same
+    // Y-coordinate
+    if (!_patches) {
+        constexpr size_t chunk = 256;
+        double ys[chunk];
+        std::fill(ys, ys + chunk, y);
+        for (size_t start = 0; start < n; start += chunk) {
+            const size_t count = std::min(chunk, n - start);
+            eval(ys, x + start, count, out + start);
+        }
+        return;
+    }
+
+    // Collapse the polynomial of each cell along the line to a cubic in X,
+    // which is reused for all coordinates falling in the same cell
+    const size_t width = _data.width();
+    const T * cells = _cells();
+    size_t j_prev = width;
+    T r[4];
+    for (size_t k = 0; k < n; ++k) {
+        double x_idx, y_idx, v, u;
+        _index(y, x[k], y_idx, x_idx);
+        const T * c = _patch(cells, y_idx, x_idx, v, u);
+        const size_t j = static_cast<size_t>(x_idx);
+        if (j != j_prev) {
+            collapsePatch(c, v, r);
+            j_prev = j;
+        }
+        const T tu(u);
+        out[k] = ((r[3] * tu + r[2]) * tu + r[1]) * tu + r[0];
+    }
+}
 
+// Evaluate derivative of LUT with respect to X-coordinate
+/** @param[in] y Y-coordinate for evaluation
+  * @param[in] x X-coordinate for evaluation
+  * @param[out] value Derivative of interpolated value */
+template <typename T>
+T isce3::core::LUT2d<T>::
+eval_dx(double y, double x) const {
+
+    // Without data, the LUT is constant
+    if (!_haveData) {
+        return T(0.0);
+    }
+
+    double x_idx, y_idx;
+    _index(y, x, y_idx, x_idx);
+
+    // Indices are clamped, so the LUT is constant in X outside of its domain
+    const double x_raw = (x - _xstart) / _dx;
+    if (x_raw < 0.0 || x_raw > _data.width() - 1.0) {
+        return T(0.0);
+    }
+
+    // Differentiate polynomial of cell if available
+    if (_patches) {
+        double v, u;
+        const T * c = _patch(_cells(), y_idx, x_idx, v, u);
+        return evalPatchDu(c, v, u) / T(_dx);
+    }
+
+    // Otherwise use a central difference of the interpolant
+    const double h = 1.0e-3;
+    const double x0 = std::max(x_idx - h, 0.0);
+    const double x1 = std::min(x_idx + h, _data.width() - 1.0);
+    if (x1 <= x0) {
+        return T(0.0);
+    }
+    const T z0 = _interp->interpolate(x0, y_idx, _data);
+    const T z1 = _interp->interpolate(x1, y_idx, _data);
+    return (z1 - z0) / T((x1 - x0) * _dx);
+}
+
+template <typename T>
+void isce3::core::LUT2d<T>::
+_index(double y, double x, double & y_idx, double & x_idx) const
+{
     // Check bounds or clamp indices to valid values
     if (_boundsError && not contains(y, x)) {
         pyre::journal::error_t errorChannel("isce.core.LUT2d");
@@ -130,12 +342,156 @@ eval(double y, double x) const {
             << _xstart << " " << _xstart + _dx*_data.width()
             << pyre::journal::endl;
     }
-    x_idx = isce3::core::clamp(x_idx, 0.0, _data.width() - 1.0);
-    y_idx = isce3::core::clamp(y_idx, 0.0, _data.length() - 1.0);
+    x_idx = isce3::core::clamp((x - _xstart) / _dx, 0.0, _data.width() - 1.0);
+    y_idx = isce3::core::clamp((y - _ystart) / _dy, 0.0, _data.length() - 1.0);
+}
 
-    // Call interpolator
-    value = _interp->interpolate(x_idx, y_idx, _data);
-    return value;
+template <typename T>
+const T * isce3::core::LUT2d<T>::
+_patch(const T * cells, double y_idx, double x_idx, double & v,
+       double & u) const
+{
+    // indices are clamped, so they are non-negative
+    const size_t i = static_cast<size_t>(y_idx);
+    const size_t j = static_cast<size_t>(x_idx);
+    v = y_idx - i;
+    u = x_idx - j;
+    return cells + 16 * (i * _data.width() + j);
+}
+
+template <typename T>
+const T * isce3::core::LUT2d<T>::
+_cells() const
+{
+    // copies of the LUT may evaluate it concurrently
+    std::call_once(_patches->built,
+                   [this]() { _buildPatches(_patches->cells); });
+    return _patches->cells.data();
+}
+
+template <typename T>
+void isce3::core::LUT2d<T>::
+_setPatches()
+{
+    _patches.reset();
+
+    const size_t length = _data.length();
+    const size_t width = _data.width();
+    const auto method = _interp->method();
+    if (!_haveData || length < 2 || width < 2 ||
+        length * width > maxPatchCells ||
+        (method != isce3::core::BILINEAR_METHOD &&
+         method != isce3::core::BICUBIC_METHOD &&
+         method != isce3::core::BIQUINTIC_METHOD)) {
+        return;
+    }
+
+    _patches = std::make_shared<Patches>();
+}
+
+template <typename T>
+void isce3::core::LUT2d<T>::
+_buildPatches(std::vector<T> & patches) const
+{
+    const size_t length = _data.length();
+    const size_t width = _data.width();
+    const auto method = _interp->method();
+
+    // One cell per data point; the cells of the last row and column are only
+    // evaluated on their first row and column, at the edge of the LUT
+    patches.resize(16 * length * width);
+    T * const cells = patches.data();
+
+    // Clamped data access
+    auto z = [&](long i, long j) {
+        i = std::min(std::max(i, 0L), static_cast<long>(length) - 1);
+        j = std::min(std::max(j, 0L), static_cast<long>(width) - 1);
+        return _data(i, j);
+    };
+
+    if (method == isce3::core::BILINEAR_METHOD) {
+        for (size_t i = 0; i < length; ++i) {
+            for (size_t j = 0; j < width; ++j) {
+                const T z00 = z(i, j), z01 = z(i, j + 1);
+                const T z10 = z(i + 1, j), z11 = z(i + 1, j + 1);
+                T * c = cells + 16 * (i * width + j);
+                std::fill(c, c + 16, T(0.0));
+                c[0] = z00;
+                c[1] = z01 - z00;
+                c[4] = z10 - z00;
+                c[5] = z11 - z10 - z01 + z00;
+            }
+        }
+
+    } else if (method == isce3::core::BICUBIC_METHOD) {
+        // Catmull-Rom spline basis (see BicubicInterpolator), applied to the
+        // 4x4 neighborhood of each cell with edge values replicated
+        constexpr double M[4][4] = {{ 0.0,  1.0,  0.0,  0.0},
+                                    {-0.5,  0.0,  0.5,  0.0},
+                                    { 1.0, -2.5,  2.0, -0.5},
+                                    {-0.5,  1.5, -1.5,  0.5}};
+        for (size_t i = 0; i < length; ++i) {
+            for (size_t j = 0; j < width; ++j) {
+                T P[4][4];
+                for (int a = 0; a < 4; ++a) {
+                    for (int b = 0; b < 4; ++b) {
+                        P[a][b] = z(long(i) + a - 1, long(j) + b - 1);
+                    }
+                }
+                transformPatch(M, P, M, cells + 16 * (i * width + j));
+            }
+        }
+
+    } else {
+        // The spline windows of the biquintic interpolator (of even order)
+        // are fixed within each cell, where it is a bicubic polynomial. Fit
+        // it from samples at a 4x4 grid of nodes inside the cell.
+        constexpr double s[4] = {0.125, 0.375, 0.625, 0.875};
+
+        // Inverse Vandermonde matrix of the nodes, from the expansion of the
+        // Lagrange basis polynomials
+        double W[4][4];
+        for (int a = 0; a < 4; ++a) {
+            double poly[4] = {1.0, 0.0, 0.0, 0.0};
+            double denom = 1.0;
+            int deg = 0;
+            for (int b = 0; b < 4; ++b) {
+                if (b == a) { continue; }
+                // multiply by (t - s[b])
+                for (int k = deg + 1; k > 0; --k) {
+                    poly[k] = poly[k-1] - s[b] * poly[k];
+                }
+                poly[0] = -s[b] * poly[0];
+                ++deg;
+                denom *= s[a] - s[b];
+            }
+            for (int p = 0; p < 4; ++p) {
+                W[p][a] = poly[p] / denom;
+            }
+        }
+
+        double xs[16], ys[16];
+        T values[16];
+        for (size_t i = 0; i < length; ++i) {
+            for (size_t j = 0; j < width; ++j) {
+                for (int a = 0; a < 4; ++a) {
+                    for (int b = 0; b < 4; ++b) {
+                        ys[4*a + b] = i + s[a];
+                        xs[4*a + b] = j + s[b];
+                    }
+                }
+                _interp->interpolate(xs, ys, 16, _data, values);
+
+                T V[4][4];
+                for (int a = 0; a < 4; ++a) {
+                    for (int b = 0; b < 4; ++b) {
+                        V[a][b] = values[4*a + b];
+                    }
+                }
+                transformPatch(W, V, W, cells + 16 * (i * width + j));
+            }
+        }
+    }
 }
 
 template <typename T>
@@ -170,6 +526,7 @@ template<typename T>
 void isce3::core::LUT2d<T>::interpMethod(dataInterpMethod method)
 {
     _setInterpolator(method);
+    _setPatches();
 }
 
 // Forward declaration of classes
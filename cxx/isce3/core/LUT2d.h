@@ -7,7 +7,10 @@
 
 #include "forward.h"
 
+#include <memory>
+#include <mutex>
 #include <valarray>
+#include <vector>
 #include "Constants.h"
 #include "Matrix.h"
 #include "Utilities.h"
@@ -75,6 +78,15 @@ class isce3::core::LUT2d {
         // Evaluate LUT    
         T eval(double y, double x) const;
 
+        // Evaluate LUT at a batch of n coordinates
+        void eval(const double* y, const double* x, size_t n, T* out) const;
+
+        // Evaluate LUT at n coordinates along a line of constant Y
+        void eval(double y, const double* x, size_t n, T* out) const;
+
+        // Evaluate derivative of LUT with respect to X
+        T eval_dx(double y, double x) const;
+
         /** Check if point resides in domain of LUT */
         inline bool contains(double y, double x) const
         {
@@ -93,6 +105,16 @@ class isce3::core::LUT2d {
         isce3::core::Matrix<T> _data;
         // Interpolation method
         isce3::core::Interpolator<T> * _interp;
+        // Coefficients of the interpolant on each cell of the grid, computed
+        // on first evaluation
+        struct Patches {
+            std::once_flag built;
+            std::vector<T> cells;
+        };
+        // Null if the interpolant is evaluated with the interpolator. The
+        // coefficients are never modified once computed, so copies of the
+        // LUT share them.
+        std::shared_ptr<Patches> _patches;
 
     private:
         /** @internal
@@ -101,6 +123,42 @@ class isce3::core::LUT2d {
          */
         void _setInterpolator(dataInterpMethod method);
 
+        /** @internal
+         * Set up the coefficients of the interpolant on each cell
+         *
+         * Within each cell of the grid, the bilinear, bicubic and biquintic
+         * (order 6 spline) interpolants are bicubic polynomials. Caching their
+         * 16 coefficients per cell makes evaluation (and differentiation)
+         * independent of the interpolation method. Only done for LUTs of up
+         * to maxPatchCells cells, and deferred to the first evaluation.
+         */
+        void _setPatches();
+
+        /** @internal
+         * Compute the coefficients of the interpolant on each cell
+         */
+        void _buildPatches(std::vector<T> & cells) const;
+
+        /** @internal
+         * Coefficients of all cells, computed on first use
+         */
+        const T * _cells() const;
+
+        /** @internal
+         * Check bounds of coordinates and convert them to clamped indices
+         */
+        void _index(double y, double x, double & y_idx, double & x_idx) const;
+
+        /** @internal
+         * Coefficients of the cell containing clamped indices and the
+         * coordinates relative to the cell
+         */
+        const T * _patch(const T * cells, double y_idx, double x_idx,
+                         double & v, double & u) const;
+
+        // Maximum number of cells for which coefficients are precomputed
+        static constexpr size_t maxPatchCells = 1 << 16;
+
     // BVR: I'm placing the comparison operator implementations inline here because
     // it wasn't clear to me how to handle the template arguments out-of-line
     public:
@@ -181,7 +239,8 @@ LUT2d(const isce3::core::LUT2d<T> & lut) : _haveData(lut.haveData()),
                                           _refValue(lut.refValue()),
                                           _xstart(lut.xStart()), _ystart(lut.yStart()),
                                           _dx(lut.xSpacing()), _dy(lut.ySpacing()),
-                                          _data(lut.data()) {
+                                          _data(lut.data()),
+                                          _patches(lut._patches) {
     _setInterpolator(lut.interpMethod());
 }
 
@@ -199,5 +258,6 @@ operator=(const LUT2d<T> & lut) {
     _haveData = lut.haveData();
     _boundsError = lut.boundsError();
     _setInterpolator(lut.interpMethod());
+    _patches = lut._patches;
     return *this;
 }
@@ -22,6 +22,20 @@ U isce3::core::NearestNeighborInterpolator<U>::interp_impl(double x, double y,
     return z(row, col);
 }
 
+/** @param[in] x X-coordinates to interpolate
+  * @param[in] y Y-coordinates to interpolate
+  * @param[in] n Number of points
+  * @param[in] z 2D matrix to interpolate
+  * @param[out] out Interpolated values */
+template<class U>
+void isce3::core::NearestNeighborInterpolator<U>::interp_batch_impl(
+        const double* x, const double* y, size_t n, const Map& z, U* out) const
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = NearestNeighborInterpolator<U>::interp_impl(x[i], y[i], z);
+    }
+}
+
 // Forward declaration of classes
 template class isce3::core::NearestNeighborInterpolator<double>;
 template class isce3::core::NearestNeighborInterpolator<float>;
@@ -67,6 +67,20 @@ U isce3::core::Sinc2dInterpolator<U>::interp_impl(double x, double y,
     return interpVal;
 }
 
+/** @param[in] x X-coordinates to interpolate
+  * @param[in] y Y-coordinates to interpolate
+  * @param[in] n Number of points
+  * @param[in] z 2D matrix to interpolate
+  * @param[out] out Interpolated values */
+template<class U>
+void isce3::core::Sinc2dInterpolator<U>::interp_batch_impl(
+        const double* x, const double* y, size_t n, const Map& z, U* out) const
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = Sinc2dInterpolator<U>::interp_impl(x[i], y[i], z);
+    }
+}
+
 template<class U>
 U isce3::core::Sinc2dInterpolator<U>::_sinc_eval_2d(const Map& arrin, int intpx,
                                                    int intpy, double frpx,
@@ -80,13 +94,21 @@ U isce3::core::Sinc2dInterpolator<U>::_sinc_eval_2d(const Map& arrin, int intpx,
     int ifracx = std::min(std::max(0, int(frpx*_kernelLength)), _kernelLength-1);
     int ifracy = std::min(std::max(0, int(frpy*_kernelLength)), _kernelLength-1);
 
-    // Compute weighted sum from kernel
+    // Kernel rows for the fractional offsets
+    const double* kx = &_kernel(ifracx, 0);
+    const double* ky = &_kernel(ifracy, 0);
+
+    // Compute weighted sum from kernel, filtering each row along x before
+    // filtering the results along y
     for (int i = 0; i < _kernelWidth; i++) {
+        // the row runs backwards from intpx, so walk it from its first sample
+        const U* row = arrin.data() + (intpy - i) * arrin.outerStride() +
+                       (intpx - _kernelWidth + 1);
+        U rowSum(0.0);
         for (int j = 0; j < _kernelWidth; j++) {
-            ret += arrin(intpy-i,intpx-j) * 
-                   static_cast<U>(_kernel(ifracy,i)) * 
-                   static_cast<U>(_kernel(ifracx,j));
+            rowSum += row[j] * static_cast<U>(kx[_kernelWidth - 1 - j]);
         }
+        ret += rowSum * static_cast<U>(ky[i]);
     }
 
     // Done
@@ -14,11 +14,11 @@ isce3::core::Spline2dInterpolator<U>::Spline2dInterpolator(size_t order)
 {
 
     // Check validity of order
-    if ((order < 3) || (order > 20)) {
+    if ((order < 3) || (order > maxOrder)) {
         pyre::journal::error_t errorChannel("isce.core.Spline2dInterpolator");
         errorChannel
             << pyre::journal::at(__HERE__)
-            << "Spline order must be between 3 and 20 "
+            << "Spline order must be between 3 and " << maxOrder << " "
             << "(received " + std::to_string(order) + ")"
             << pyre::journal::newline
             << pyre::journal::endl;
@@ -33,13 +33,54 @@ template<class U>
 U isce3::core::Spline2dInterpolator<U>::interp_impl(double x, double y,
                                                    const Map& z) const
 {
+    // Get coordinates of start of spline window
+    int i0, j0;
+    _window(x, y, i0, j0);
 
-    // Get array size
-    const int nx = z.cols();
-    const int ny = z.rows();
+    U A[maxOrder], R[maxOrder], Q[maxOrder], HC[maxOrder];
+    for (int i = 0; i < _order; ++i) {
+        _loadRow(z, i0 + i, j0, A);
+        _initSpline(A, _order, R, Q);
+        HC[i] = _spline(x - j0, A, _order, R);
+    }
 
+    _initSpline(HC, _order, R, Q);
+    return static_cast<U>(_spline(y - i0, HC, _order, R));
+}
+
+/** @param[in] x X-coordinates to interpolate
+  * @param[in] y Y-coordinates to interpolate
+  * @param[in] n Number of points
+  * @param[in] z 2D matrix to interpolate
+  * @param[out] out Interpolated values */
+template<class U>
+void isce3::core::Spline2dInterpolator<U>::interp_batch_impl(
+        const double* x, const double* y, size_t n, const Map& z, U* out) const
+{
+    // Window data and spline coefficients of each of its rows
+    U A[maxOrder * maxOrder], R[maxOrder * maxOrder];
+
+    // Only reload the window when it changes
+    int i0_prev = 0, j0_prev = 0;
+    bool loaded = false;
+    for (size_t k = 0; k < n; ++k) {
+        int i0, j0;
+        _window(x[k], y[k], i0, j0);
+        if (!loaded || i0 != i0_prev || j0 != j0_prev) {
+            _loadWindow(z, i0, j0, A, R);
+            i0_prev = i0;
+            j0_prev = j0;
+            loaded = true;
+        }
+        out[k] = _evalWindow(x[k], y[k], i0, j0, A, R);
+    }
+}
+
+template<typename U>
+void isce3::core::Spline2dInterpolator<U>::_window(double x, double y,
+                                                  int& i0, int& j0) const
+{
     // Get coordinates of start of spline window
-    int i0, j0;
     if ((_order % 2) != 0) {
         i0 = y - 0.5;
         j0 = x - 0.5;
@@ -49,27 +90,52 @@ U isce3::core::Spline2dInterpolator<U>::interp_impl(double x, double y,
     }
     i0 = i0 - (_order / 2) + 1;
     j0 = j0 - (_order / 2) + 1;
+}
+
+template<typename U>
+void isce3::core::Spline2dInterpolator<U>::_loadRow(const Map& z, int i, int j0,
+                                                   U* A) const
+{
+    // Get array size
+    const int nx = z.cols();
+    const int ny = z.rows();
+
+    const int indi = std::min(std::max(i, 0), ny - 2);
+    for (int j = 0; j < _order; ++j) {
+        const int indj = std::min(std::max(j0 + j, 0), nx - 2);
+        A[j] = z(indi+1,indj+1);
+    }
+}
 
-    std::valarray<U> A(_order), R(_order), Q(_order), HC(_order);
-    
+template<typename U>
+void isce3::core::Spline2dInterpolator<U>::_loadWindow(const Map& z, int i0,
+                                                      int j0, U* A,
+                                                      U* R) const
+{
+    U Q[maxOrder];
     for (int i = 0; i < _order; ++i) {
-        const int indi = std::min(std::max(i0 + i, 0), ny - 2);
-        for (int j = 0; j < _order; ++j) {
-            const int indj = std::min(std::max(j0 + j, 0), nx - 2);
-            A[j] = z(indi+1,indj+1);
-        }
-        _initSpline(A, _order, R, Q);
-        HC[i] = _spline(x - j0, A, _order, R);
+        _loadRow(z, i0 + i, j0, A + i * _order);
+        _initSpline(A + i * _order, _order, R + i * _order, Q);
     }
+}
 
-    _initSpline(HC, _order, R, Q);
-    return static_cast<U>(_spline(y - i0, HC, _order, R));
+template<typename U>
+U isce3::core::Spline2dInterpolator<U>::_evalWindow(double x, double y,
+                                                   int i0, int j0, const U* A,
+                                                   const U* R) const
+{
+    U HC[maxOrder], RC[maxOrder], Q[maxOrder];
+    for (int i = 0; i < _order; ++i) {
+        HC[i] = _spline(x - j0, A + i * _order, _order, R + i * _order);
+    }
+
+    _initSpline(HC, _order, RC, Q);
+    return static_cast<U>(_spline(y - i0, HC, _order, RC));
 }
 
 template<typename U>
-U isce3::core::Spline2dInterpolator<U>::_spline(double x,
-                                               const std::valarray<U>& Y, int n,
-                                               const std::valarray<U>& R) const
+U isce3::core::Spline2dInterpolator<U>::_spline(double x, const U* Y, int n,
+                                               const U* R) const
 {
 
     const U denom = static_cast<U>(6.0);
@@ -87,10 +153,8 @@ U isce3::core::Spline2dInterpolator<U>::_spline(double x,
 }
 
 template<typename U>
-void isce3::core::Spline2dInterpolator<U>::_initSpline(const std::valarray<U>& Y,
-                                                      int n,
-                                                      std::valarray<U>& R,
-                                                      std::valarray<U>& Q) const
+void isce3::core::Spline2dInterpolator<U>::_initSpline(const U* Y, int n, U* R,
+                                                      U* Q) const
 {
     Q[0] = U(0.0);
     R[0] = U(0.0);
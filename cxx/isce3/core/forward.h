@@ -6,8 +6,10 @@ namespace isce3 {
         class Attitude;
         class Baseline;
         class Basis;
+        class BlockPipeline;
         class DateTime;
         class Ellipsoid;
+        class EphemerisTable;
         class EulerAngles;
         class Metadata;
         class Orbit;
@@ -0,0 +1,27 @@
+#include "PlanCache.h"
+
+#include "detail/FFTWWrapper.h"
+
+namespace isce3 { namespace fft {
+
+std::size_t planCacheSize()
+{
+    return detail::planCacheSize();
+}
+
+void clearPlanCache()
+{
+    detail::clearPlanCache();
+}
+
+bool importWisdom(const std::string & filename)
+{
+    return detail::importWisdom(filename.c_str());
+}
+
+bool exportWisdom(const std::string & filename)
+{
+    return detail::exportWisdom(filename.c_str());
+}
+
+}}
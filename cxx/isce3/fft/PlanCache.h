@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace isce3 { namespace fft {
+
+/**
+ * Number of plans held by the process-wide FFT plan cache.
+ *
+ * Every FwdFFTPlan / InvFFTPlan (including the temporary plans created by
+ * fft1d(), fft2d() and their inverses) is taken from a thread-safe cache keyed
+ * on transform type, shape, embedding, strides, batch size, direction, planner
+ * flags, thread count and the FFTW alignment of the input/output arrays. A
+ * plan is therefore only created (and, with FFTW_MEASURE or FFTW_PATIENT,
+ * measured) once per process for each distinct layout.
+ */
+std::size_t planCacheSize();
+
+/**
+ * Release the plans held by the plan cache.
+ *
+ * Existing plan objects remain valid.
+ */
+void clearPlanCache();
+
+/**
+ * Import FFTW wisdom.
+ *
+ * Double precision wisdom is read from \p filename and single precision
+ * wisdom from \p filename + "f" (like the FFTW system wisdom files
+ * /etc/fftw/wisdom and /etc/fftw/wisdomf).
+ *
+ * If the environment variable ISCE3_FFTW_WISDOM is set, wisdom is imported
+ * from the file it names before the first plan is created and exported to it
+ * at exit, so that planning is paid once per node.
+ *
+ * \param[in] filename Wisdom file
+ * \returns True if both files were read successfully
+ */
+bool importWisdom(const std::string & filename);
+
+/**
+ * Export the accumulated FFTW wisdom.
+ *
+ * See importWisdom() for the file naming. Files are replaced atomically.
+ *
+ * \param[in] filename Wisdom file
+ * \returns True if both files were written successfully
+ */
+bool exportWisdom(const std::string & filename);
+
+}}
@@ -106,6 +106,13 @@ protected:
                 int threads);
 
     std::shared_ptr<fftw_plan_t> _plan;
+
+    // Arrays the plan is executed on. Plans come from a process-wide cache
+    // and may be shared with other objects with the same layout, so they
+    // are always executed with the new-array execute functions.
+    void * _in = nullptr;
+    void * _out = nullptr;
+    void (*_execute)(const fftw_plan_t, void *, void *) = nullptr;
 };
 
 template<int N>
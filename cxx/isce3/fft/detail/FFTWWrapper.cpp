@@ -1,9 +1,23 @@
 #include "FFTWWrapper.h"
 
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
 #include <isce3/except/Error.h>
 
 namespace isce3 { namespace fft { namespace detail {
 
+std::mutex & plannerMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
 static
 void setNumThreadsf(int threads)
 {
@@ -152,6 +166,270 @@ initPlan(int rank, const int * n, int howmany,
             flags);
 }
 
+namespace {
+
+// Environment variable naming the wisdom file imported before the first plan
+// is created and exported at exit
+const char * wisdomEnvironmentVariable = "ISCE3_FFTW_WISDOM";
+
+// Plan layout, direction, flags, threads and array alignment
+using PlanKey = std::vector<long>;
+
+enum PlanKind { C2C, R2C, C2R };
+
+// Guarded by plannerMutex()
+template<typename P>
+struct PlanCache {
+    std::map<PlanKey, std::shared_ptr<P>> plans;
+};
+
+template<typename P>
+PlanCache<P> & planCache()
+{
+    static PlanCache<P> cache;
+    return cache;
+}
+
+int alignmentOf(const void * p, float)
+{
+    return fftwf_alignment_of(reinterpret_cast<float *>(const_cast<void *>(p)));
+}
+
+int alignmentOf(const void * p, double)
+{
+    return fftw_alignment_of(reinterpret_cast<double *>(const_cast<void *>(p)));
+}
+
+void exportWisdomFromEnvironment()
+{
+    const char * filename = std::getenv(wisdomEnvironmentVariable);
+    if (filename) {
+        exportWisdom(filename);
+    }
+}
+
+void importWisdomFromEnvironment()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []() {
+        const char * filename = std::getenv(wisdomEnvironmentVariable);
+        if (filename) {
+            importWisdom(filename);
+            std::atexit(exportWisdomFromEnvironment);
+        }
+    });
+}
+
+template<typename T, typename P, typename Planner>
+std::shared_ptr<P>
+cachedPlan(PlanKind kind, int rank, const int * n, int howmany,
+           const void * in, const int * inembed, int istride, int idist,
+           const void * out, const int * onembed, int ostride, int odist,
+           int sign, unsigned flags, int threads, Planner && planner)
+{
+    importWisdomFromEnvironment();
+
+    PlanKey key = {kind, rank, howmany, istride, idist, ostride, odist, sign,
+                   long(flags), threads, alignmentOf(in, T()),
+                   alignmentOf(out, T()), in == out};
+    for (int i = 0; i < rank; ++i) {
+        key.push_back(n[i]);
+        key.push_back(inembed ? inembed[i] : n[i]);
+        key.push_back(onembed ? onembed[i] : n[i]);
+    }
+
+    auto & cache = planCache<P>();
+    std::lock_guard<std::mutex> lock(plannerMutex());
+
+    auto it = cache.plans.find(key);
+    if (it != cache.plans.end()) {
+        return it->second;
+    }
+
+    P plan = planner();
+    if (!plan) {
+        return std::make_shared<P>();
+    }
+
+    // the last holder may release the plan at any time (e.g. after the
+    // cache is cleared), so destroy it under the planner lock
+    auto ptr = std::shared_ptr<P>(new P(plan), [](P * p) noexcept {
+        {
+            std::lock_guard<std::mutex> lock(plannerMutex());
+            destroyPlan(*p);
+        }
+        delete p;
+    });
+    cache.plans.emplace(key, ptr);
+    return ptr;
+}
+
+template<typename P>
+std::size_t cacheSize()
+{
+    auto & cache = planCache<P>();
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    return cache.plans.size();
+}
+
+template<typename P>
+void clearCache()
+{
+    // release the plans after unlocking, since the last reference of a plan
+    // destroys it under the planner lock
+    std::map<PlanKey, std::shared_ptr<P>> plans;
+    {
+        std::lock_guard<std::mutex> lock(plannerMutex());
+        plans.swap(planCache<P>().plans);
+    }
+}
+
+} // namespace
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<float> * in,
+        const int * inembed, int istride, int idist,
+        std::complex<float> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return cachedPlan<float, fftwf_plan>(C2C, rank, n, howmany,
+            in, inembed, istride, idist, out, onembed, ostride, odist,
+            sign, flags, threads, [&]() {
+                return initPlan(rank, n, howmany, in, inembed, istride, idist,
+                                out, onembed, ostride, odist, sign, flags, threads);
+            });
+}
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<double> * in,
+        const int * inembed, int istride, int idist,
+        std::complex<double> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return cachedPlan<double, fftw_plan>(C2C, rank, n, howmany,
+            in, inembed, istride, idist, out, onembed, ostride, odist,
+            sign, flags, threads, [&]() {
+                return initPlan(rank, n, howmany, in, inembed, istride, idist,
+                                out, onembed, ostride, odist, sign, flags, threads);
+            });
+}
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        float * in,
+        const int * inembed, int istride, int idist,
+        std::complex<float> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return cachedPlan<float, fftwf_plan>(R2C, rank, n, howmany,
+            in, inembed, istride, idist, out, onembed, ostride, odist,
+            sign, flags, threads, [&]() {
+                return initPlan(rank, n, howmany, in, inembed, istride, idist,
+                                out, onembed, ostride, odist, sign, flags, threads);
+            });
+}
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        double * in,
+        const int * inembed, int istride, int idist,
+        std::complex<double> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return cachedPlan<double, fftw_plan>(R2C, rank, n, howmany,
+            in, inembed, istride, idist, out, onembed, ostride, odist,
+            sign, flags, threads, [&]() {
+                return initPlan(rank, n, howmany, in, inembed, istride, idist,
+                                out, onembed, ostride, odist, sign, flags, threads);
+            });
+}
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<float> * in,
+        const int * inembed, int istride, int idist,
+        float * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return cachedPlan<float, fftwf_plan>(C2R, rank, n, howmany,
+            in, inembed, istride, idist, out, onembed, ostride, odist,
+            sign, flags, threads, [&]() {
+                return initPlan(rank, n, howmany, in, inembed, istride, idist,
+                                out, onembed, ostride, odist, sign, flags, threads);
+            });
+}
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<double> * in,
+        const int * inembed, int istride, int idist,
+        double * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads)
+{
+    return cachedPlan<double, fftw_plan>(C2R, rank, n, howmany,
+            in, inembed, istride, idist, out, onembed, ostride, odist,
+            sign, flags, threads, [&]() {
+                return initPlan(rank, n, howmany, in, inembed, istride, idist,
+                                out, onembed, ostride, odist, sign, flags, threads);
+            });
+}
+
+std::size_t planCacheSize()
+{
+    return cacheSize<fftwf_plan>() + cacheSize<fftw_plan>();
+}
+
+void clearPlanCache()
+{
+    clearCache<fftwf_plan>();
+    clearCache<fftw_plan>();
+}
+
+// Double precision wisdom is stored in filename and single precision wisdom
+// in filename + "f" (like the FFTW system wisdom /etc/fftw/wisdom[f])
+bool importWisdom(const char * filename)
+{
+    const std::string fname(filename);
+    const std::string fnamef = fname + "f";
+
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    int status = 1;
+    status &= fftw_import_wisdom_from_filename(fname.c_str());
+    status &= fftwf_import_wisdom_from_filename(fnamef.c_str());
+    return status != 0;
+}
+
+bool exportWisdom(const char * filename)
+{
+    // write to temporary files first so that concurrent processes sharing the
+    // same wisdom file never read a partial file
+    const std::string fname(filename);
+    const std::string fnamef = fname + "f";
+    const std::string suffix = ".tmp" + std::to_string(getpid());
+
+    int status = 1;
+    {
+        std::lock_guard<std::mutex> lock(plannerMutex());
+        status &= fftw_export_wisdom_to_filename((fname + suffix).c_str());
+        status &= fftwf_export_wisdom_to_filename((fnamef + suffix).c_str());
+    }
+    if (status) {
+        status &= (std::rename((fname + suffix).c_str(), fname.c_str()) == 0);
+        status &= (std::rename((fnamef + suffix).c_str(), fnamef.c_str()) == 0);
+    }
+    std::remove((fname + suffix).c_str());
+    std::remove((fnamef + suffix).c_str());
+    return status != 0;
+}
+
 void executePlan(const fftwf_plan plan)
 {
     return fftwf_execute(plan);
@@ -162,6 +440,38 @@ void executePlan(const fftw_plan plan)
     return fftw_execute(plan);
 }
 
+void executePlan(const fftwf_plan plan, std::complex<float> * in, std::complex<float> * out)
+{
+    fftwf_execute_dft(plan, reinterpret_cast<fftwf_complex *>(in),
+                      reinterpret_cast<fftwf_complex *>(out));
+}
+
+void executePlan(const fftw_plan plan, std::complex<double> * in, std::complex<double> * out)
+{
+    fftw_execute_dft(plan, reinterpret_cast<fftw_complex *>(in),
+                     reinterpret_cast<fftw_complex *>(out));
+}
+
+void executePlan(const fftwf_plan plan, float * in, std::complex<float> * out)
+{
+    fftwf_execute_dft_r2c(plan, in, reinterpret_cast<fftwf_complex *>(out));
+}
+
+void executePlan(const fftw_plan plan, double * in, std::complex<double> * out)
+{
+    fftw_execute_dft_r2c(plan, in, reinterpret_cast<fftw_complex *>(out));
+}
+
+void executePlan(const fftwf_plan plan, std::complex<float> * in, float * out)
+{
+    fftwf_execute_dft_c2r(plan, reinterpret_cast<fftwf_complex *>(in), out);
+}
+
+void executePlan(const fftw_plan plan, std::complex<double> * in, double * out)
+{
+    fftw_execute_dft_c2r(plan, reinterpret_cast<fftw_complex *>(in), out);
+}
+
 void destroyPlan(fftwf_plan plan)
 {
     if (plan) {
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <complex>
+#include <cstddef>
 #include <fftw3.h>
+#include <memory>
+#include <mutex>
 
 namespace isce3 { namespace fft { namespace detail {
 
@@ -9,6 +12,12 @@ template<typename T> struct FFTWPlanType {};
 template<>           struct FFTWPlanType<float>  { using plan_t = fftwf_plan; };
 template<>           struct FFTWPlanType<double> { using plan_t = fftw_plan; };
 
+// Process-wide lock of the FFTW planner. Creating and destroying plans,
+// setting the planner threads and importing or exporting wisdom are not
+// thread safe in FFTW, so every call site (including the initPlan functions
+// below and isce3::signal::Signal) must hold it.
+std::mutex & plannerMutex();
+
 fftwf_plan
 initPlan(int rank, const int * n, int howmany,
          std::complex<float> * in,
@@ -57,9 +66,78 @@ initPlan(int rank, const int * n, int howmany,
          const int * onembed, int ostride, int odist,
          int sign, unsigned flags, int threads);
 
+// Plans from the process-wide plan cache. Plans are keyed by type, layout,
+// direction, flags, thread count and alignment of the arrays, so that a plan
+// may be executed on any arrays with the same layout and alignment using
+// the new-array execute functions below.
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<float> * in,
+        const int * inembed, int istride, int idist,
+        std::complex<float> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<double> * in,
+        const int * inembed, int istride, int idist,
+        std::complex<double> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        float * in,
+        const int * inembed, int istride, int idist,
+        std::complex<float> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        double * in,
+        const int * inembed, int istride, int idist,
+        std::complex<double> * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::shared_ptr<fftwf_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<float> * in,
+        const int * inembed, int istride, int idist,
+        float * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::shared_ptr<fftw_plan>
+getPlan(int rank, const int * n, int howmany,
+        std::complex<double> * in,
+        const int * inembed, int istride, int idist,
+        double * out,
+        const int * onembed, int ostride, int odist,
+        int sign, unsigned flags, int threads);
+
+std::size_t planCacheSize();
+
+void clearPlanCache();
+
+bool importWisdom(const char * filename);
+
+bool exportWisdom(const char * filename);
+
 void executePlan(const fftwf_plan);
 void executePlan(const fftw_plan);
 
+void executePlan(const fftwf_plan, std::complex<float> * in, std::complex<float> * out);
+void executePlan(const fftw_plan, std::complex<double> * in, std::complex<double> * out);
+void executePlan(const fftwf_plan, float * in, std::complex<float> * out);
+void executePlan(const fftw_plan, double * in, std::complex<double> * out);
+void executePlan(const fftwf_plan, std::complex<float> * in, float * out);
+void executePlan(const fftw_plan, std::complex<double> * in, double * out);
+
+// Must be called with plannerMutex() held
 void destroyPlan(fftwf_plan);
 void destroyPlan(fftw_plan);
 
@@ -4,6 +4,7 @@
 #include <isce3/container/RadarGeometry.h>
 #include <isce3/core/Constants.h>
 #include <isce3/core/Ellipsoid.h>
+#include <isce3/core/EphemerisTable.h>
 #include <isce3/core/Interp1d.h>
 #include <isce3/core/Kernels.h>
 #include <isce3/core/Projections.h>
@@ -97,13 +98,19 @@ void backproject(std::complex<float>* out,
     Linspace<double> out_azimuth_time = out_geometry.sensingTime();
     Linspace<double> out_slant_range = out_geometry.slantRange();
 
+    // precompute interpolating polynomials of the input orbit, which is
+    // interpolated at each pulse and again for each target
+    const EphemerisTable in_ephemeris(in_geometry.orbit());
+
     // interpolate platform position & velocity at each pulse
-    std::vector<Vec3> pos(in_azimuth_time.size());
-    std::vector<Vec3> vel(in_azimuth_time.size());
+    std::vector<double> pulse_time(in_azimuth_time.size());
     for (int i = 0; i < in_azimuth_time.size(); ++i) {
-        double t = in_azimuth_time[i];
-        in_geometry.orbit().interpolate(&pos[i], &vel[i], t);
+        pulse_time[i] = in_azimuth_time[i];
     }
+    std::vector<Vec3> pos(in_azimuth_time.size());
+    std::vector<Vec3> vel(in_azimuth_time.size());
+    in_ephemeris.interpolate(pulse_time.data(), pulse_time.size(), pos.data(),
+                             vel.data());
 
     // range sampling window
     double swst = 2. * in_slant_range.first() / c;
@@ -153,7 +160,7 @@ void backproject(std::complex<float>* out,
             t = in_geometry.radarGrid().sensingMid();
             {
                 auto converged =
-                        geo2rdr(llh, ellipsoid, in_geometry.orbit(),
+                        geo2rdr(llh, ellipsoid, in_ephemeris,
                                 in_geometry.doppler(), t, r, wvl,
                                 in_geometry.lookSide(), g2r_params.threshold,
                                 g2r_params.maxiter, g2r_params.delta_range);
@@ -170,7 +177,7 @@ void backproject(std::complex<float>* out,
 
             // get platform position and velocity at center of CPI
             Vec3 p, v;
-            in_geometry.orbit().interpolate(&p, &v, t);
+            in_ephemeris.interpolate(&p, &v, t);
 
             // estimate synthetic aperture length required to achieve the
             // desired azimuth resolution
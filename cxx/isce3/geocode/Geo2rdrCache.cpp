@@ -0,0 +1,410 @@
+#include "Geo2rdrCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <isce3/core/Ellipsoid.h>
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/LookSide.h>
+#include <isce3/core/Orbit.h>
+#include <isce3/core/Projections.h>
+#include <isce3/except/Error.h>
+#include <isce3/geocode/loadDem.h>
+#include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/geometry.h>
+#include <isce3/io/Raster.h>
+
+namespace {
+
+// File layout: the header, followed by the azimuth times and then the slant
+// ranges of all pixels in row major order
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t key;
+    double startX;
+    double startY;
+    double spacingX;
+    double spacingY;
+    int32_t width;
+    int32_t length;
+    int32_t epsg;
+    int32_t padding;
+    double pixelOffset;
+    uint64_t geometryKey;
+};
+
+constexpr char magic[8] = {'I', 'S', 'C', 'E', 'G', '2', 'R', 'C'};
+constexpr uint32_t version = 2;
+
+// 64-bit FNV-1a hash
+class Hash {
+public:
+    void add(const void* data, size_t size)
+    {
+        auto bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            _value ^= bytes[i];
+            _value *= 1099511628211ull;
+        }
+    }
+
+    template<typename T>
+    void add(const T& value)
+    {
+        add(&value, sizeof(T));
+    }
+
+    uint64_t value() const { return _value; }
+
+private:
+    uint64_t _value = 14695981039346656037ull;
+};
+
+// Hash the radar geometry: orbit, Doppler, ellipsoid, wavelength and look side
+void hashGeometry(Hash& hash, const isce3::core::Orbit& orbit,
+                  const isce3::core::LUT2d<double>& doppler,
+                  const isce3::core::Ellipsoid& ellipsoid, double wavelength,
+                  isce3::core::LookSide side)
+{
+    const std::string epoch = orbit.referenceEpoch().isoformat();
+    hash.add(epoch.data(), epoch.size());
+    hash.add(static_cast<int>(orbit.interpMethod()));
+    for (int i = 0; i < orbit.size(); ++i) {
+        hash.add(orbit.time(i));
+        for (int k = 0; k < 3; ++k) {
+            hash.add(orbit.position(i)[k]);
+            hash.add(orbit.velocity(i)[k]);
+        }
+    }
+
+    hash.add(doppler.haveData());
+    hash.add(doppler.refValue());
+    hash.add(doppler.boundsError());
+    if (doppler.haveData()) {
+        hash.add(doppler.xStart());
+        hash.add(doppler.yStart());
+        hash.add(doppler.xSpacing());
+        hash.add(doppler.ySpacing());
+        hash.add(doppler.length());
+        hash.add(doppler.width());
+        hash.add(doppler.data().data(),
+                 doppler.length() * doppler.width() * sizeof(double));
+    }
+
+    hash.add(ellipsoid.a());
+    hash.add(ellipsoid.e2());
+    hash.add(wavelength);
+    hash.add(static_cast<int>(side));
+}
+
+// Hash the inputs of the geo2rdr solves other than the radar geometry (given
+// by its key) and the DEM
+void hashInputs(Hash& hash, const isce3::product::GeoGridParameters& geoGrid,
+                double pixelOffset, uint64_t geometryKey,
+                double thresholdGeo2rdr, int numiterGeo2rdr)
+{
+    hash.add(geometryKey);
+    hash.add(geoGrid.startX());
+    hash.add(geoGrid.startY());
+    hash.add(geoGrid.spacingX());
+    hash.add(geoGrid.spacingY());
+    hash.add(geoGrid.width());
+    hash.add(geoGrid.length());
+    hash.add(geoGrid.epsg());
+    hash.add(pixelOffset);
+    hash.add(thresholdGeo2rdr);
+    hash.add(numiterGeo2rdr);
+}
+
+// Longitude, latitude and DEM height of the pixels of a block of lines
+void demPoints(isce3::io::Raster& demRaster,
+               const isce3::product::GeoGridParameters& geoGrid,
+               isce3::core::ProjectionBase* proj, int lineStart,
+               int blockLength, double demBlockMargin, double pixelOffset,
+               std::vector<isce3::core::Vec3>& llh)
+{
+    const int width = geoGrid.width();
+    isce3::geometry::DEMInterpolator demInterp = isce3::geocode::loadDEM(
+            demRaster, geoGrid, lineStart, blockLength, width,
+            demBlockMargin);
+
+    llh.resize(static_cast<size_t>(blockLength) * width);
+
+    // interpolate the DEM in chunks of pixels along each line
+    constexpr int chunk = 256;
+    const int nChunks = (width + chunk - 1) / chunk;
+
+#pragma omp parallel for
+    for (int kk = 0; kk < blockLength * nChunks; ++kk) {
+        const int blockLine = kk / nChunks;
+        const int pixelStart = (kk % nChunks) * chunk;
+        const int count = std::min(chunk, width - pixelStart);
+        const double y =
+                geoGrid.startY() +
+                geoGrid.spacingY() * (lineStart + blockLine + pixelOffset);
+
+        double lon[chunk], lat[chunk], hgt[chunk];
+        isce3::core::Vec3* points =
+                &llh[static_cast<size_t>(blockLine) * width + pixelStart];
+        for (int i = 0; i < count; ++i) {
+            const isce3::core::Vec3 xyz {
+                    geoGrid.startX() +
+                            geoGrid.spacingX() * (pixelStart + i + pixelOffset),
+                    y, 0.0};
+            points[i] = proj->inverse(xyz);
+            lon[i] = points[i][0];
+            lat[i] = points[i][1];
+        }
+        demInterp.interpolateLonLat(lon, lat, count, hgt);
+        for (int i = 0; i < count; ++i) {
+            points[i][2] = hgt[i];
+        }
+    }
+}
+
+} // namespace
+
+isce3::geocode::Geo2rdrCache::Geo2rdrCache(
+        const isce3::product::GeoGridParameters& geoGrid,
+        isce3::io::Raster& demRaster, const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler,
+        const isce3::core::Ellipsoid& ellipsoid, double wavelength,
+        isce3::core::LookSide side, double thresholdGeo2rdr,
+        int numiterGeo2rdr, size_t linesPerBlock, double demBlockMargin,
+        double pixelOffset)
+    : _geoGrid(geoGrid), _pixelOffset(pixelOffset),
+      _geometryKey(geometryKey(orbit, doppler, ellipsoid, wavelength, side))
+{
+    const size_t width = geoGrid.width();
+    const size_t size = width * geoGrid.length();
+
+    std::shared_ptr<double> data(new double[2 * size],
+                                 std::default_delete<double[]>());
+    double* azimuthTime = data.get();
+    double* slantRange = data.get() + size;
+
+    std::unique_ptr<isce3::core::ProjectionBase> proj(
+            isce3::core::createProj(geoGrid.epsg()));
+
+    Hash hash;
+    hashInputs(hash, geoGrid, pixelOffset, _geometryKey, thresholdGeo2rdr,
+               numiterGeo2rdr);
+
+    const size_t nBlocks = (geoGrid.length() + linesPerBlock - 1) / linesPerBlock;
+    std::vector<isce3::core::Vec3> llh;
+    for (size_t block = 0; block < nBlocks; ++block) {
+        const size_t lineStart = block * linesPerBlock;
+        const size_t blockLength = std::min(
+                linesPerBlock, static_cast<size_t>(geoGrid.length()) - lineStart);
+
+        demPoints(demRaster, geoGrid, proj.get(), lineStart, blockLength,
+                  demBlockMargin, pixelOffset, llh);
+        for (const auto& point : llh) {
+            hash.add(point[2]);
+        }
+
+        double* blockAzimuthTime = azimuthTime + lineStart * width;
+        double* blockSlantRange = slantRange + lineStart * width;
+
+#pragma omp parallel for
+        for (size_t kk = 0; kk < llh.size(); ++kk) {
+            double aztime = 0.5 * (orbit.startTime() + orbit.endTime());
+            double srange;
+            int geostat = isce3::geometry::geo2rdr(
+                    llh[kk], ellipsoid, orbit, doppler, aztime, srange,
+                    wavelength, side, thresholdGeo2rdr, numiterGeo2rdr,
+                    1.0e-8);
+            if (geostat == 0) {
+                aztime = std::numeric_limits<double>::quiet_NaN();
+                srange = std::numeric_limits<double>::quiet_NaN();
+            }
+            blockAzimuthTime[kk] = aztime;
+            blockSlantRange[kk] = srange;
+        }
+    }
+
+    _key = hash.value();
+    _data = data;
+    _azimuthTime = azimuthTime;
+    _slantRange = slantRange;
+}
+
+uint64_t isce3::geocode::Geo2rdrCache::key(
+        const isce3::product::GeoGridParameters& geoGrid,
+        isce3::io::Raster& demRaster, const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler,
+        const isce3::core::Ellipsoid& ellipsoid, double wavelength,
+        isce3::core::LookSide side, double thresholdGeo2rdr,
+        int numiterGeo2rdr, size_t linesPerBlock, double demBlockMargin,
+        double pixelOffset)
+{
+    std::unique_ptr<isce3::core::ProjectionBase> proj(
+            isce3::core::createProj(geoGrid.epsg()));
+
+    Hash hash;
+    hashInputs(hash, geoGrid, pixelOffset,
+               geometryKey(orbit, doppler, ellipsoid, wavelength, side),
+               thresholdGeo2rdr, numiterGeo2rdr);
+
+    const size_t nBlocks = (geoGrid.length() + linesPerBlock - 1) / linesPerBlock;
+    std::vector<isce3::core::Vec3> llh;
+    for (size_t block = 0; block < nBlocks; ++block) {
+        const size_t lineStart = block * linesPerBlock;
+        const size_t blockLength = std::min(
+                linesPerBlock, static_cast<size_t>(geoGrid.length()) - lineStart);
+
+        demPoints(demRaster, geoGrid, proj.get(), lineStart, blockLength,
+                  demBlockMargin, pixelOffset, llh);
+        for (const auto& point : llh) {
+            hash.add(point[2]);
+        }
+    }
+    return hash.value();
+}
+
+uint64_t isce3::geocode::Geo2rdrCache::geometryKey(
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler,
+        const isce3::core::Ellipsoid& ellipsoid, double wavelength,
+        isce3::core::LookSide side)
+{
+    Hash hash;
+    hashGeometry(hash, orbit, doppler, ellipsoid, wavelength, side);
+    return hash.value();
+}
+
+isce3::geocode::Geo2rdrCache
+isce3::geocode::Geo2rdrCache::load(const std::string& filename)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::string errmsg = "unable to open geo2rdr cache " + filename;
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), errmsg);
+    }
+
+    Header header;
+    struct stat status;
+    if (::fstat(fd, &status) != 0 ||
+        static_cast<size_t>(status.st_size) < sizeof(Header) ||
+        ::pread(fd, &header, sizeof(Header), 0) != sizeof(Header) ||
+        std::memcmp(header.magic, magic, sizeof(magic)) != 0 ||
+        header.version != version) {
+        ::close(fd);
+        std::string errmsg = filename + " is not a geo2rdr cache";
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+
+    const size_t size = static_cast<size_t>(header.width) * header.length;
+    const size_t nbytes = sizeof(Header) + 2 * size * sizeof(double);
+    if (static_cast<size_t>(status.st_size) != nbytes) {
+        ::close(fd);
+        std::string errmsg = "geo2rdr cache " + filename + " is truncated";
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+
+    void* map = ::mmap(nullptr, nbytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        std::string errmsg = "unable to map geo2rdr cache " + filename;
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), errmsg);
+    }
+
+    // the header is a multiple of 8 bytes long, so the data are aligned
+    std::shared_ptr<const char> mapping(
+            static_cast<const char*>(map),
+            [nbytes](const char* p) { ::munmap(const_cast<char*>(p), nbytes); });
+
+    Geo2rdrCache cache;
+    cache._geoGrid.startX(header.startX);
+    cache._geoGrid.startY(header.startY);
+    cache._geoGrid.spacingX(header.spacingX);
+    cache._geoGrid.spacingY(header.spacingY);
+    cache._geoGrid.width(header.width);
+    cache._geoGrid.length(header.length);
+    cache._geoGrid.epsg(header.epsg);
+    cache._pixelOffset = header.pixelOffset;
+    cache._key = header.key;
+    cache._geometryKey = header.geometryKey;
+    cache._data = std::shared_ptr<const double>(
+            mapping,
+            reinterpret_cast<const double*>(mapping.get() + sizeof(Header)));
+    cache._azimuthTime = cache._data.get();
+    cache._slantRange = cache._data.get() + size;
+    return cache;
+}
+
+void isce3::geocode::Geo2rdrCache::save(const std::string& filename) const
+{
+    Header header {};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.key = _key;
+    header.startX = _geoGrid.startX();
+    header.startY = _geoGrid.startY();
+    header.spacingX = _geoGrid.spacingX();
+    header.spacingY = _geoGrid.spacingY();
+    header.width = _geoGrid.width();
+    header.length = _geoGrid.length();
+    header.epsg = _geoGrid.epsg();
+    header.pixelOffset = _pixelOffset;
+    header.geometryKey = _geometryKey;
+
+    const size_t size = static_cast<size_t>(_geoGrid.width()) * _geoGrid.length();
+
+    std::ofstream out(filename, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    out.write(reinterpret_cast<const char*>(_azimuthTime), size * sizeof(double));
+    out.write(reinterpret_cast<const char*>(_slantRange), size * sizeof(double));
+    if (!out) {
+        std::string errmsg = "unable to write geo2rdr cache " + filename;
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), errmsg);
+    }
+}
+
+void isce3::geocode::Geo2rdrCache::checkGeoGrid(
+        const isce3::product::GeoGridParameters& geoGrid,
+        double pixelOffset) const
+{
+    if (geoGrid.startX() != _geoGrid.startX() ||
+        geoGrid.startY() != _geoGrid.startY() ||
+        geoGrid.spacingX() != _geoGrid.spacingX() ||
+        geoGrid.spacingY() != _geoGrid.spacingY() ||
+        geoGrid.width() != _geoGrid.width() ||
+        geoGrid.length() != _geoGrid.length() ||
+        geoGrid.epsg() != _geoGrid.epsg()) {
+        std::string errmsg = "geo2rdr cache does not cover the geocoded grid";
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+    if (pixelOffset != _pixelOffset) {
+        std::string errmsg = "geo2rdr cache is sampled at pixel offset " +
+                             std::to_string(_pixelOffset) + " instead of " +
+                             std::to_string(pixelOffset);
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+}
+
+void isce3::geocode::Geo2rdrCache::checkGeometry(
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& doppler,
+        const isce3::core::Ellipsoid& ellipsoid, double wavelength,
+        isce3::core::LookSide side) const
+{
+    if (geometryKey(orbit, doppler, ellipsoid, wavelength, side) !=
+        _geometryKey) {
+        std::string errmsg = "geo2rdr cache was computed for a different "
+                             "orbit, Doppler, ellipsoid, wavelength or look "
+                             "side";
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), errmsg);
+    }
+}
@@ -0,0 +1,162 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <isce3/core/forward.h>
+#include <isce3/io/forward.h>
+#include <isce3/product/GeoGridParameters.h>
+
+namespace isce3 { namespace geocode {
+
+/**
+ * Radar coordinates of the pixels of a geocoded grid
+ *
+ * Holds the azimuth time and slant range found by geo2rdr for the DEM height
+ * of every pixel of a geocoded grid, where pixel (line, pixel) is located at
+ * (startX + spacingX * (pixel + pixelOffset),
+ *  startY + spacingY * (line + pixelOffset)). The pixel offset is 0 for
+ * consumers that sample the grid at the start of each pixel (geocodeSlc) and
+ * 0.5 for those that sample it at pixel centers (Geocode, Covariance), and a
+ * consumer only accepts a cache sampled like itself. Rasters acquired
+ * with the same orbit, Doppler and wavelength (e.g. the polarizations of a
+ * GSLC, or the dates of a coregistered stack) can then be geocoded onto the
+ * same grid without repeating the geo2rdr solves. Pixels for which geo2rdr did not converge are NaN.
+ *
+ * A cache may be saved to a file and loaded back as a read-only memory map.
+ * It carries a key hashing all the inputs of the geo2rdr solves, including
+ * the DEM height of every pixel, so that a saved cache can be matched to a
+ * new run with Geo2rdrCache::key. It also carries a geometry key hashing only
+ * the orbit, Doppler, ellipsoid, wavelength and look side, which consumers
+ * check against their own inputs with checkGeometry without reading the DEM.
+ */
+class Geo2rdrCache {
+public:
+    /** Empty cache */
+    Geo2rdrCache() = default;
+
+    /**
+     * Run geo2rdr for every pixel of a geocoded grid
+     * \param[in] geoGrid           geo grid parameters
+     * \param[in] demRaster         raster of the DEM
+     * \param[in] orbit             orbit
+     * \param[in] doppler           2D LUT Doppler of the image grid
+     * \param[in] ellipsoid         ellipsoid object
+     * \param[in] wavelength        radar wavelength
+     * \param[in] side              look side
+     * \param[in] thresholdGeo2rdr  threshold for geo2rdr computations
+     * \param[in] numiterGeo2rdr    maximum number of iterations for Geo2rdr
+     *                              convergence
+     * \param[in] linesPerBlock     number of lines in each block
+     * \param[in] demBlockMargin    margin of a DEM block in degrees
+     * \param[in] pixelOffset       offset of the sampled location within a
+     *                              pixel, in pixels (0.5 for pixel centers)
+     */
+    Geo2rdrCache(const isce3::product::GeoGridParameters& geoGrid,
+                 isce3::io::Raster& demRaster,
+                 const isce3::core::Orbit& orbit,
+                 const isce3::core::LUT2d<double>& doppler,
+                 const isce3::core::Ellipsoid& ellipsoid, double wavelength,
+                 isce3::core::LookSide side, double thresholdGeo2rdr = 1.0e-8,
+                 int numiterGeo2rdr = 50, size_t linesPerBlock = 1000,
+                 double demBlockMargin = 0.1, double pixelOffset = 0.0);
+
+    /**
+     * Key of the cache computed from a set of inputs
+     *
+     * Only interpolates the DEM, so it is much cheaper than computing the
+     * cache itself. The arguments are the same as for the constructor.
+     */
+    static uint64_t key(const isce3::product::GeoGridParameters& geoGrid,
+                        isce3::io::Raster& demRaster,
+                        const isce3::core::Orbit& orbit,
+                        const isce3::core::LUT2d<double>& doppler,
+                        const isce3::core::Ellipsoid& ellipsoid,
+                        double wavelength, isce3::core::LookSide side,
+                        double thresholdGeo2rdr = 1.0e-8,
+                        int numiterGeo2rdr = 50, size_t linesPerBlock = 1000,
+                        double demBlockMargin = 0.1, double pixelOffset = 0.0);
+
+    /**
+     * Geometry key computed from the inputs other than the DEM and grid
+     *
+     * \param[in] orbit             orbit
+     * \param[in] doppler           2D LUT Doppler of the image grid
+     * \param[in] ellipsoid         ellipsoid object
+     * \param[in] wavelength        radar wavelength
+     * \param[in] side              look side
+     */
+    static uint64_t geometryKey(const isce3::core::Orbit& orbit,
+                                const isce3::core::LUT2d<double>& doppler,
+                                const isce3::core::Ellipsoid& ellipsoid,
+                                double wavelength, isce3::core::LookSide side);
+
+    /** Load a cache written by save() */
+    static Geo2rdrCache load(const std::string& filename);
+
+    /** Write the cache to a file */
+    void save(const std::string& filename) const;
+
+    /** Key of the inputs the cache was computed from */
+    uint64_t key() const { return _key; }
+
+    /** Geometry key of the inputs the cache was computed from */
+    uint64_t geometryKey() const { return _geometryKey; }
+
+    /** Offset of the sampled location within a pixel, in pixels */
+    double pixelOffset() const { return _pixelOffset; }
+
+    /** Geocoded grid */
+    const isce3::product::GeoGridParameters& geoGrid() const
+    {
+        return _geoGrid;
+    }
+
+    /** Azimuth time of a pixel (NaN if geo2rdr did not converge) */
+    double azimuthTime(size_t line, size_t pixel) const
+    {
+        return _azimuthTime[line * _geoGrid.width() + pixel];
+    }
+
+    /** Slant range of a pixel (NaN if geo2rdr did not converge) */
+    double slantRange(size_t line, size_t pixel) const
+    {
+        return _slantRange[line * _geoGrid.width() + pixel];
+    }
+
+    /**
+     * Check that the cache covers a geocoded grid sampled at a given offset
+     * within each pixel
+     *
+     * Throws isce3::except::InvalidArgument if the grids or offsets differ.
+     */
+    void checkGeoGrid(const isce3::product::GeoGridParameters& geoGrid,
+                      double pixelOffset = 0.0) const;
+
+    /**
+     * Check that the cache was computed for a radar geometry
+     *
+     * Throws isce3::except::InvalidArgument if the geometry keys differ, e.g.
+     * for a cache computed with the orbit or Doppler of another acquisition,
+     * or the wavelength of another frequency band.
+     */
+    void checkGeometry(const isce3::core::Orbit& orbit,
+                       const isce3::core::LUT2d<double>& doppler,
+                       const isce3::core::Ellipsoid& ellipsoid,
+                       double wavelength, isce3::core::LookSide side) const;
+
+private:
+    isce3::product::GeoGridParameters _geoGrid;
+    double _pixelOffset = 0.0;
+    uint64_t _key = 0;
+    uint64_t _geometryKey = 0;
+
+    // Owns the azimuth times and slant ranges, whether they are held in
+    // memory or mapped from a file
+    std::shared_ptr<const double> _data;
+    const double* _azimuthTime = nullptr;
+    const double* _slantRange = nullptr;
+};
+
+}} // namespace isce3::geocode
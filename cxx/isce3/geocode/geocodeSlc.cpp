@@ -1,12 +1,16 @@
 #include "geocodeSlc.h"
 
+#include <functional>
+#include <limits>
 #include <memory>
+#include <valarray>
 
 #include <isce3/core/Constants.h>
 #include <isce3/core/Ellipsoid.h>
 #include <isce3/core/LUT2d.h>
 #include <isce3/core/Orbit.h>
 #include <isce3/core/Projections.h>
+#include <isce3/geocode/Geo2rdrCache.h>
 #include <isce3/geocode/baseband.h>
 #include <isce3/geocode/interpolate.h>
 #include <isce3/geocode/loadDem.h>
@@ -17,25 +21,26 @@
 #include <isce3/product/Product.h>
 #include <isce3/product/RadarGridParameters.h>
 
-void isce3::geocode::geocodeSlc(
-        isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
-        isce3::io::Raster& demRaster,
-        const isce3::product::RadarGridParameters& radarGrid,
-        const isce3::product::GeoGridParameters& geoGrid,
-        const isce3::core::Orbit& orbit,
-        const isce3::core::LUT2d<double>& nativeDoppler,
-        const isce3::core::LUT2d<double>& imageGridDoppler,
-        const isce3::core::Ellipsoid& ellipsoid, const double& thresholdGeo2rdr,
-        const int& numiterGeo2rdr, const size_t& linesPerBlock,
-        const double& demBlockMargin, const bool flatten)
+namespace {
+
+// Fills the azimuth time and slant range of the pixels of a block of lines of
+// the geocoded grid (NaN where geo2rdr fails)
+using RadarCoordinates = std::function<void(
+        size_t lineStart, size_t blockLength, std::valarray<double>& aztime,
+        std::valarray<double>& srange)>;
+
+void geocodeSlcBlocks(isce3::io::Raster& outputRaster,
+                      isce3::io::Raster& inputRaster,
+                      const isce3::product::RadarGridParameters& radarGrid,
+                      const isce3::product::GeoGridParameters& geoGrid,
+                      const isce3::core::LUT2d<double>& nativeDoppler,
+                      const size_t& linesPerBlock, const bool flatten,
+                      const RadarCoordinates& radarCoordinates)
 {
 
     // number of bands in the input raster
     size_t nbands = inputRaster.numBands();
     std::cout << "nbands: " << nbands << std::endl;
-    // create projection based on _epsg code
-    std::unique_ptr<isce3::core::ProjectionBase> proj(
-            isce3::core::createProj(geoGrid.epsg()));
 
     // Interpolator pointer
     auto interp = std::make_unique<
@@ -67,11 +72,10 @@ void isce3::geocode::geocodeSlc(
         int rangeFirstPixel = radarGrid.width() - 1;
         int rangeLastPixel = 0;
 
-        // get a DEM interpolator for a block of DEM for the current geocoded
-        // grid
-        isce3::geometry::DEMInterpolator demInterp = isce3::geocode::loadDEM(
-                demRaster, geoGrid, lineStart, geoBlockLength, geoGrid.width(),
-                demBlockMargin);
+        // azimuth time and slant range of the geocoded pixels
+        std::valarray<double> azimuthTime(blockSize);
+        std::valarray<double> slantRange(blockSize);
+        radarCoordinates(lineStart, geoBlockLength, azimuthTime, slantRange);
 
         // X and Y indices (in the radar coordinates) for the
         // geocoded pixels (after geo2rdr computation)
@@ -99,37 +103,13 @@ void isce3::geocode::geocodeSlc(
             size_t blockLine = kk / geoGridWidth;
             size_t pixel = kk % geoGridWidth;
 
-            // Global line index
-            const size_t line = lineStart + blockLine;
-
-            // y coordinate in the out put grid
-            double y = geoGrid.startY() + geoGrid.spacingY() * line;
-
-            // x in the output geocoded Grid
-            double x = geoGrid.startX() + geoGrid.spacingX() * pixel;
-
-            // compute the azimuth time and slant range for the
+            // azimuth time and slant range for the
             // x,y coordinates in the output grid
-            double aztime, srange;
-            aztime = radarGrid.sensingMid();
-
-            // coordinate in the output projection system
-            const isce3::core::Vec3 xyz {x, y, 0.0};
-
-            // transform the xyz in the output projection system to llh
-            isce3::core::Vec3 llh = proj->inverse(xyz);
-
-            // interpolate the height from the DEM for this pixel
-            llh[2] = demInterp.interpolateLonLat(llh[0], llh[1]);
-
-            // Perform geo->rdr iterations
-            int geostat = isce3::geometry::geo2rdr(
-                    llh, ellipsoid, orbit, imageGridDoppler, aztime, srange,
-                    radarGrid.wavelength(), radarGrid.lookSide(),
-                    thresholdGeo2rdr, numiterGeo2rdr, 1.0e-8);
+            const double aztime = azimuthTime[kk];
+            const double srange = slantRange[kk];
 
             // Check convergence
-            if (geostat == 0) {
+            if (std::isnan(aztime) || std::isnan(srange)) {
                 continue;
             }
 
@@ -238,3 +218,114 @@ void isce3::geocode::geocodeSlc(
         // set output block of data
     } // end loop over block of output grid
 }
+
+} // namespace
+
+void isce3::geocode::geocodeSlc(
+        isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
+        isce3::io::Raster& demRaster,
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::product::GeoGridParameters& geoGrid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& nativeDoppler,
+        const isce3::core::LUT2d<double>& imageGridDoppler,
+        const isce3::core::Ellipsoid& ellipsoid, const double& thresholdGeo2rdr,
+        const int& numiterGeo2rdr, const size_t& linesPerBlock,
+        const double& demBlockMargin, const bool flatten)
+{
+    // create projection based on _epsg code
+    std::unique_ptr<isce3::core::ProjectionBase> proj(
+            isce3::core::createProj(geoGrid.epsg()));
+
+    auto radarCoordinates = [&](size_t lineStart, size_t geoBlockLength,
+                                std::valarray<double>& azimuthTime,
+                                std::valarray<double>& slantRange) {
+        // get a DEM interpolator for a block of DEM for the current geocoded
+        // grid
+        isce3::geometry::DEMInterpolator demInterp = isce3::geocode::loadDEM(
+                demRaster, geoGrid, lineStart, geoBlockLength, geoGrid.width(),
+                demBlockMargin);
+
+        size_t geoGridWidth = geoGrid.width();
+#pragma omp parallel for
+        for (size_t kk = 0; kk < geoBlockLength * geoGridWidth; ++kk) {
+
+            size_t blockLine = kk / geoGridWidth;
+            size_t pixel = kk % geoGridWidth;
+
+            // Global line index
+            const size_t line = lineStart + blockLine;
+
+            // y coordinate in the out put grid
+            double y = geoGrid.startY() + geoGrid.spacingY() * line;
+
+            // x in the output geocoded Grid
+            double x = geoGrid.startX() + geoGrid.spacingX() * pixel;
+
+            // compute the azimuth time and slant range for the
+            // x,y coordinates in the output grid
+            double aztime, srange;
+            aztime = radarGrid.sensingMid();
+
+            // coordinate in the output projection system
+            const isce3::core::Vec3 xyz {x, y, 0.0};
+
+            // transform the xyz in the output projection system to llh
+            isce3::core::Vec3 llh = proj->inverse(xyz);
+
+            // interpolate the height from the DEM for this pixel
+            llh[2] = demInterp.interpolateLonLat(llh[0], llh[1]);
+
+            // Perform geo->rdr iterations
+            int geostat = isce3::geometry::geo2rdr(
+                    llh, ellipsoid, orbit, imageGridDoppler, aztime, srange,
+                    radarGrid.wavelength(), radarGrid.lookSide(),
+                    thresholdGeo2rdr, numiterGeo2rdr, 1.0e-8);
+
+            // Check convergence
+            if (geostat == 0) {
+                aztime = std::numeric_limits<double>::quiet_NaN();
+                srange = std::numeric_limits<double>::quiet_NaN();
+            }
+
+            azimuthTime[kk] = aztime;
+            slantRange[kk] = srange;
+        }
+    };
+
+    geocodeSlcBlocks(outputRaster, inputRaster, radarGrid, geoGrid,
+                     nativeDoppler, linesPerBlock, flatten, radarCoordinates);
+}
+
+void isce3::geocode::geocodeSlc(
+        isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
+        const isce3::geocode::Geo2rdrCache& geo2rdrCache,
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& nativeDoppler,
+        const isce3::core::LUT2d<double>& imageGridDoppler,
+        const isce3::core::Ellipsoid& ellipsoid, const size_t& linesPerBlock,
+        const bool flatten)
+{
+    const isce3::product::GeoGridParameters& geoGrid = geo2rdrCache.geoGrid();
+
+    // make sure the cache was computed like the DEM overload would
+    geo2rdrCache.checkGeoGrid(geoGrid, 0.0);
+    geo2rdrCache.checkGeometry(orbit, imageGridDoppler, ellipsoid,
+                               radarGrid.wavelength(), radarGrid.lookSide());
+
+    auto radarCoordinates = [&](size_t lineStart, size_t geoBlockLength,
+                                std::valarray<double>& azimuthTime,
+                                std::valarray<double>& slantRange) {
+        size_t geoGridWidth = geoGrid.width();
+        for (size_t kk = 0; kk < geoBlockLength * geoGridWidth; ++kk) {
+            const size_t line = lineStart + kk / geoGridWidth;
+            const size_t pixel = kk % geoGridWidth;
+            azimuthTime[kk] = geo2rdrCache.azimuthTime(line, pixel);
+            slantRange[kk] = geo2rdrCache.slantRange(line, pixel);
+        }
+    };
+
+    geocodeSlcBlocks(outputRaster, inputRaster, radarGrid, geoGrid,
+                     nativeDoppler, linesPerBlock, flatten, radarCoordinates);
+}
@@ -6,6 +6,8 @@
 
 namespace isce3 { namespace geocode {
 
+class Geo2rdrCache;
+
 /**
  * Geocode SLC
  * \param[out] outputRaster  output raster for the geocoded SLC
@@ -35,4 +37,32 @@ void geocodeSlc(isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
                 const size_t& linesPerBlock, const double& demBlockMargin,
                 const bool flatten = true);
 
+/**
+ * Geocode SLC using precomputed radar coordinates
+ *
+ * The SLC is geocoded onto the grid of the cache, skipping the DEM and
+ * geo2rdr computations. The cache must have been computed with the orbit,
+ * image grid Doppler, ellipsoid, wavelength and look side of the SLC, and
+ * sampled at the start of each pixel; otherwise
+ * isce3::except::InvalidArgument is thrown.
+ * \param[out] outputRaster  output raster for the geocoded SLC
+ * \param[in]  inputRaster   input raster of the SLC in radar coordinates
+ * \param[in]  geo2rdrCache  radar coordinates of the geocoded grid
+ * \param[in]  radarGrid     radar grid parameters
+ * \param[in]  orbit             orbit
+ * \param[in]  nativeDoppler     2D LUT Doppler of the SLC image
+ * \param[in]  imageGridDoppler  2D LUT Doppler of the image grid
+ * \param[in]  ellipsoid         ellipsoid object
+ * \param[in]  linesPerBlock     number of lines in each block
+ * \param[in]  flatten           flag to flatten the geocoded SLC
+ */
+void geocodeSlc(isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
+                const Geo2rdrCache& geo2rdrCache,
+                const isce3::product::RadarGridParameters& radarGrid,
+                const isce3::core::Orbit& orbit,
+                const isce3::core::LUT2d<double>& nativeDoppler,
+                const isce3::core::LUT2d<double>& imageGridDoppler,
+                const isce3::core::Ellipsoid& ellipsoid,
+                const size_t& linesPerBlock, const bool flatten = true);
+
 }} // namespace isce3::geocode
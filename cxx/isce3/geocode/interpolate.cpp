@@ -1,5 +1,7 @@
 #include "interpolate.h"
 
+#include <vector>
+
 void isce3::geocode::interpolate(
         const isce3::core::Matrix<std::complex<float>>& rdrDataBlock,
         isce3::core::Matrix<std::complex<float>>& geoDataBlock,
@@ -15,33 +17,55 @@ void isce3::geocode::interpolate(
     size_t width = geoDataBlock.width();
     int extraMargin = isce3::core::SINC_HALF;
 
-#pragma omp parallel for
-    for (size_t kk = 0; kk < length * width; ++kk) {
+    const isce3::core::Interpolator<std::complex<float>>::Map rdrMap =
+            rdrDataBlock.map();
+
+#pragma omp parallel
+    {
+        // Coordinates of the pixels of a line inside the radar block,
+        // interpolated with a single call
+        std::vector<double> xs(width), ys(width);
+        std::vector<size_t> cols(width);
+        std::vector<std::complex<float>> values(width);
+
+#pragma omp for
+        for (size_t i = 0; i < length; ++i) {
+
+            size_t n = 0;
+            for (size_t j = 0; j < width; ++j) {
 
-        size_t i = kk / width;
-        size_t j = kk % width;
+                // adjust the row and column indicies for the current block,
+                // i.e., moving the origin to the top-left of this radar block.
+                double rdrY = radarY[i * width + j] - azimuthFirstLine;
+                double rdrX = radarX[i * width + j] - rangeFirstPixel;
 
-        // adjust the row and column indicies for the current block,
-        // i.e., moving the origin to the top-left of this radar block.
-        double rdrY = radarY[i * width + j] - azimuthFirstLine;
-        double rdrX = radarX[i * width + j] - rangeFirstPixel;
+                if (rdrX < extraMargin || rdrY < extraMargin ||
+                    rdrX >= (radarBlockWidth - extraMargin) ||
+                    rdrY >= (radarBlockLength - extraMargin)) {
 
-        if (rdrX < extraMargin || rdrY < extraMargin ||
-            rdrX >= (radarBlockWidth - extraMargin) ||
-            rdrY >= (radarBlockLength - extraMargin)) {
+                    geoDataBlock(i,j) = std::complex<float> (0.0, 0.0);
 
-            geoDataBlock(i,j) = std::complex<float> (0.0, 0.0);
+                } else {
+                    xs[n] = rdrX;
+                    ys[n] = rdrY;
+                    cols[n] = j;
+                    ++n;
+                }
+            }
 
-        } else {
+            // Interpolate chips
+            interp->interpolate(xs.data(), ys.data(), n, rdrMap,
+                                values.data());
 
-            // Interpolate chip
-            const std::complex<double> cval =
-                interp->interpolate(rdrX, rdrY, rdrDataBlock);
+            for (size_t k = 0; k < n; ++k) {
+                const size_t j = cols[k];
+                const std::complex<double> cval = values[k];
 
-            // geometricalPhase is the sum of carrier (Doppler) phase to be added
-            // back and the geometrical phase to be removed: exp(1J* (carrier
-            // - 4.0*PI*slantRange/wavelength))
-            geoDataBlock(i, j) = cval * geometricalPhase[i * width + j];
+                // geometricalPhase is the sum of carrier (Doppler) phase to be
+                // added back and the geometrical phase to be removed:
+                // exp(1J* (carrier - 4.0*PI*slantRange/wavelength))
+                geoDataBlock(i, j) = cval * geometricalPhase[i * width + j];
+            }
         }
-    } // end for
+    } // end parallel
 }
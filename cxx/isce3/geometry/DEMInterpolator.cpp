@@ -7,6 +7,8 @@
 
 #include "DEMInterpolator.h"
 
+#include <algorithm>
+
 #include <isce3/core/Projections.h>
 #include <isce3/io/Raster.h>
 
@@ -257,4 +259,87 @@ interpolateXY(double x, double y) const {
     return _interp->interpolate(col, row, _dem);
 }
 
+/** @param[in] lon Longitudes of interpolation points.
+  * @param[in] lat Latitudes of interpolation points.
+  * @param[in] n Number of points.
+  * @param[out] out Interpolated heights.
+  *
+  * Interpolate DEM at a batch of longitudes and latitudes */
+void isce3::geometry::DEMInterpolator::
+interpolateLonLat(const double* lon, const double* lat, size_t n,
+                  double* out) const {
+
+    // If we don't have a DEM, just return reference height
+    if (!_haveRaster) {
+        std::fill(out, out + n, _refHeight);
+        return;
+    }
+
+    // Pass latitudes and longitudes through projection in chunks
+    constexpr size_t chunk = 256;
+    double x[chunk], y[chunk];
+    for (size_t start = 0; start < n; start += chunk) {
+        const size_t count = std::min(chunk, n - start);
+        for (size_t i = 0; i < count; ++i) {
+            cartesian_t xyz;
+            const cartesian_t llh{lon[start + i], lat[start + i], 0.0};
+            _proj->forward(llh, xyz);
+            x[i] = xyz[0];
+            y[i] = xyz[1];
+        }
+        interpolateXY(x, y, count, out + start);
+    }
+}
+
+/** @param[in] x X-coordinates of interpolation points.
+  * @param[in] y Y-coordinates of interpolation points.
+  * @param[in] n Number of points.
+  * @param[out] out Interpolated heights.
+  *
+  * Interpolate DEM at a batch of native coordinates */
+void isce3::geometry::DEMInterpolator::
+interpolateXY(const double* x, const double* y, size_t n, double* out) const {
+
+    // If we don't have a DEM, just return reference height
+    if (!_haveRaster) {
+        std::fill(out, out + n, _refHeight);
+        return;
+    }
+
+    // Gather the points inside the DEM in chunks, and interpolate each chunk
+    // in a single call
+    constexpr size_t chunk = 256;
+    double row[chunk], col[chunk];
+    size_t index[chunk];
+    float value[chunk];
+    for (size_t start = 0; start < n; start += chunk) {
+        const size_t count = std::min(chunk, n - start);
+        size_t valid = 0;
+        for (size_t i = 0; i < count; ++i) {
+            // Compute the row and column for requested lat and lon
+            const double r = (y[start + i] - _ystart) / _deltay;
+            const double c = (x[start + i] - _xstart) / _deltax;
+
+            // If outside bounds, return reference height
+            const int irow = int(std::floor(r));
+            const int icol = int(std::floor(c));
+            out[start + i] = _refHeight;
+            if (irow < 2 || irow >= int(_dem.length() - 1))
+                continue;
+            if (icol < 2 || icol >= int(_dem.width() - 1))
+                continue;
+
+            row[valid] = r;
+            col[valid] = c;
+            index[valid] = start + i;
+            ++valid;
+        }
+
+        _interp->interpolate(col, row, valid, _dem, value);
+        for (size_t i = 0; i < valid; ++i) {
+            out[index[i]] = value[i];
+        }
+    }
+}
+
 // end of file
@@ -75,6 +75,13 @@ class isce3::geometry::DEMInterpolator {
         /** Interpolate at native XY coordinates of DEM */
         double interpolateXY(double x, double y) const;
 
+        /** Interpolate at a batch of n longitudes and latitudes */
+        void interpolateLonLat(const double* lon, const double* lat, size_t n,
+                               double* out) const;
+        /** Interpolate at a batch of n native XY coordinates of DEM */
+        void interpolateXY(const double* x, const double* y, size_t n,
+                           double* out) const;
+
         /** Get starting X coordinate */
         double xStart() const { return _xstart; }
         /** Set starting X coordinate */
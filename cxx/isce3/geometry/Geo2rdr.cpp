@@ -7,22 +7,462 @@
 #include "Geo2rdr.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <future>
+#include <limits>
+#include <memory>
 #include <valarray>
+#include <vector>
 
 #include <isce3/core/Constants.h>
+#include <isce3/core/EphemerisTable.h>
 
 #include "geometry.h"
+#include "detail/Geo2Rdr.h"
 
 // pull in some isce3::core namespaces
 using isce3::io::Raster;
 using isce3::core::LUT1d;
 using isce3::core::Vec3;
 
+namespace {
+
+// Exact geo2rdr solution of a topo pixel in radar pixel units
+struct RadarPixel {
+    double az = 0.0;
+    double rg = 0.0;
+    // solution lies within the radar grid
+    bool inside = false;
+    // Newton iterations converged
+    bool converged = false;
+
+    bool valid() const { return inside && converged; }
+};
+
+// Geo2rdr of the pixels of a block of topo data
+struct BlockSolver {
+    const std::valarray<double>& x;
+    const std::valarray<double>& y;
+    const std::valarray<double>& hgt;
+    size_t width;
+    isce3::core::ProjectionBase* proj;
+    const isce3::core::Ellipsoid& ellipsoid;
+    const isce3::core::EphemerisTable& ephemeris;
+    const isce3::core::LUT2d<double>& doppler;
+    double wavelength;
+    isce3::core::LookSide side;
+    double threshold;
+    int numiter;
+    // radar grid, shifted by the constant offsets
+    double t0, dtaz, r0, dmrg;
+    size_t radarLength, radarWidth;
+
+    // Solve a pixel, optionally starting from an azimuth guess in lines
+    RadarPixel operator()(size_t blockLine, size_t pixel, double azGuess) const
+    {
+        // Convert topo XYZ to LLH
+        const size_t index = blockLine * width + pixel;
+        Vec3 xyz{x[index], y[index], hgt[index]};
+        Vec3 llh = proj->inverse(xyz);
+
+        // Perform geo->rdr iterations
+        double aztime = t0 + azGuess * dtaz, slantRange;
+        const int geostat = isce3::geometry::geo2rdr(
+            llh, ellipsoid, ephemeris, doppler, aztime, slantRange,
+            wavelength, side, threshold, numiter, 1.0e-8);
+
+        RadarPixel result;
+        result.az = (aztime - t0) / dtaz;
+        result.rg = (slantRange - r0) / dmrg;
+        result.inside = inside(result.az, result.rg);
+        result.converged = geostat;
+        return result;
+    }
+
+    // Error of an approximate solution of a pixel, in radar pixels. One
+    // Newton iteration started at the solution moves it to the exact one to
+    // within second order terms, which are negligible at pixel tolerances.
+    double error(size_t blockLine, size_t pixel, double az, double rg) const
+    {
+        const size_t index = blockLine * width + pixel;
+        Vec3 xyz{x[index], y[index], hgt[index]};
+        xyz = ellipsoid.lonLatToXyz(proj->inverse(xyz));
+
+        const double aztime = t0 + az * dtaz;
+        Vec3 pos, vel;
+        ephemeris.interpolate(&pos, &vel, aztime,
+                              isce3::core::OrbitInterpBorderMode::FillNaN);
+        const Vec3 dr = xyz - pos;
+        const double range = dr.norm();
+        const isce3::geometry::detail::Geo2RdrParams params;
+        const double dt = isce3::geometry::detail::computeDopplerAztimeDiff(
+                aztime, range, dr, vel, doppler, wavelength, params);
+
+        // the Newton update of the azimuth time, and the slant range change
+        // it causes
+        const double azError = dt / dtaz;
+        const double rgError = (rg - (range - r0) / dmrg) -
+                               dt * dr.dot(vel) / (range * dmrg);
+        return std::max(std::abs(azError), std::abs(rgError));
+    }
+
+    // Check if a solution is within the radar grid
+    bool inside(double az, double rg) const
+    {
+        return az >= 0.0 && az <= double(radarLength - 1) &&
+               rg >= 0.0 && rg <= double(radarWidth - 1);
+    }
+};
+
+// Nodes of the Lagrange interpolator for the cell [a, b] of an axis of n
+// samples: the cell ends and one node at each side, moved to the other side
+// near the edges of the axis (cubic, or lower order for short axes)
+int axisNodes(size_t a, size_t b, size_t n, size_t nodes[4])
+{
+    int count = 0;
+    nodes[count++] = a;
+    if (b == a)
+        return count;
+    nodes[count++] = b;
+
+    const size_t h = b - a;
+    const bool left = a >= h;
+    const bool right = b + h < n;
+    if (left)
+        nodes[count++] = a - h;
+    if (right)
+        nodes[count++] = b + h;
+    if (left && !right && a >= 2 * h)
+        nodes[count++] = a - 2 * h;
+    if (right && !left && b + 2 * h < n)
+        nodes[count++] = b + 2 * h;
+    return count;
+}
+
+// Lagrange weights of the position x for a set of nodes
+void lagrangeWeights(double x, const size_t* nodes, int count, double* w)
+{
+    for (int k = 0; k < count; ++k) {
+        w[k] = 1.0;
+        for (int m = 0; m < count; ++m) {
+            if (m != k) {
+                w[k] *= (x - double(nodes[m])) /
+                        (double(nodes[k]) - double(nodes[m]));
+            }
+        }
+    }
+}
+
+// Positions of the coarsest lattice along an axis of n samples
+std::vector<size_t> latticeNodes(size_t n, size_t spacing)
+{
+    std::vector<size_t> nodes;
+    for (size_t i = 0; i < n; i += spacing)
+        nodes.push_back(i);
+    if (nodes.back() != n - 1)
+        nodes.push_back(n - 1);
+    return nodes;
+}
+
+/*
+ * Approximate geo2rdr of a block of topo pixels
+ *
+ * Geo2rdr is solved exactly on a lattice and interpolated by tensor-product
+ * cubic Lagrange polynomials within each lattice cell. A cell is first
+ * checked against the exact solutions at its center, edge midpoints and
+ * quarter points, then the error of every interpolated pixel is computed
+ * from one Newton iteration started at it. The cell is split in four as soon
+ * as an error exceeds the tolerance. Cells that are at most two pixels
+ * across, or whose interpolation nodes include invalid solutions, are solved
+ * exactly.
+ *
+ * Exact solutions are memoized per pixel. Each cell writes the pixels it
+ * owns (its lower and left edges, and its upper and right edges at the end of
+ * the block), so that top level cells can be processed concurrently. Lattice
+ * nodes are solved first, from the coarse azimuth search, and all other
+ * solutions start from the nearest lattice node. Since a solution then only
+ * depends on its pixel, the output does not depend on the order in which
+ * cells are processed.
+ */
+template<class Solver>
+class SparseGeo2rdr {
+public:
+    // Statistics of the processing of a cell
+    struct Stats {
+        size_t solves = 0;
+        size_t converged = 0;
+        double maxError = 0.0;
+    };
+
+    SparseGeo2rdr(size_t length, size_t width, size_t spacing, double tol,
+                  const Solver& solver)
+        : _length(length), _width(width), _spacing(std::max<size_t>(spacing, 2)),
+          _tol(tol), _solver(solver), _nodes(length * width),
+          _state(new std::atomic<unsigned char>[length * width])
+    {
+        for (size_t i = 0; i < length * width; ++i)
+            _state[i].store(unsolved, std::memory_order_relaxed);
+    }
+
+    // Compute the offsets of all pixels, returning the accumulated statistics
+    Stats run(std::valarray<float>& rgoff, std::valarray<float>& azoff,
+              size_t lineStart, float nullValue)
+    {
+        _rgoff = &rgoff[0];
+        _azoff = &azoff[0];
+        _lineStart = lineStart;
+        _nullValue = nullValue;
+
+        const std::vector<size_t> lines = latticeNodes(_length, _spacing);
+        const std::vector<size_t> pixels = latticeNodes(_width, _spacing);
+
+        // solve the lattice nodes, which seed all other solutions
+        const size_t nNodes = lines.size() * pixels.size();
+        std::vector<Stats> nodeStats(nNodes);
+        #pragma omp parallel for schedule(dynamic)
+        for (size_t k = 0; k < nNodes; ++k) {
+            _node(lines[k / pixels.size()], pixels[k % pixels.size()],
+                  nodeStats[k]);
+        }
+
+        // process the top level cells
+        const size_t nl = std::max<size_t>(lines.size() - 1, 1);
+        const size_t np = std::max<size_t>(pixels.size() - 1, 1);
+        std::vector<Stats> cellStats(nl * np);
+        #pragma omp parallel for schedule(dynamic)
+        for (size_t k = 0; k < nl * np; ++k) {
+            const size_t i = k / np, j = k % np;
+            const size_t l0 = lines[i];
+            const size_t l1 = lines[std::min(i + 1, lines.size() - 1)];
+            const size_t p0 = pixels[j];
+            const size_t p1 = pixels[std::min(j + 1, pixels.size() - 1)];
+            _cell(l0, l1, p0, p1, i == nl - 1, j == np - 1, cellStats[k]);
+        }
+
+        Stats stats;
+        for (const auto& s : nodeStats)
+            stats.solves += s.solves;
+        for (const auto& s : cellStats) {
+            stats.solves += s.solves;
+            stats.converged += s.converged;
+            stats.maxError = std::max(stats.maxError, s.maxError);
+        }
+        return stats;
+    }
+
+private:
+    static constexpr unsigned char unsolved = 0;
+    static constexpr unsigned char solving = 1;
+    static constexpr unsigned char solved = 2;
+
+    // Nearest lattice node of a pixel
+    size_t _latticeNode(size_t i, size_t n) const
+    {
+        const size_t k = ((i + _spacing / 2) / _spacing) * _spacing;
+        return std::min(k, n - 1);
+    }
+
+    // Whether a pixel is on a lattice line (or column) of n samples
+    bool _onLattice(size_t i, size_t n) const
+    {
+        return i % _spacing == 0 || i == n - 1;
+    }
+
+    // Exact solution of a pixel
+    RadarPixel _node(size_t line, size_t pixel, Stats& stats)
+    {
+        const size_t index = line * _width + pixel;
+        unsigned char state = _state[index].load(std::memory_order_acquire);
+        if (state == solved)
+            return _nodes[index];
+
+        // lattice nodes are solved first, without a guess, so that they can
+        // seed the others (the nearest lattice node of the last one may be
+        // another lattice node still being solved)
+        double azGuess = std::numeric_limits<double>::quiet_NaN();
+        if (!_onLattice(line, _length) || !_onLattice(pixel, _width)) {
+            const size_t seedLine = _latticeNode(line, _length);
+            const size_t seedPixel = _latticeNode(pixel, _width);
+            const RadarPixel& seed = _nodes[seedLine * _width + seedPixel];
+            if (seed.converged)
+                azGuess = seed.az;
+        }
+
+        ++stats.solves;
+        if (state == unsolved &&
+            _state[index].compare_exchange_strong(state, solving,
+                                                  std::memory_order_acq_rel)) {
+            _nodes[index] = _solver(line, pixel, azGuess);
+            _state[index].store(solved, std::memory_order_release);
+            return _nodes[index];
+        }
+
+        // another thread is solving this pixel, so solve it here as well
+        return _solver(line, pixel, azGuess);
+    }
+
+    // Write the offsets of a pixel
+    void _write(size_t line, size_t pixel, double az, double rg, bool inside)
+    {
+        const size_t index = line * _width + pixel;
+        if (inside) {
+            _rgoff[index] = rg - float(pixel);
+            _azoff[index] = az - float(_lineStart + line);
+        } else {
+            _rgoff[index] = _nullValue;
+            _azoff[index] = _nullValue;
+        }
+    }
+
+    // Process the cell with corners (l0, p0) and (l1, p1)
+    void _cell(size_t l0, size_t l1, size_t p0, size_t p1, bool lastLine,
+               bool lastPixel, Stats& stats)
+    {
+        // pixels owned by the cell
+        const size_t lEnd = (lastLine || l1 == l0) ? l1 + 1 : l1;
+        const size_t pEnd = (lastPixel || p1 == p0) ? p1 + 1 : p1;
+
+        // solve small cells exactly
+        if (l1 - l0 <= 2 && p1 - p0 <= 2) {
+            for (size_t line = l0; line < lEnd; ++line) {
+                for (size_t pixel = p0; pixel < pEnd; ++pixel) {
+                    const RadarPixel node = _node(line, pixel, stats);
+                    _write(line, pixel, node.az, node.rg, node.inside);
+                    stats.converged += node.inside && node.converged;
+                }
+            }
+            return;
+        }
+
+        if (_interpolate(l0, l1, p0, p1, lEnd, pEnd, stats))
+            return;
+
+        // split the cell along the axes longer than two pixels
+        const size_t lm = (l0 + l1) / 2;
+        const size_t pm = (p0 + p1) / 2;
+        const bool splitLines = l1 - l0 >= 2;
+        const bool splitPixels = p1 - p0 >= 2;
+        const size_t lines[3] = {l0, splitLines ? lm : l1, l1};
+        const size_t pixels[3] = {p0, splitPixels ? pm : p1, p1};
+        const int nl = splitLines ? 2 : 1;
+        const int np = splitPixels ? 2 : 1;
+        for (int i = 0; i < nl; ++i) {
+            for (int j = 0; j < np; ++j) {
+                _cell(lines[i], lines[i + 1 + (nl == 1)], pixels[j],
+                      pixels[j + 1 + (np == 1)], lastLine && i == nl - 1,
+                      lastPixel && j == np - 1, stats);
+            }
+        }
+    }
+
+    // Interpolate the owned pixels of a cell if the interpolation is within
+    // the tolerance, returning whether it was
+    bool _interpolate(size_t l0, size_t l1, size_t p0, size_t p1, size_t lEnd,
+                      size_t pEnd, Stats& stats)
+    {
+        // interpolation nodes
+        size_t lines[4], pixels[4];
+        const int nl = axisNodes(l0, l1, _length, lines);
+        const int np = axisNodes(p0, p1, _width, pixels);
+        double az[4][4], rg[4][4];
+        for (int i = 0; i < nl; ++i) {
+            for (int j = 0; j < np; ++j) {
+                const RadarPixel node = _node(lines[i], pixels[j], stats);
+                if (!node.valid())
+                    return false;
+                az[i][j] = node.az;
+                rg[i][j] = node.rg;
+            }
+        }
+
+        // interpolate along pixels the node rows at a line
+        double wl[4], wp[4], azRow[4], rgRow[4];
+        auto interpolateLine = [&](size_t line) {
+            lagrangeWeights(line, lines, nl, wl);
+            for (int j = 0; j < np; ++j) {
+                azRow[j] = 0.0;
+                rgRow[j] = 0.0;
+                for (int i = 0; i < nl; ++i) {
+                    azRow[j] += wl[i] * az[i][j];
+                    rgRow[j] += wl[i] * rg[i][j];
+                }
+            }
+        };
+        auto interpolatePixel = [&](size_t pixel, double& azValue,
+                                    double& rgValue) {
+            lagrangeWeights(pixel, pixels, np, wp);
+            azValue = 0.0;
+            rgValue = 0.0;
+            for (int j = 0; j < np; ++j) {
+                azValue += wp[j] * azRow[j];
+                rgValue += wp[j] * rgRow[j];
+            }
+        };
+
+        // compare to the exact solutions at the center, edge midpoints and
+        // quarter points of the cell
+        const size_t lm = (l0 + l1) / 2;
+        const size_t pm = (p0 + p1) / 2;
+        const size_t lq0 = (3 * l0 + l1) / 4, lq1 = (l0 + 3 * l1) / 4;
+        const size_t pq0 = (3 * p0 + p1) / 4, pq1 = (p0 + 3 * p1) / 4;
+        const size_t checks[9][2] = {
+                {lm, pm},   {l0, pm},   {l1, pm},   {lm, p0},  {lm, p1},
+                {lq0, pq0}, {lq0, pq1}, {lq1, pq0}, {lq1, pq1}};
+        double maxError = 0.0;
+        for (const auto& check : checks) {
+            const RadarPixel node = _node(check[0], check[1], stats);
+            if (!node.valid())
+                return false;
+            double azValue, rgValue;
+            interpolateLine(check[0]);
+            interpolatePixel(check[1], azValue, rgValue);
+            maxError = std::max({maxError, std::abs(azValue - node.az),
+                                 std::abs(rgValue - node.rg)});
+            if (!(maxError <= _tol))
+                return false;
+        }
+
+        // interpolate the owned pixels, enforcing the tolerance on each (the
+        // owned pixels of the sub-cells cover the ones already written when
+        // the cell is split)
+        size_t converged = 0;
+        for (size_t line = l0; line < lEnd; ++line) {
+            interpolateLine(line);
+            for (size_t pixel = p0; pixel < pEnd; ++pixel) {
+                double azValue, rgValue;
+                interpolatePixel(pixel, azValue, rgValue);
+                maxError = std::max(maxError,
+                        _solver.error(line, pixel, azValue, rgValue));
+                if (!(maxError <= _tol))
+                    return false;
+                const bool inside = _solver.inside(azValue, rgValue);
+                _write(line, pixel, azValue, rgValue, inside);
+                converged += inside;
+            }
+        }
+        stats.converged += converged;
+        stats.maxError = std::max(stats.maxError, maxError);
+        return true;
+    }
+
+    size_t _length, _width, _spacing;
+    double _tol;
+    const Solver& _solver;
+    std::vector<RadarPixel> _nodes;
+    std::unique_ptr<std::atomic<unsigned char>[]> _state;
+
+    float* _rgoff = nullptr;
+    float* _azoff = nullptr;
+    size_t _lineStart = 0;
+    float _nullValue = 0.0f;
+};
+
+} // namespace
+
 // Run geo2rdr with no offsets; internal creation of offset rasters
 void isce3::geometry::Geo2rdr::
 geo2rdr(isce3::io::Raster & topoRaster,
@@ -94,8 +534,13 @@ geo2rdr(isce3::io::Raster & topoRaster,
     if ((demLength % _linesPerBlock) != 0)
         nBlocks += 1;
 
+    // Precompute interpolating polynomials of the orbit
+    const isce3::core::EphemerisTable ephemeris(_orbit);
+
     // Loop over blocks
     size_t converged = 0;
+    size_t solves = 0;
+    _approxError = 0.0;
     for (size_t block = 0; block < nBlocks; ++block) {
 
         // Get block extents
@@ -129,6 +574,27 @@ geo2rdr(isce3::io::Raster & topoRaster,
         topoRaster.getBlock(y, 0, lineStart, demWidth, blockLength, 2);
         topoRaster.getBlock(hgt, 0, lineStart, demWidth, blockLength,3);
 
+        BlockSolver solver{x, y, hgt, demWidth, _projTopo,
+                           _ellipsoid, ephemeris, _doppler,
+                           _radarGrid.wavelength(), _radarGrid.lookSide(),
+                           _threshold, _numiter, t0, dtaz, r0, dmrg,
+                           _radarGrid.length(), _radarGrid.width()};
+
+        // Interpolate between sparse exact solutions
+        if (_approxTolerance > 0.0) {
+            SparseGeo2rdr<BlockSolver> sparse(blockLength, demWidth,
+                                              _approxSpacing, _approxTolerance,
+                                              solver);
+            const auto stats = sparse.run(rgoff, azoff, lineStart, NULL_VALUE);
+            converged += stats.converged;
+            solves += stats.solves;
+            _approxError = std::max(_approxError, stats.maxError);
+
+            rgoffRaster.setBlock(rgoff, 0, lineStart, demWidth, blockLength);
+            azoffRaster.setBlock(azoff, 0, lineStart, demWidth, blockLength);
+            continue;
+        }
+
         // Loop over DEM lines in block
         for (size_t blockLine = 0; blockLine < blockLength; ++blockLine) {
 
@@ -139,31 +605,16 @@ geo2rdr(isce3::io::Raster & topoRaster,
             #pragma omp parallel for reduction(+:converged)
             for (size_t pixel = 0; pixel < demWidth; ++pixel) {
 
-                // Convert topo XYZ to LLH
-                const size_t index = blockLine * demWidth + pixel;
-                Vec3 xyz{x[index], y[index], hgt[index]};
-                Vec3 llh = _projTopo->inverse(xyz);
-
                 // Perform geo->rdr iterations
-                double aztime, slantRange;
-                int geostat = isce3::geometry::geo2rdr(
-                    llh, _ellipsoid, _orbit, _doppler,  aztime, slantRange,
-                    _radarGrid.wavelength(), _radarGrid.lookSide(),
-                    _threshold, _numiter, 1.0e-8
-                );
-
-                // Check if solution is out of bounds
-                bool isOutside = false;
-                if ((aztime < t0) || (aztime > tend))
-                    isOutside = true;
-                if ((slantRange < r0) || (slantRange > rngend))
-                    isOutside = true;
+                const size_t index = blockLine * demWidth + pixel;
+                const RadarPixel result = solver(
+                    blockLine, pixel, std::numeric_limits<double>::quiet_NaN());
 
                 // Save result if valid
-                if (!isOutside) {
-                    rgoff[index] = ((slantRange - r0) / dmrg) - float(pixel);
-                    azoff[index] = ((aztime - t0) / dtaz) - float(line);
-                    converged += geostat;
+                if (result.inside) {
+                    rgoff[index] = result.rg - float(pixel);
+                    azoff[index] = result.az - float(line);
+                    converged += result.converged;
                 } else {
                     rgoff[index] = NULL_VALUE;
                     azoff[index] = NULL_VALUE;
@@ -180,6 +631,12 @@ geo2rdr(isce3::io::Raster & topoRaster,
     // Print out convergence statistics
     info << "Total convergence: " << converged << " out of "
          << (demWidth * demLength) << pyre::journal::endl;
+    if (_approxTolerance > 0.0) {
+        info << "Approximate geo2rdr: " << solves << " exact solutions for "
+             << (demWidth * demLength) << " pixels, maximum interpolation error "
+             << _approxError << " pixels (tolerance " << _approxTolerance
+             << " pixels)" << pyre::journal::endl;
+    }
 }
 
 // Print extents and image sizes
@@ -92,6 +92,27 @@ public:
      */
     void numiter(int n) { _numiter = n; }
 
+    /**
+     * Set interpolation tolerance of approximate geo2rdr
+     *
+     * When positive, geo2rdr is solved exactly on a coarse lattice of topo
+     * pixels and bicubically interpolated in between. Lattice cells are
+     * recursively split until the interpolated range and azimuth of every
+     * pixel are within the tolerance of the exact solution, the error of a
+     * pixel being given by one Newton iteration of geo2rdr started at its
+     * interpolated solution. Zero (the default) solves every pixel exactly.
+     *
+     * @param[in] tol Tolerance in radar pixels
+     */
+    void approximationTolerance(double tol) { _approxTolerance = tol; }
+
+    /**
+     * Set lattice spacing of approximate geo2rdr
+     *
+     * @param[in] spacing Spacing of the coarsest lattice in topo pixels
+     */
+    void approximationSpacing(size_t spacing) { _approxSpacing = spacing; }
+
     /**
      * Run geo2rdr with offsets and externally created offset rasters
      *
@@ -149,6 +170,20 @@ public:
     /** Return number of Newton-Raphson iterations used for processing */
     int numiter() const { return _numiter; }
 
+    /** Return interpolation tolerance of approximate geo2rdr in radar pixels */
+    double approximationTolerance() const { return _approxTolerance; }
+
+    /** Return lattice spacing of approximate geo2rdr in topo pixels */
+    size_t approximationSpacing() const { return _approxSpacing; }
+
+    /**
+     * Return largest interpolation error of the last approximate run
+     *
+     * The error (in radar pixels) is the largest one over all interpolated
+     * pixels, which is at most the tolerance.
+     */
+    double approximationError() const { return _approxError; }
+
 private:
 
     /** Print information for debugging */
@@ -175,6 +210,9 @@ private:
     int _numiter;
     double _threshold;
     size_t _linesPerBlock = 1000;
+    double _approxTolerance = 0.0;
+    size_t _approxSpacing = 32;
+    double _approxError = 0.0;
 };
 
 // Get inline implementations for Geo2rdr
@@ -10,13 +10,17 @@
 #include <cmath>
 #include <cpl_virtualmem.h>
 #include <isce3/core/Basis.h>
+#include <isce3/core/BlockPipeline.h>
 #include <isce3/core/DenseMatrix.h>
 #include <isce3/core/Projections.h>
+#include <isce3/geocode/Geo2rdrCache.h>
 #include <isce3/geometry/boundingbox.h>
 #include <isce3/geometry/geometry.h>
+#include <isce3/io/WriteQueue.h>
 #include <isce3/signal/Looks.h>
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 #include "DEMInterpolator.h"
 #include "RTC.h"
@@ -62,6 +66,21 @@ void _accumulate(T_out& band_value, T a, double b) {
     band_value += a2 * b;
 }
 
+// Enable concurrent reads on a raster for the lifetime of the guard,
+// restoring the previous setting afterwards
+class ConcurrentReadGuard {
+public:
+    explicit ConcurrentReadGuard(isce3::io::Raster& raster)
+        : _raster(raster), _previous(raster.concurrentReads()) {
+        _raster.concurrentReads(true);
+    }
+    ~ConcurrentReadGuard() { _raster.concurrentReads(_previous); }
+
+private:
+    isce3::io::Raster& _raster;
+    bool _previous;
+};
+
 template <typename T> struct is_complex_t : std::false_type {};
 template <typename T> struct is_complex_t<std::complex<T>> : std::true_type {};
 template <typename T>
@@ -211,148 +230,113 @@ void Geocode<T>::geocodeInterp(
     std::unique_ptr<isce3::core::ProjectionBase> proj(
             isce3::core::createProj(_epsgOut));
 
-    // instantiate the DEMInterpolator
-    DEMInterpolator demInterp;
-
     // Compute number of blocks in the output geocoded grid
     int nBlocks = _geoGridLength / _linesPerBlock;
     if ((_geoGridLength % _linesPerBlock) != 0)
         nBlocks += 1;
 
     std::cout << "nBlocks: " << nBlocks << std::endl;
-    // loop over the blocks of the geocoded Grid
-    for (int block = 0; block < nBlocks; ++block) {
-        std::cout << "block: " << block << std::endl;
-        // Get block extents (of the geocoded grid)
-        int lineStart, geoBlockLength;
-        lineStart = block * _linesPerBlock;
-        if (block == (nBlocks - 1)) {
-            geoBlockLength = _geoGridLength - lineStart;
-        } else {
-            geoBlockLength = _linesPerBlock;
-        }
-        int blockSize = geoBlockLength * _geoGridWidth;
 
-        // First and last line of the data block in radar coordinates
-        size_t azimuthFirstLine = radar_grid.length() - 1;
-        size_t azimuthLastLine = 0;
+    // make sure precomputed radar coordinates cover the geogrid, sampled at
+    // pixel centers like _geo2rdrBlock, and match the radar geometry
+    if (_geo2rdrCache) {
+        _geo2rdrCache->checkGeoGrid(
+                isce3::product::GeoGridParameters(
+                        _geoGridStartX, _geoGridStartY, _geoGridSpacingX,
+                        _geoGridSpacingY, _geoGridWidth, _geoGridLength,
+                        _epsgOut),
+                0.5);
+        _geo2rdrCache->checkGeometry(_orbit, _doppler, _ellipsoid,
+                                     radar_grid.wavelength(),
+                                     radar_grid.lookSide());
+    }
 
-        // First and last pixel of the data block in radar coordinates
-        size_t rangeFirstPixel = radar_grid.width() - 1;
-        size_t rangeLastPixel = 0;
+    // Per-block working state. The block pipeline below keeps several
+    // consecutive blocks in flight (DEM prefetch, geo2rdr, radar data read,
+    // interpolation and write-back), each in its own slot, so that GDAL I/O
+    // overlaps with computation while the memory footprint stays bounded by
+    // the number of slots.
+    struct InterpBlock {
+        // Block extents (of the geocoded grid)
+        int lineStart = 0;
+        int geoBlockLength = 0;
 
-        // load a block of DEM for the current geocoded grid
-        _loadDEM(demRaster, demInterp, proj.get(), lineStart, geoBlockLength,
-                 _geoGridWidth, _demBlockMargin);
+        // DEM for the current geocoded block
+        DEMInterpolator demInterp;
 
         // X and Y indices (in the radar coordinates) for the
         // geocoded pixels (after geo2rdr computation)
-        std::valarray<double> radarX(blockSize);
-        std::valarray<double> radarY(blockSize);
-
-#pragma omp parallel shared(azimuthFirstLine, rangeFirstPixel,                 \
-                            azimuthLastLine, rangeLastPixel)
-        {
-            // Init thread-local swath extents
-            size_t localAzimuthFirstLine = radar_grid.length() - 1;
-            size_t localAzimuthLastLine = 0;
-            size_t localRangeFirstPixel = radar_grid.width() - 1;
-            size_t localRangeLastPixel = 0;
-
-// Loop over lines, samples of the output grid
-#pragma omp for collapse(2)
-            for (int blockLine = 0; blockLine < geoBlockLength; ++blockLine) {
-                for (int pixel = 0; pixel < _geoGridWidth; ++pixel) {
-
-                    // Global line index
-                    const int line = lineStart + blockLine;
-
-                    // y coordinate in the out put grid
-                    double y = _geoGridStartY + _geoGridSpacingY * (0.5 + line);
-
-                    // x in the output geocoded Grid
-                    double x =
-                            _geoGridStartX + _geoGridSpacingX * (0.5 + pixel);
-
-                    // Consistency check
-
-                    // compute the azimuth time and slant range for the
-                    // x,y coordinates in the output grid
-                    double aztime, srange;
-                    _geo2rdr(radar_grid, x, y, aztime, srange, demInterp,
-                             proj.get());
-
-                    if (std::isnan(aztime) || std::isnan(srange))
-                        continue;
+        std::valarray<double> radarX;
+        std::valarray<double> radarY;
 
-                    // get the row and column index in the radar grid
-                    double rdrX, rdrY;
-                    rdrY = ((aztime - radar_grid.sensingStart()) /
-                            radar_grid.azimuthTimeInterval());
-
-                    rdrX = ((srange - radar_grid.startingRange()) /
-                            radar_grid.rangePixelSpacing());
-
-                    if (rdrY < 0 || rdrX < 0 || rdrY >= radar_grid.length() ||
-                        rdrX >= radar_grid.width())
-                        continue;
+        // First and last line/pixel of the data block in radar coordinates
+        size_t azimuthFirstLine = 0;
+        size_t azimuthLastLine = 0;
+        size_t rangeFirstPixel = 0;
+        size_t rangeLastPixel = 0;
 
-                    localAzimuthFirstLine = std::min(localAzimuthFirstLine,
-                                                     (size_t) std::floor(rdrY));
-                    localAzimuthLastLine = std::max(
-                            localAzimuthLastLine, (size_t) std::ceil(rdrY) - 1);
-                    localRangeFirstPixel = std::min(localRangeFirstPixel,
-                                                    (size_t) std::floor(rdrX));
-                    localRangeLastPixel = std::max(
-                            localRangeLastPixel, (size_t) std::ceil(rdrX) - 1);
+        // Flag indicating that the block has no radar coverage
+        bool empty = true;
 
-                    // store the adjusted X and Y indices
-                    radarX[blockLine * _geoGridWidth + pixel] = rdrX;
-                    radarY[blockLine * _geoGridWidth + pixel] = rdrY;
+        // Radar and geocoded data blocks (one per band)
+        std::vector<isce3::core::Matrix<T_out>> rdrDataBlock;
+        std::vector<isce3::core::Matrix<T_out>> geoDataBlock;
+    };
 
-                } // end loop over pixels of output grid
-            }     // end loops over lines of output grid
+    std::vector<InterpBlock> slots;
+    isce3::core::BlockPipeline pipeline;
 
-#pragma omp critical
-            {
-                // Get min and max swath extents from among all threads
-                azimuthFirstLine = std::min(azimuthFirstLine, localAzimuthFirstLine);
-                azimuthLastLine = std::max(azimuthLastLine, localAzimuthLastLine);
-                rangeFirstPixel = std::min(rangeFirstPixel, localRangeFirstPixel);
-                rangeLastPixel = std::max(rangeLastPixel, localRangeLastPixel);
-            }
+    // load a block of DEM for the current geocoded grid
+    pipeline.io([&](int block, int slot) {
+        InterpBlock& b = slots[slot];
+        b.lineStart = block * _linesPerBlock;
+        if (block == (nBlocks - 1)) {
+            b.geoBlockLength = _geoGridLength - b.lineStart;
+        } else {
+            b.geoBlockLength = _linesPerBlock;
         }
+        if (!_geo2rdrCache)
+            _loadDEM(demRaster, b.demInterp, proj.get(), b.lineStart,
+                     b.geoBlockLength, _geoGridWidth, _demBlockMargin);
+    });
 
-        if (azimuthFirstLine > azimuthLastLine ||
-            rangeFirstPixel > rangeLastPixel)
-            continue;
+    // compute the radar coordinates of the geocoded grid
+    pipeline.compute([&](int block, int slot) {
+        std::cout << "block: " << block << std::endl;
+        InterpBlock& b = slots[slot];
+        _geo2rdrBlock(radar_grid, b.lineStart, b.geoBlockLength,
+                      b.demInterp, proj.get(), b.radarX, b.radarY,
+                      b.azimuthFirstLine, b.azimuthLastLine,
+                      b.rangeFirstPixel, b.rangeLastPixel);
+        b.empty = (b.azimuthFirstLine > b.azimuthLastLine ||
+                   b.rangeFirstPixel > b.rangeLastPixel);
+    });
+
+    // read the required block of data in the radar coordinates
+    pipeline.io([&](int, int slot) {
+        InterpBlock& b = slots[slot];
+        if (b.empty)
+            return;
 
         // shape of the required block of data in the radar coordinates
-        int rdrBlockLength = azimuthLastLine - azimuthFirstLine + 1;
-        int rdrBlockWidth = rangeLastPixel - rangeFirstPixel + 1;
-
-        // define the matrix based on the rasterbands data type
-        isce3::core::Matrix<T_out> rdrDataBlock(rdrBlockLength, rdrBlockWidth);
-        isce3::core::Matrix<T_out> geoDataBlock(geoBlockLength, _geoGridWidth);
+        const int rdrBlockLength = b.azimuthLastLine - b.azimuthFirstLine + 1;
+        const int rdrBlockWidth = b.rangeLastPixel - b.rangeFirstPixel + 1;
 
-        // fill both matrices with NaN
-        rdrDataBlock.fill(std::numeric_limits<T_out>::quiet_NaN());
-        geoDataBlock.fill(std::numeric_limits<T_out>::quiet_NaN());
-
-        //for each band in the input:
+        b.rdrDataBlock.resize(nbands);
         for (int band = 0; band < nbands; ++band) {
-            std::cout << "band: " << band << std::endl;
-            // get a block of data
-            std::cout << "get data block " << std::endl;
+            isce3::core::Matrix<T_out>& rdrDataBlock = b.rdrDataBlock[band];
+            rdrDataBlock.resize(rdrBlockLength, rdrBlockWidth);
+            rdrDataBlock.fill(std::numeric_limits<T_out>::quiet_NaN());
+
             if ((std::is_same<T, std::complex<float>>::value ||
                  std::is_same<T, std::complex<double>>::value)
                     &&(std::is_same<T_out, float>::value ||
                        std::is_same<T_out, double>::value) ) {
                 isce3::core::Matrix<T> rdrDataBlockTemp(rdrBlockLength,
                                                        rdrBlockWidth);
-                inputRaster.getBlock(rdrDataBlockTemp.data(), rangeFirstPixel,
-                                     azimuthFirstLine, rdrBlockWidth,
-                                     rdrBlockLength, band + 1);
+                inputRaster.getBlock(rdrDataBlockTemp.data(),
+                                     b.rangeFirstPixel, b.azimuthFirstLine,
+                                     rdrBlockWidth, rdrBlockLength, band + 1);
                 for (int i = 0; i < rdrBlockLength; ++i)
                     for (int j = 0; j < rdrBlockWidth; ++j) {
                         T_out output_value;
@@ -361,23 +345,45 @@ void Geocode<T>::geocodeInterp(
                         rdrDataBlock(i, j) = output_value;
                     }
             } else
-                inputRaster.getBlock(rdrDataBlock.data(), rangeFirstPixel,
-                                     azimuthFirstLine, rdrBlockWidth,
+                inputRaster.getBlock(rdrDataBlock.data(), b.rangeFirstPixel,
+                                     b.azimuthFirstLine, rdrBlockWidth,
                                      rdrBlockLength, band + 1);
+        }
+    });
+
+    // interpolate the data in radar grid to the geocoded grid
+    pipeline.compute([&](int, int slot) {
+        InterpBlock& b = slots[slot];
+        if (b.empty)
+            return;
 
-            // interpolate the data in radar grid to the geocoded grid
-            std::cout << "interpolate " << std::endl;
-            _interpolate(rdrDataBlock, geoDataBlock, radarX, radarY,
-                         rdrBlockWidth, rdrBlockLength, azimuthFirstLine,
-                         rangeFirstPixel, interp.get());
+        const int rdrBlockLength = b.azimuthLastLine - b.azimuthFirstLine + 1;
+        const int rdrBlockWidth = b.rangeLastPixel - b.rangeFirstPixel + 1;
 
-            // set output
-            std::cout << "set output " << std::endl;
-            outputRaster.setBlock(geoDataBlock.data(), 0, lineStart,
-                                  _geoGridWidth, geoBlockLength, band + 1);
+        b.geoDataBlock.resize(nbands);
+        for (int band = 0; band < nbands; ++band) {
+            isce3::core::Matrix<T_out>& geoDataBlock = b.geoDataBlock[band];
+            geoDataBlock.resize(b.geoBlockLength, _geoGridWidth);
+            geoDataBlock.fill(std::numeric_limits<T_out>::quiet_NaN());
+            _interpolate(b.rdrDataBlock[band], geoDataBlock, b.radarX,
+                         b.radarY, rdrBlockWidth, rdrBlockLength,
+                         b.azimuthFirstLine, b.rangeFirstPixel, interp.get());
         }
-        // set output block of data
-    } // end loop over block of output grid
+    });
+
+    // set output block of data
+    pipeline.io([&](int, int slot) {
+        InterpBlock& b = slots[slot];
+        if (b.empty)
+            return;
+        for (int band = 0; band < nbands; ++band)
+            outputRaster.setBlock(b.geoDataBlock[band].data(), 0,
+                                  b.lineStart, _geoGridWidth,
+                                  b.geoBlockLength, band + 1);
+    });
+
+    slots = std::vector<InterpBlock>(pipeline.numSlots());
+    pipeline.run(nBlocks);
 
     double geotransform[] = {
             _geoGridStartX,  _geoGridSpacingX, 0, _geoGridStartY, 0,
@@ -392,6 +398,103 @@ void Geocode<T>::geocodeInterp(
     outputRaster.setEPSG(_epsgOut);
 }
 
+template<class T>
+void Geocode<T>::_geo2rdrBlock(
+        const isce3::product::RadarGridParameters& radar_grid, int lineStart,
+        int geoBlockLength, DEMInterpolator& demInterp,
+        isce3::core::ProjectionBase* proj, std::valarray<double>& radarX,
+        std::valarray<double>& radarY, size_t& azimuthFirstLine,
+        size_t& azimuthLastLine, size_t& rangeFirstPixel,
+        size_t& rangeLastPixel) {
+
+    const int blockSize = geoBlockLength * _geoGridWidth;
+    radarX.resize(blockSize);
+    radarY.resize(blockSize);
+
+    // First and last line of the data block in radar coordinates
+    azimuthFirstLine = radar_grid.length() - 1;
+    azimuthLastLine = 0;
+
+    // First and last pixel of the data block in radar coordinates
+    rangeFirstPixel = radar_grid.width() - 1;
+    rangeLastPixel = 0;
+
+#pragma omp parallel shared(azimuthFirstLine, rangeFirstPixel,                 \
+                            azimuthLastLine, rangeLastPixel)
+    {
+        // Init thread-local swath extents
+        size_t localAzimuthFirstLine = radar_grid.length() - 1;
+        size_t localAzimuthLastLine = 0;
+        size_t localRangeFirstPixel = radar_grid.width() - 1;
+        size_t localRangeLastPixel = 0;
+
+// Loop over lines, samples of the output grid
+#pragma omp for collapse(2)
+        for (int blockLine = 0; blockLine < geoBlockLength; ++blockLine) {
+            for (int pixel = 0; pixel < _geoGridWidth; ++pixel) {
+
+                // Global line index
+                const int line = lineStart + blockLine;
+
+                // y coordinate in the out put grid
+                double y = _geoGridStartY + _geoGridSpacingY * (0.5 + line);
+
+                // x in the output geocoded Grid
+                double x = _geoGridStartX + _geoGridSpacingX * (0.5 + pixel);
+
+                // compute the azimuth time and slant range for the
+                // x,y coordinates in the output grid
+                double aztime, srange;
+                if (_geo2rdrCache) {
+                    aztime = _geo2rdrCache->azimuthTime(line, pixel);
+                    srange = _geo2rdrCache->slantRange(line, pixel);
+                } else {
+                    _geo2rdr(radar_grid, x, y, aztime, srange, demInterp,
+                             proj);
+                }
+
+                if (std::isnan(aztime) || std::isnan(srange))
+                    continue;
+
+                // get the row and column index in the radar grid
+                double rdrX, rdrY;
+                rdrY = ((aztime - radar_grid.sensingStart()) /
+                        radar_grid.azimuthTimeInterval());
+
+                rdrX = ((srange - radar_grid.startingRange()) /
+                        radar_grid.rangePixelSpacing());
+
+                if (rdrY < 0 || rdrX < 0 || rdrY >= radar_grid.length() ||
+                    rdrX >= radar_grid.width())
+                    continue;
+
+                localAzimuthFirstLine = std::min(localAzimuthFirstLine,
+                                                 (size_t) std::floor(rdrY));
+                localAzimuthLastLine = std::max(
+                        localAzimuthLastLine, (size_t) std::ceil(rdrY) - 1);
+                localRangeFirstPixel = std::min(localRangeFirstPixel,
+                                                (size_t) std::floor(rdrX));
+                localRangeLastPixel = std::max(
+                        localRangeLastPixel, (size_t) std::ceil(rdrX) - 1);
+
+                // store the adjusted X and Y indices
+                radarX[blockLine * _geoGridWidth + pixel] = rdrX;
+                radarY[blockLine * _geoGridWidth + pixel] = rdrY;
+
+            } // end loop over pixels of output grid
+        }     // end loops over lines of output grid
+
+#pragma omp critical
+        {
+            // Get min and max swath extents from among all threads
+            azimuthFirstLine = std::min(azimuthFirstLine, localAzimuthFirstLine);
+            azimuthLastLine = std::max(azimuthLastLine, localAzimuthLastLine);
+            rangeFirstPixel = std::min(rangeFirstPixel, localRangeFirstPixel);
+            rangeLastPixel = std::max(rangeLastPixel, localRangeLastPixel);
+        }
+    }
+}
+
 template<class T>
 template<class T_out>
 void Geocode<T>::_interpolate(isce3::core::Matrix<T_out>& rdrDataBlock,
@@ -404,23 +507,44 @@ void Geocode<T>::_interpolate(isce3::core::Matrix<T_out>& rdrDataBlock,
     auto length = geoDataBlock.length();
     auto width = geoDataBlock.width();
     double extraMargin = 4.0;
+    const typename isce3::core::Interpolator<T_out>::Map rdrMap =
+            rdrDataBlock.map();
 
-#pragma omp parallel for
-    for (decltype(length) kk = 0; kk < length * width; ++kk) {
-
-        auto i = kk / width;
-        auto j = kk % width;
-
-        // adjust the row and column indicies for the current block,
-        // i.e., moving the origin to the top-left of this radar block.
-        double rdrY = radarY[i * width + j] - azimuthFirstLine;
-        double rdrX = radarX[i * width + j] - rangeFirstPixel;
+#pragma omp parallel
+    {
+        // Coordinates of the pixels of a line inside the radar block,
+        // interpolated with a single call
+        std::vector<double> xs(width), ys(width);
+        std::vector<size_t> cols(width);
+        std::vector<T_out> values(width);
+
+#pragma omp for
+        for (decltype(length) i = 0; i < length; ++i) {
+
+            size_t n = 0;
+            for (decltype(width) j = 0; j < width; ++j) {
+
+                // adjust the row and column indicies for the current block,
+                // i.e., moving the origin to the top-left of this radar block.
+                double rdrY = radarY[i * width + j] - azimuthFirstLine;
+                double rdrX = radarX[i * width + j] - rangeFirstPixel;
+
+                if (rdrX < extraMargin || rdrY < extraMargin ||
+                    rdrX >= (radarBlockWidth - extraMargin) ||
+                    rdrY >= (radarBlockLength - extraMargin))
+                    continue;
+                xs[n] = rdrX;
+                ys[n] = rdrY;
+                cols[n] = j;
+                ++n;
+            }
 
-        if (rdrX < extraMargin || rdrY < extraMargin ||
-            rdrX >= (radarBlockWidth - extraMargin) ||
-            rdrY >= (radarBlockLength - extraMargin))
-            continue;
-        geoDataBlock(i, j) = _interp->interpolate(rdrX, rdrY, rdrDataBlock);
+            _interp->interpolate(xs.data(), ys.data(), n, rdrMap,
+                                 values.data());
+            for (size_t k = 0; k < n; ++k) {
+                geoDataBlock(i, cols[k]) = values[k];
+            }
+        }
     }
 }
 
@@ -627,6 +751,12 @@ void Geocode<T>::geocodeAreaProj(
             if (std::isnan(rtc_geogrid_upsampling))
                 rtc_geogrid_upsampling = 2 * geogrid_upsampling;
 
+            // tiled accumulation gives an RTC that does not depend on the
+            // number of threads, at the cost of one radar-grid tile per block
+            const isce3::geometry::rtcAccumulationMode rtc_accumulation_mode =
+                    _deterministic ? isce3::geometry::RTC_ACCUMULATE_TILES
+                                   : isce3::geometry::RTC_ACCUMULATE_ATOMIC;
+
             isce3::geometry::rtcMemoryMode rtc_memory_mode;
             if (geocode_memory_mode == geocodeMemoryMode::AUTO)
                 rtc_memory_mode = isce3::geometry::RTC_AUTO;
@@ -641,7 +771,8 @@ void Geocode<T>::geocodeAreaProj(
                      input_radiometry, rtc_area_mode, rtc_algorithm,
                      rtc_geogrid_upsampling, rtc_min_value_db, radar_grid_nlooks,
                      nullptr, nullptr, nullptr, rtc_memory_mode,
-                     interp_method, _threshold, _numiter, 1.0e-8);
+                     interp_method, _threshold, _numiter, 1.0e-8,
+                     rtc_accumulation_mode);
         } else {
             info << "reading pre-computed RTC..." << pyre::journal::endl;
             rtc_raster = input_rtc;
@@ -704,6 +835,10 @@ void Geocode<T>::geocodeAreaProj(
 
     std::vector<std::unique_ptr<isce3::core::Matrix<T_out>>> rdrData;
 
+    // input and DEM blocks are read concurrently by the worker threads
+    ConcurrentReadGuard input_read_guard(input_raster);
+    ConcurrentReadGuard dem_read_guard(dem_raster);
+
     if (is_radar_grid_single_block) {
         rdrData.reserve(nbands);
         if (!std::is_same<T, T_out>::value) {
@@ -733,13 +868,10 @@ void Geocode<T>::geocodeAreaProj(
                                     radar_grid.length() % radar_block_size;
                         isce3::core::Matrix<T> radar_data_out(
                                 this_block_size, radar_grid.width());
-                        #pragma omp critical
-                        {
-                            input_raster.getBlock(radar_data_out.data(), 0,
-                                                  block * radar_block_size,
-                                                  radar_grid.width(),
-                                                  this_block_size, band + 1);
-                        }
+                        input_raster.getBlock(radar_data_out.data(), 0,
+                                              block * radar_block_size,
+                                              radar_grid.width(),
+                                              this_block_size, band + 1);
                         for (int i = 0; i < this_block_size; ++i) {
                             // initiating lower right vertex
                             int ii = block * radar_block_size + i;
@@ -773,6 +905,18 @@ void Geocode<T>::geocodeAreaProj(
         block_size = _geoGridLength;
         block_size_with_upsampling = imax;
     }
+    else if (_deterministic) {
+        // geo2rdr solutions are seeded from neighboring pixels within a
+        // block, so the block boundaries must not depend on the number of
+        // threads
+        const int deterministic_block_length =
+                isce3::core::AREA_PROJECTION_DETERMINISTIC_BLOCK_LENGTH *
+                std::max(1, static_cast<int>(geogrid_upsampling));
+        nblocks = areaProjGetNBlocks(imax, &info, geogrid_upsampling,
+                                     &block_size_with_upsampling, &block_size,
+                                     deterministic_block_length,
+                                     deterministic_block_length);
+    }
     else {
         if (geocode_memory_mode == 
             geocodeMemoryMode::BLOCKS_GEOGRID_AND_RADARGRID) {
@@ -793,6 +937,14 @@ void Geocode<T>::geocodeAreaProj(
 
     info << "starting geocoding" << pyre::journal::endl; 
 
+    // output blocks are written by a single writer thread in submission
+    // order, holding at most about two blocks worth of pending writes
+    const int writes_per_block = nbands + 2 * (out_geo_vertices != nullptr) +
+                                 (out_dem_vertices != nullptr) +
+                                 (out_geo_nlooks != nullptr) +
+                                 (out_geo_rtc != nullptr);
+    isce3::io::WriteQueue write_queue(2 * writes_per_block);
+
     #pragma omp parallel for schedule(dynamic)
     for (int block = 0; block < nblocks; ++block) {
         _RunBlock<T_out>(radar_grid, is_radar_grid_single_block, rdrData, jmax,
@@ -803,11 +955,12 @@ void Geocode<T>::geocodeAreaProj(
                          out_dem_vertices,
                          out_geo_nlooks, out_geo_rtc, start,
                          pixazm, dr, r0, xbound, ybound, proj.get(), rtc_area,
-                         input_raster, output_raster, output_mode,
-                         rtc_min_value, abs_cal_factor,
+                         input_raster, output_raster, write_queue,
+                         output_mode, rtc_min_value, abs_cal_factor,
                          clip_min, clip_max, min_nlooks,
                          radar_grid_nlooks, info);
     }
+    write_queue.flush();
     printf("\rgeocode progress: 100%%\n");
 
     double geotransform[] = {
@@ -942,6 +1095,7 @@ void Geocode<T>::_RunBlock(
         const double dr, double r0, int xbound, int ybound,
         isce3::core::ProjectionBase* proj, isce3::core::Matrix<float>& rtc_area,
         isce3::io::Raster& input_raster, isce3::io::Raster& output_raster,
+        isce3::io::WriteQueue& write_queue,
         isce3::geometry::geocodeOutputMode output_mode,
         float rtc_min_value, double abs_cal_factor, float clip_min,
         float clip_max, float min_nlooks, float radar_grid_nlooks,
@@ -961,8 +1115,13 @@ void Geocode<T>::_RunBlock(
     const int this_block_size_with_upsampling =
             this_block_size * geogrid_upsampling;
 
-    isce3::core::Matrix<float> out_geo_vertices_a;
-    isce3::core::Matrix<float> out_geo_vertices_r;
+    // output arrays are heap-allocated so that they can be handed over to
+    // the write queue once the block is done
+    using MatrixPtr = std::unique_ptr<isce3::core::Matrix<float>>;
+    MatrixPtr out_geo_vertices_a_ptr = std::make_unique<isce3::core::Matrix<float>>();
+    MatrixPtr out_geo_vertices_r_ptr = std::make_unique<isce3::core::Matrix<float>>();
+    isce3::core::Matrix<float>& out_geo_vertices_a = *out_geo_vertices_a_ptr;
+    isce3::core::Matrix<float>& out_geo_vertices_r = *out_geo_vertices_r_ptr;
     if (out_geo_vertices != nullptr) {
         out_geo_vertices_a.resize(this_block_size_with_upsampling + 1,
                                   jmax + 1);
@@ -972,20 +1131,23 @@ void Geocode<T>::_RunBlock(
         out_geo_vertices_r.fill(std::numeric_limits<float>::quiet_NaN());
     }
 
-    isce3::core::Matrix<float> out_dem_vertices_array;
+    MatrixPtr out_dem_vertices_ptr = std::make_unique<isce3::core::Matrix<float>>();
+    isce3::core::Matrix<float>& out_dem_vertices_array = *out_dem_vertices_ptr;
     if (out_dem_vertices != nullptr) {
         out_dem_vertices_array.resize(this_block_size_with_upsampling + 1,
                                   jmax + 1);
         out_dem_vertices_array.fill(std::numeric_limits<float>::quiet_NaN());
     }
 
-    isce3::core::Matrix<float> out_geo_nlooks_array;
+    MatrixPtr out_geo_nlooks_ptr = std::make_unique<isce3::core::Matrix<float>>();
+    isce3::core::Matrix<float>& out_geo_nlooks_array = *out_geo_nlooks_ptr;
     if (out_geo_nlooks != nullptr) {
         out_geo_nlooks_array.resize(this_block_size, _geoGridWidth);
         out_geo_nlooks_array.fill(std::numeric_limits<float>::quiet_NaN());
     }
 
-    isce3::core::Matrix<float> out_geo_rtc_array;
+    MatrixPtr out_geo_rtc_ptr = std::make_unique<isce3::core::Matrix<float>>();
+    isce3::core::Matrix<float>& out_geo_rtc_array = *out_geo_rtc_ptr;
     if (out_geo_rtc != nullptr) {
         out_geo_rtc_array.resize(this_block_size, _geoGridWidth);
         out_geo_rtc_array.fill(std::numeric_limits<float>::quiet_NaN());
@@ -1015,12 +1177,9 @@ void Geocode<T>::_RunBlock(
     const double margin_x = std::abs(_geoGridSpacingX) * 10;
     const double margin_y = std::abs(_geoGridSpacingY) * 10;
 
-#pragma omp critical
-    {
-        dem_interp_block.loadDEM(dem_raster, minX - margin_x, maxX + margin_x,
-                                 std::min(minY, maxY) - margin_y,
-                                 std::max(minY, maxY) + margin_y);
-    }
+    dem_interp_block.loadDEM(dem_raster, minX - margin_x, maxX + margin_x,
+                             std::min(minY, maxY) - margin_y,
+                             std::max(minY, maxY) + margin_y);
 
     /*
     Example:
@@ -1182,7 +1341,6 @@ void Geocode<T>::_RunBlock(
                 info << "converting band to output dtype..." << pyre::journal::endl;
                 isce3::core::Matrix<T> radar_data_out( 
                     radar_grid_block.length(), radar_grid_block.width());
-                #pragma omp critical
                 input_raster.getBlock(radar_data_out.data(), offset_x,
                                       offset_y, radar_grid_block.width(),
                                       radar_grid_block.length(), band + 1);
@@ -1195,7 +1353,6 @@ void Geocode<T>::_RunBlock(
                                 radar_data_value;
                     }
             } else {
-                #pragma omp critical
                 input_raster.getBlock(rdrDataBlock[band].get()->data(),
                                       offset_x, offset_y,
                                       radar_grid_block.width(),
@@ -1537,48 +1694,36 @@ void Geocode<T>::_RunBlock(
                     geoDataBlock[band].get()->operator()(i, jj) =
                             std::numeric_limits<T_out>::quiet_NaN();
             }    
-        #pragma omp critical
-        {
-            output_raster.setBlock(geoDataBlock[band].get()->data(), 0,
-                                   block * block_size, _geoGridWidth,
-                                   this_block_size, band + 1);
-        }
+        write_queue.setBlock(output_raster, std::move(geoDataBlock[band]), 0,
+                             block * block_size, _geoGridWidth,
+                             this_block_size, band + 1);
     }
 
-    if (out_geo_vertices != nullptr)
-    #pragma omp critical
-    {
-        out_geo_vertices->setBlock(out_geo_vertices_a.data(), 0,
-                                   block * block_size_with_upsampling, jmax + 1,
-                                   this_block_size_with_upsampling + 1, 1);
-        out_geo_vertices->setBlock(out_geo_vertices_r.data(), 0,
-                                   block * block_size_with_upsampling, jmax + 1,
-                                   this_block_size_with_upsampling + 1, 2);
+    if (out_geo_vertices != nullptr) {
+        write_queue.setBlock(*out_geo_vertices,
+                             std::move(out_geo_vertices_a_ptr), 0,
+                             block * block_size_with_upsampling, jmax + 1,
+                             this_block_size_with_upsampling + 1, 1);
+        write_queue.setBlock(*out_geo_vertices,
+                             std::move(out_geo_vertices_r_ptr), 0,
+                             block * block_size_with_upsampling, jmax + 1,
+                             this_block_size_with_upsampling + 1, 2);
     }
 
     if (out_dem_vertices != nullptr)
-    #pragma omp critical
-    {
-        out_dem_vertices->setBlock(out_dem_vertices_array.data(), 0,
-                                   block * block_size_with_upsampling, jmax + 1,
-                                   this_block_size_with_upsampling + 1, 1);
-    }
-
+        write_queue.setBlock(*out_dem_vertices, std::move(out_dem_vertices_ptr),
+                             0, block * block_size_with_upsampling, jmax + 1,
+                             this_block_size_with_upsampling + 1, 1);
 
     if (out_geo_nlooks != nullptr)
-    #pragma omp critical
-    {
-        out_geo_nlooks->setBlock(out_geo_nlooks_array.data(), 0,
-                                 block * block_size, _geoGridWidth,
-                                 this_block_size, 1);
-    }
+        write_queue.setBlock(*out_geo_nlooks, std::move(out_geo_nlooks_ptr), 0,
+                             block * block_size, _geoGridWidth,
+                             this_block_size, 1);
 
     if (out_geo_rtc != nullptr)
-    #pragma omp critical
-    {
-        out_geo_rtc->setBlock(out_geo_rtc_array.data(), 0, block * block_size,
-                              _geoGridWidth, this_block_size, 1);
-    }
+        write_queue.setBlock(*out_geo_rtc, std::move(out_geo_rtc_ptr), 0,
+                             block * block_size, _geoGridWidth,
+                             this_block_size, 1);
 }
 
 template class Geocode<float>;
@@ -27,6 +27,12 @@
 
 #include "geometry.h"
 
+#include <memory>
+
+namespace isce3 { namespace geocode {
+class Geo2rdrCache;
+}}
+
 namespace isce3 {
 namespace geometry {
 
@@ -118,6 +124,11 @@ public:
                     isce3::core::dataInterpMethod::BIQUINTIC_METHOD);
 
     /** Geocode using the interpolation algorithm.
+     *
+     * The geogrid is processed in blocks of linesPerBlock lines. Reading the
+     * DEM and input data for upcoming blocks and writing finished blocks are
+     * overlapped with geo2rdr and interpolation of the current block (see
+     * isce3::core::BlockPipeline).
      *
      * @param[in]  radar_grid          Radar grid
      * @param[in]  input_raster        Input raster
@@ -242,6 +253,30 @@ public:
         _radarBlockMargin = radarBlockMargin;
     }
 
+    /** Set deterministic mode for area-projection geocoding. When enabled,
+     * the geogrid is split into blocks of fixed length and RTC area factors
+     * are accumulated in per-block tiles, so that the output is bitwise
+     * reproducible for any number of threads. */
+    void deterministic(bool deterministic) { _deterministic = deterministic; }
+
+    /** Get deterministic mode flag */
+    bool deterministic() const { return _deterministic; }
+
+    /** Set precomputed radar coordinates of the geogrid for interpolation
+     * geocoding, which then skips the DEM and geo2rdr computations. The cache
+     * must cover the geogrid with a pixel offset of 0.5 (pixel centers) and
+     * have been computed with the same orbit, Doppler, ellipsoid, wavelength,
+     * look side and DEM. Pass nullptr to go back to computing them. */
+    void geo2rdrCache(
+            std::shared_ptr<const isce3::geocode::Geo2rdrCache> geo2rdrCache) {
+        _geo2rdrCache = geo2rdrCache;
+    }
+
+    /** Get precomputed radar coordinates of the geogrid */
+    std::shared_ptr<const isce3::geocode::Geo2rdrCache> geo2rdrCache() const {
+        return _geo2rdrCache;
+    }
+
     // start X position for the output geogrid
     double geoGridStartX() const { return _geoGridStartX; }
 
@@ -288,6 +323,7 @@ private:
               isce3::core::ProjectionBase* proj,
               isce3::core::Matrix<float>& rtc_area,
               isce3::io::Raster& input_raster, isce3::io::Raster& output_raster,
+              isce3::io::WriteQueue& write_queue,
               isce3::geometry::geocodeOutputMode output_mode,
               float rtc_min_value, double abs_cal_factor, float clip_min,
               float clip_max, float min_nlooks, float radar_grid_nlooks,
@@ -303,6 +339,22 @@ private:
                   double x, double y, double& azimuthTime, double& slantRange,
                   DEMInterpolator& demInterp, isce3::core::ProjectionBase* proj);
 
+    /** Compute the radar coordinates of a block of the geocoded grid.
+     *
+     * Pixels for which geo2rdr does not converge or that fall outside the
+     * radar grid are left unset in radarX and radarY. The radar-grid extents
+     * of the valid pixels are returned in azimuthFirstLine, azimuthLastLine,
+     * rangeFirstPixel and rangeLastPixel (first > last if there are none).
+     */
+    void _geo2rdrBlock(const isce3::product::RadarGridParameters& radar_grid,
+                       int lineStart, int geoBlockLength,
+                       DEMInterpolator& demInterp,
+                       isce3::core::ProjectionBase* proj,
+                       std::valarray<double>& radarX,
+                       std::valarray<double>& radarY, size_t& azimuthFirstLine,
+                       size_t& azimuthLastLine, size_t& rangeFirstPixel,
+                       size_t& rangeLastPixel);
+
     template<class T_out>
     void
     _interpolate(isce3::core::Matrix<T_out>& rdrDataBlock,
@@ -319,6 +371,7 @@ private:
     double _threshold;
     int _numiter;
     size_t _linesPerBlock = 1000;
+    bool _deterministic = false;
 
     // radar grids parameters
     isce3::core::LUT2d<double> _doppler;
@@ -354,6 +407,9 @@ private:
     // interpolator
     isce3::core::dataInterpMethod _interp_method =
             isce3::core::dataInterpMethod::BIQUINTIC_METHOD;
+
+    // precomputed radar coordinates of the geogrid
+    std::shared_ptr<const isce3::geocode::Geo2rdrCache> _geo2rdrCache;
 };
 
 std::vector<float> getGeoAreaElementMean(
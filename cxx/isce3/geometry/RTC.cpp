@@ -3,6 +3,7 @@
 
 #include "RTC.h"
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <cstdio>
@@ -25,6 +26,7 @@
 #include <isce3/product/RadarGridParameters.h>
 #include <isce3/signal/Looks.h>
 #include <string>
+#include <vector>
 
 using isce3::core::cartesian_t;
 using isce3::core::Mat3;
@@ -370,7 +372,8 @@ void facetRTC(const isce3::product::RadarGridParameters& radar_grid,
               float rtc_min_value_db, float radar_grid_nlooks,
               isce3::io::Raster* out_nlooks, rtcMemoryMode rtc_memory_mode,
               isce3::core::dataInterpMethod interp_method, double threshold,
-              int num_iter, double delta_range) {
+              int num_iter, double delta_range,
+              rtcAccumulationMode rtc_accumulation_mode) {
 
     double geotransform[6];
     dem_raster.getGeoTransform(geotransform);
@@ -399,7 +402,8 @@ void facetRTC(const isce3::product::RadarGridParameters& radar_grid,
              x0, dx, geogrid_length, geogrid_width, epsg, input_radiometry,
              rtc_area_mode, rtc_algorithm, geogrid_upsampling, rtc_min_value_db,
              radar_grid_nlooks, nullptr, nullptr, out_nlooks, rtc_memory_mode,
-             interp_method, threshold, num_iter, delta_range);
+             interp_method, threshold, num_iter, delta_range,
+             rtc_accumulation_mode);
 }
 
 void facetRTC(isce3::io::Raster& dem_raster, isce3::io::Raster& output_raster,
@@ -415,7 +419,8 @@ void facetRTC(isce3::io::Raster& dem_raster, isce3::io::Raster& output_raster,
               isce3::io::Raster* out_geo_grid, isce3::io::Raster* out_nlooks,
               rtcMemoryMode rtc_memory_mode,
               isce3::core::dataInterpMethod interp_method, double threshold,
-              int num_iter, double delta_range)
+              int num_iter, double delta_range,
+              rtcAccumulationMode rtc_accumulation_mode)
 {
 
     if (rtc_algorithm == rtcAlgorithm::RTC_AREA_PROJECTION) {
@@ -425,7 +430,7 @@ void facetRTC(isce3::io::Raster& dem_raster, isce3::io::Raster& output_raster,
                 rtc_area_mode, geogrid_upsampling, rtc_min_value_db,
                 radar_grid_nlooks, out_geo_vertices, out_geo_grid, out_nlooks,
                 rtc_memory_mode, interp_method, threshold, num_iter, 
-                delta_range);
+                delta_range, rtc_accumulation_mode);
     } else {
         facetRTCDavidSmall(dem_raster, output_raster, radar_grid, orbit,
                            input_dop, y0, dy, x0, dx, geogrid_length,
@@ -517,14 +522,134 @@ void areaProjIntegrateSegment(double y1, double y2, double x1, double x2,
     }
 }
 
-void _addArea(double area, isce3::core::Matrix<float>& out_array,
-              float radar_grid_nlooks,
-              isce3::core::Matrix<float>& out_nlooks_array, int length,
-              int width, int x_min, int y_min, int size_x, int size_y,
-              isce3::core::Matrix<double>& w_arr, double nlooks,
+/** Radar-grid tile accumulating facet areas (and number of looks) of a
+ * geogrid block. The tile window grows as needed to cover the radar-grid
+ * pixels touched by the block. */
+class AreaTile {
+public:
+    AreaTile() = default;
+
+    AreaTile(int length, int width, bool with_nlooks) :
+        _length(length), _width(width), _with_nlooks(with_nlooks) {}
+
+    /** Grow the tile window to cover [y_min, y_max] x [x_min, x_max],
+     * clipped to the radar grid */
+    void reserve(int y_min, int y_max, int x_min, int x_max)
+    {
+        y_min = std::max(y_min, 0);
+        x_min = std::max(x_min, 0);
+        y_max = std::min(y_max, _length - 1);
+        x_max = std::min(x_max, _width - 1);
+        if (y_min > y_max || x_min > x_max)
+            return;
+        if (_tile_length > 0 && y_min >= _y0 && x_min >= _x0 &&
+            y_max < _y0 + _tile_length && x_max < _x0 + _tile_width)
+            return;
+
+        // grow by a margin in each direction to amortize reallocations
+        int y0 = y_min, y1 = y_max + 1, x0 = x_min, x1 = x_max + 1;
+        if (_tile_length > 0) {
+            const int margin_y = std::max(_tile_length / 2, 16);
+            const int margin_x = std::max(_tile_width / 2, 16);
+            if (y0 < _y0)
+                y0 = std::max(std::min(y0, _y0 - margin_y), 0);
+            if (y1 > _y0 + _tile_length)
+                y1 = std::min(std::max(y1, _y0 + _tile_length + margin_y),
+                              _length);
+            if (x0 < _x0)
+                x0 = std::max(std::min(x0, _x0 - margin_x), 0);
+            if (x1 > _x0 + _tile_width)
+                x1 = std::min(std::max(x1, _x0 + _tile_width + margin_x),
+                              _width);
+            y0 = std::min(y0, _y0);
+            x0 = std::min(x0, _x0);
+            y1 = std::max(y1, _y0 + _tile_length);
+            x1 = std::max(x1, _x0 + _tile_width);
+        }
+        _resize(y0, y1, x0, x1);
+    }
+
+    /** Add contributions to radar-grid pixel (y, x) within the window */
+    void add(int y, int x, float area, float nlooks)
+    {
+        const size_t k = _index(y - _y0, x - _x0);
+        _area[k] += area;
+        if (_with_nlooks)
+            _nlooks[k] += nlooks;
+    }
+
+    /** Add the contents of another tile into this one */
+    void merge(const AreaTile& other)
+    {
+        if (other._tile_length == 0)
+            return;
+        reserve(other._y0, other._y0 + other._tile_length - 1, other._x0,
+                other._x0 + other._tile_width - 1);
+        for (int i = 0; i < other._tile_length; ++i)
+            for (int j = 0; j < other._tile_width; ++j) {
+                const size_t k = _index(other._y0 + i - _y0,
+                                        other._x0 + j - _x0);
+                const size_t k_other = other._index(i, j);
+                _area[k] += other._area[k_other];
+                if (_with_nlooks)
+                    _nlooks[k] += other._nlooks[k_other];
+            }
+    }
+
+    /** Add the tile into full radar-grid arrays */
+    void addTo(isce3::core::Matrix<float>& out_array,
+               isce3::core::Matrix<float>& out_nlooks_array) const
+    {
+        for (int i = 0; i < _tile_length; ++i)
+            for (int j = 0; j < _tile_width; ++j) {
+                out_array(_y0 + i, _x0 + j) += _area[_index(i, j)];
+                if (_with_nlooks)
+                    out_nlooks_array(_y0 + i, _x0 + j) +=
+                            _nlooks[_index(i, j)];
+            }
+    }
+
+private:
+    size_t _index(int i, int j) const
+    {
+        return static_cast<size_t>(i) * _tile_width + j;
+    }
+
+    void _resize(int y0, int y1, int x0, int x1)
+    {
+        const size_t new_width = x1 - x0;
+        const size_t new_size = (y1 - y0) * new_width;
+        std::vector<float> area(new_size, 0.f);
+        std::vector<float> nlooks(_with_nlooks ? new_size : 0, 0.f);
+        for (int i = 0; i < _tile_length; ++i)
+            for (int j = 0; j < _tile_width; ++j) {
+                const size_t k = (_y0 - y0 + i) * new_width + (_x0 - x0 + j);
+                area[k] = _area[_index(i, j)];
+                if (_with_nlooks)
+                    nlooks[k] = _nlooks[_index(i, j)];
+            }
+        _area = std::move(area);
+        _nlooks = std::move(nlooks);
+        _y0 = y0;
+        _x0 = x0;
+        _tile_length = y1 - y0;
+        _tile_width = x1 - x0;
+    }
+
+    int _length = 0, _width = 0;
+    bool _with_nlooks = false;
+    int _y0 = 0, _x0 = 0, _tile_length = 0, _tile_width = 0;
+    std::vector<float> _area, _nlooks;
+};
+
+template<class AddFn>
+void _addArea(double area, float radar_grid_nlooks, bool compute_nlooks,
+              int length, int width, int x_min, int y_min, int size_x,
+              int size_y, isce3::core::Matrix<double>& w_arr, double nlooks,
               isce3::core::Matrix<double>& w_arr_out, double& nlooks_out,
               double x_center, double x_left, double x_right, double y_center,
-              double y_left, double y_right, int plane_orientation) {
+              double y_left, double y_right, int plane_orientation,
+              AddFn&& add_fn) {
     areaProjIntegrateSegment(y_left, y_right, x_left, x_right, size_y, size_x,
                              w_arr, nlooks, plane_orientation);
 
@@ -542,14 +667,11 @@ void _addArea(double area, isce3::core::Matrix<float>& out_array,
             int x = jj + x_min;
             if (x < 0 || y < 0 || y >= length || x >= width)
                 continue;
-            if (out_nlooks_array.data() != nullptr) {
-                const auto out_nlooks = radar_grid_nlooks * std::abs(w * (nlooks - nlooks_out));
-                _Pragma("omp atomic")
-                out_nlooks_array(y, x) += out_nlooks;
-            }
+            float out_nlooks = 0;
+            if (compute_nlooks)
+                out_nlooks = radar_grid_nlooks * std::abs(w * (nlooks - nlooks_out));
             w /= nlooks - nlooks_out;
-            _Pragma("omp atomic")
-            out_array(y, x) += w * area;
+            add_fn(y, x, w * area, out_nlooks);
         }
 }
 
@@ -862,10 +984,27 @@ void _RunBlock(const int jmax, int block_size, int block_size_with_upsampling,
                double delta_range, isce3::core::Matrix<float>& out_array,
                isce3::core::Matrix<float>& out_nlooks_array,
                isce3::core::ProjectionBase* proj, rtcAreaMode rtc_area_mode,
-               rtcInputRadiometry input_radiometry, float radar_grid_nlooks) {
+               rtcInputRadiometry input_radiometry, float radar_grid_nlooks,
+               AreaTile* area_tile) {
 
     auto side = radar_grid.lookSide();
 
+    // Accumulate areas into the block's own tile if provided, otherwise
+    // directly into the output arrays
+    const bool compute_nlooks = (out_nlooks_array.data() != nullptr);
+    auto add_area = [&](int y, int x, float area, float nlooks) {
+        if (area_tile != nullptr) {
+            area_tile->add(y, x, area, nlooks);
+            return;
+        }
+        if (compute_nlooks) {
+            _Pragma("omp atomic")
+            out_nlooks_array(y, x) += nlooks;
+        }
+        _Pragma("omp atomic")
+        out_array(y, x) += area;
+    };
+
     int this_block_size = block_size;
     if ((block + 1) * block_size > geogrid_length)
         this_block_size = geogrid_length % block_size;
@@ -1154,6 +1293,8 @@ void _RunBlock(const int jmax, int block_size, int block_size_with_upsampling,
             // Prepare call to _addArea()
             int size_x = x_max - x_min + 1;
             int size_y = y_max - y_min + 1;
+            if (area_tile != nullptr)
+                area_tile->reserve(y_min, y_max, x_min, x_max);
             isce3::core::Matrix<double> w_arr_1(size_y, size_x);
             isce3::core::Matrix<double> w_arr_2(size_y, size_x);
             w_arr_1.fill(0);
@@ -1186,40 +1327,44 @@ void _RunBlock(const int jmax, int block_size, int block_size_with_upsampling,
             double area = computeFacet(xyz_c, xyz00, xyz01, lookXYZ, p00_c,
                                        p01_c, divisor, clockwise_direction);
             // Add area to output grid
-            _addArea(area, out_array, radar_grid_nlooks, out_nlooks_array,
+            _addArea(area, radar_grid_nlooks, compute_nlooks,
                      radar_grid.length(), radar_grid.width(), x_min, y_min,
                      size_x, size_y, w_arr_1, nlooks_1, w_arr_2, nlooks_2, x_c,
-                     x00, x01, y_c, y00, y01, plane_orientation);
+                     x00, x01, y_c, y00, y01, plane_orientation,
+                     add_area);
 
             // Compute the area (second facet)
             area = computeFacet(xyz_c, xyz01, xyz11, lookXYZ, p01_c, p11_c,
                                 divisor, clockwise_direction);
 
             // Add area to output grid
-            _addArea(area, out_array, radar_grid_nlooks, out_nlooks_array,
+            _addArea(area, radar_grid_nlooks, compute_nlooks,
                      radar_grid.length(), radar_grid.width(), x_min, y_min,
                      size_x, size_y, w_arr_2, nlooks_2, w_arr_1, nlooks_1, x_c,
-                     x01, x11, y_c, y01, y11, plane_orientation);
+                     x01, x11, y_c, y01, y11, plane_orientation,
+                     add_area);
 
             // Compute the area (third facet)
             area = computeFacet(xyz_c, xyz11, xyz10, lookXYZ, p11_c, p10_c,
                                 divisor, clockwise_direction);
 
             // Add area to output grid
-            _addArea(area, out_array, radar_grid_nlooks, out_nlooks_array,
+            _addArea(area, radar_grid_nlooks, compute_nlooks,
                      radar_grid.length(), radar_grid.width(), x_min, y_min,
                      size_x, size_y, w_arr_1, nlooks_1, w_arr_2, nlooks_2, x_c,
-                     x11, x10, y_c, y11, y10, plane_orientation);
+                     x11, x10, y_c, y11, y10, plane_orientation,
+                     add_area);
 
             // Compute the area (fourth facet)
             area = computeFacet(xyz_c, xyz10, xyz00, lookXYZ, p10_c, p00_c,
                                 divisor, clockwise_direction);
 
             // Add area to output grid
-            _addArea(area, out_array, radar_grid_nlooks, out_nlooks_array,
+            _addArea(area, radar_grid_nlooks, compute_nlooks,
                      radar_grid.length(), radar_grid.width(), x_min, y_min,
                      size_x, size_y, w_arr_2, nlooks_2, w_arr_1, nlooks_1, x_c,
-                     x10, x00, y_c, y10, y00, plane_orientation);
+                     x10, x00, y_c, y10, y00, plane_orientation,
+                     add_area);
         }
     }
 
@@ -1259,7 +1404,8 @@ void facetRTCAreaProj(
         isce3::io::Raster* out_geo_vertices, isce3::io::Raster* out_geo_grid,
         isce3::io::Raster* out_nlooks, rtcMemoryMode rtc_memory_mode,
         isce3::core::dataInterpMethod interp_method, double threshold,
-        int num_iter, double delta_range) {
+        int num_iter, double delta_range,
+        rtcAccumulationMode rtc_accumulation_mode) {
     /*
       Description of the area projection algorithm can be found in Geocode.cpp
     */
@@ -1316,6 +1462,15 @@ void facetRTCAreaProj(
         nblocks = 1;
         block_size_with_upsampling = imax;
         block_size = geogrid_length;
+    } else if (rtc_accumulation_mode == rtcAccumulationMode::RTC_ACCUMULATE_TILES) {
+        // use a fixed block length so that the partial sums (and therefore
+        // the results) do not depend on the number of threads
+        const int tiles_block_length =
+                isce3::core::AREA_PROJECTION_DETERMINISTIC_BLOCK_LENGTH *
+                std::max(1, static_cast<int>(geogrid_upsampling));
+        nblocks = areaProjGetNBlocks(imax, &info, geogrid_upsampling,
+                                     &block_size_with_upsampling, &block_size,
+                                     tiles_block_length, tiles_block_length);
     } else {
         nblocks = areaProjGetNBlocks(imax, &info, geogrid_upsampling,
                                      &block_size_with_upsampling, &block_size,
@@ -1326,15 +1481,37 @@ void facetRTCAreaProj(
     info << "block size (with upsampling): " << block_size_with_upsampling
          << pyre::journal::endl;
 
+    // One radar-grid tile per geogrid block
+    std::vector<AreaTile> area_tiles;
+    if (rtc_accumulation_mode == rtcAccumulationMode::RTC_ACCUMULATE_TILES)
+        area_tiles.resize(nblocks,
+                          AreaTile(radar_grid.length(), radar_grid.width(),
+                                   out_nlooks != nullptr));
+
 #pragma omp parallel for schedule(dynamic)
     for (int block = 0; block < nblocks; ++block) {
+        AreaTile* area_tile =
+                area_tiles.empty() ? nullptr : &area_tiles[block];
         _RunBlock(jmax, block_size, block_size_with_upsampling, block, numdone,
                   progress_block, geogrid_upsampling, interp_method, dem_raster,
                   out_geo_vertices, out_geo_grid, start, pixazm, dr, r0, xbound,
                   ybound, y0, dy, x0, dx, geogrid_length, geogrid_width,
                   radar_grid, input_dop, ellipsoid, orbit, threshold, num_iter,
                   delta_range, out_array, out_nlooks_array, proj.get(),
-                  rtc_area_mode, input_radiometry, radar_grid_nlooks);
+                  rtc_area_mode, input_radiometry, radar_grid_nlooks,
+                  area_tile);
+    }
+
+    // Merge block tiles with a pairwise tree reduction in block order
+    if (!area_tiles.empty()) {
+        for (int step = 1; step < nblocks; step *= 2) {
+#pragma omp parallel for schedule(dynamic)
+            for (int block = 0; block < nblocks - step; block += 2 * step) {
+                area_tiles[block].merge(area_tiles[block + step]);
+                area_tiles[block + step] = AreaTile();
+            }
+        }
+        area_tiles[0].addTo(out_array, out_nlooks_array);
     }
 
     printf("\rRTC progress: 100%%\n");
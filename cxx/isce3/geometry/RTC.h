@@ -35,6 +35,17 @@ enum rtcAreaMode { AREA = 0, AREA_FACTOR = 1 };
  * RTC_AREA_PROJECTION) */
 enum rtcAlgorithm { RTC_DAVID_SMALL = 0, RTC_AREA_PROJECTION = 1 };
 
+/**Enumeration type to select how the area-projection algorithm accumulates
+ * facet areas over the radar grid. RTC_ACCUMULATE_ATOMIC adds directly into
+ * the output arrays with atomic updates. RTC_ACCUMULATE_TILES accumulates
+ * each geogrid block into its own radar-grid tile and merges the tiles with
+ * a tree reduction, which avoids contention between threads and gives
+ * results that do not depend on the number of threads. Every block tile
+ * (covering the radar-grid extent of the block, plus the number of looks if
+ * requested) is held in memory until the reduction, so peak memory grows
+ * with the number of geogrid blocks. */
+enum rtcAccumulationMode { RTC_ACCUMULATE_ATOMIC = 0, RTC_ACCUMULATE_TILES = 1 };
+
 /** Apply radiometric terrain correction (RTC) over an input raster
  *
  * @param[in]  radarGrid           Radar Grid
@@ -135,6 +146,8 @@ void facetRTC(
  * @param[in] num_iter             Maximum number of Newton-Raphson iterations
  * @param[in] delta_range          Step size used for computing derivative of
  * doppler
+ * @param[in] rtc_accumulation_mode Area accumulation mode of the area
+ * projection algorithm
  * */
 void facetRTC(
         const isce3::product::RadarGridParameters& radarGrid,
@@ -150,7 +163,9 @@ void facetRTC(
         rtcMemoryMode rtc_memory_mode = rtcMemoryMode::RTC_AUTO,
         isce3::core::dataInterpMethod interp_method =
                 isce3::core::dataInterpMethod::BIQUINTIC_METHOD,
-        double threshold = 1e-4, int num_iter = 100, double delta_range = 1e-4);
+        double threshold = 1e-4, int num_iter = 100, double delta_range = 1e-4,
+        rtcAccumulationMode rtc_accumulation_mode =
+                rtcAccumulationMode::RTC_ACCUMULATE_ATOMIC);
 
 /** Generate radiometric terrain correction (RTC) area or area factor
  *
@@ -189,6 +204,8 @@ void facetRTC(
  * @param[in] num_iter             Maximum number of Newton-Raphson iterations
  * @param[in] delta_range          Step size used for computing derivative of
  * doppler
+ * @param[in] rtc_accumulation_mode Area accumulation mode of the area
+ * projection algorithm
  * */
 void facetRTC(
         isce3::io::Raster& dem_raster, isce3::io::Raster& output_raster,
@@ -209,7 +226,9 @@ void facetRTC(
         rtcMemoryMode rtc_memory_mode = rtcMemoryMode::RTC_AUTO,
         isce3::core::dataInterpMethod interp_method =
                 isce3::core::dataInterpMethod::BIQUINTIC_METHOD,
-        double threshold = 1e-4, int num_iter = 100, double delta_range = 1e-4);
+        double threshold = 1e-4, int num_iter = 100, double delta_range = 1e-4,
+        rtcAccumulationMode rtc_accumulation_mode =
+                rtcAccumulationMode::RTC_ACCUMULATE_ATOMIC);
 
 /** Generate radiometric terrain correction (RTC) area or area factor using the
  * David Small algorithm
@@ -283,6 +302,8 @@ void facetRTCDavidSmall(
  * @param[in] num_iter             Maximum number of Newton-Raphson iterations
  * @param[in] delta_range          Step size used for computing derivative of
  * doppler
+ * @param[in] rtc_accumulation_mode Area accumulation mode of the area
+ * projection algorithm
  * */
 void facetRTCAreaProj(
         isce3::io::Raster& dem, isce3::io::Raster& output_raster,
@@ -302,7 +323,9 @@ void facetRTCAreaProj(
         rtcMemoryMode rtc_memory_mode = rtcMemoryMode::RTC_AUTO,
         isce3::core::dataInterpMethod interp_method =
                 isce3::core::dataInterpMethod::BIQUINTIC_METHOD,
-        double threshold = 1e-4, int num_iter = 100, double delta_range = 1e-4);
+        double threshold = 1e-4, int num_iter = 100, double delta_range = 1e-4,
+        rtcAccumulationMode rtc_accumulation_mode =
+                rtcAccumulationMode::RTC_ACCUMULATE_ATOMIC);
 
 void areaProjIntegrateSegment(double y1, double y2, double x1, double x2,
                               int length, int width,
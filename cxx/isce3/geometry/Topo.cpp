@@ -13,11 +13,13 @@
 #include <cstdlib>
 #include <fstream>
 #include <future>
+#include <memory>
 #include <valarray>
 #include <vector>
 
 // isce3::core
 #include <isce3/core/Basis.h>
+#include <isce3/core/BlockPipeline.h>
 #include <isce3/core/Constants.h>
 #include <isce3/core/Pixel.h>
 #include <isce3/core/DenseMatrix.h>
@@ -45,6 +47,7 @@ Topo(const isce3::product::Product & product,
 {
     // Copy orbit and doppler
     _orbit = product.metadata().orbit();
+    _ephemeris = isce3::core::EphemerisTable(_orbit);
     if (nativeDoppler) {
         _doppler = product.metadata().procInfo().dopplerCentroid(frequency);
     }
@@ -129,17 +132,24 @@ void isce3::geometry::Topo::_topo(T& dem, Raster& xRaster, Raster& yRaster,
 
 void isce3::geometry::Topo::
 topo(Raster & demRaster, TopoLayers & layers)
+{
+    _topoBlocks(layers, &demRaster, nullptr);
+}
+
+void isce3::geometry::Topo::topo(DEMInterpolator& demInterp,
+                                TopoLayers& layers) {
+    _topoBlocks(layers, nullptr, &demInterp);
+}
+
+void isce3::geometry::Topo::
+_topoBlocks(TopoLayers & layers, Raster * demRaster, DEMInterpolator * demInterp)
 {
     // Create reusable pyre::journal channels
-    pyre::journal::warning_t warning("isce.geometry.Topo");
     pyre::journal::info_t info("isce.geometry.Topo");
 
     // Create and start a timer
     auto timerStart = std::chrono::steady_clock::now();
 
-    // Create a DEM interpolator
-    DEMInterpolator demInterp(-500.0, _demMethod);
-
     // Compute number of blocks needed to process image
     size_t nBlocks = _radarGrid.length() / _linesPerBlock;
     if ((_radarGrid.length() % _linesPerBlock) != 0)
@@ -150,99 +160,102 @@ topo(Raster & demRaster, TopoLayers & layers)
     const double endingRange = _radarGrid.endingRange();
     const double midRange = _radarGrid.midRange();
 
+    // A fixed DEM interpolator only needs its statistics computed once
+    if (demRaster == nullptr) {
+        float demmax, dem_avg;
+        demInterp->computeHeightStats(demmax, dem_avg, info);
+    }
+
+    // Data of a block in flight
+    struct TopoBlock {
+        size_t lineStart;
+        TopoLayers * layers;
+        DEMInterpolator * demInterp;
+        std::vector<Vec3> satPosition;
+    };
+    std::vector<TopoBlock> slots;
+
     // Loop over blocks
     size_t totalconv = 0;
-    for (size_t block = 0; block < nBlocks; ++block) {
+    isce3::core::BlockPipeline pipeline;
+
+    // Load DEM subset and run rdr2geo for all pixels of the block
+    pipeline.compute([&](int block, int slot) {
+        TopoBlock & b = slots[slot];
 
         // Get block extents
-        size_t lineStart, blockLength;
-        lineStart = block * _linesPerBlock;
-        if (block == (nBlocks - 1)) {
-            blockLength = _radarGrid.length() - lineStart;
+        b.lineStart = block * _linesPerBlock;
+        size_t blockLength;
+        if (static_cast<size_t>(block) == (nBlocks - 1)) {
+            blockLength = _radarGrid.length() - b.lineStart;
         } else {
             blockLength = _linesPerBlock;
         }
 
         // Diagnostics
-        const double tblock = _radarGrid.sensingTime(lineStart);
+        const double tblock = _radarGrid.sensingTime(b.lineStart);
         info << "Processing block: " << block << " " << pyre::journal::newline
-             << "  - line start: " << lineStart << pyre::journal::newline
-             << "  - line end  : " << lineStart + blockLength << pyre::journal::newline
-             << "  - dopplers near mid far: "
+             << "  - line start: " << b.lineStart << pyre::journal::newline
+             << "  - line end  : " << b.lineStart + blockLength
+             << pyre::journal::newline << "  - dopplers near mid far: "
              << _doppler.eval(tblock, startingRange) << " "
              << _doppler.eval(tblock, midRange) << " "
              << _doppler.eval(tblock, endingRange) << " "
              << pyre::journal::endl;
 
-        // Load DEM subset for SLC image block
-        computeDEMBounds(demRaster, demInterp, lineStart, blockLength);
+        if (demRaster != nullptr) {
+            // Load DEM subset for SLC image block
+            computeDEMBounds(*demRaster, *b.demInterp, b.lineStart, blockLength);
 
-        // Compute max and mean DEM height for the subset
-        float demmax, dem_avg;
-        demInterp.computeHeightStats(demmax, dem_avg, info);
-        // Reset reference height for DEMInterpolator
-        demInterp.refHeight(dem_avg);
+            // Compute max and mean DEM height for the subset
+            float demmax, dem_avg;
+            b.demInterp->computeHeightStats(demmax, dem_avg, info);
+            // Reset reference height for DEMInterpolator
+            b.demInterp->refHeight(dem_avg);
+        }
 
         // Set output block sizes in layers
-        layers.setBlockSize(blockLength, _radarGrid.width());
-
-        // Allocate vector for storing satellite position for each line
-        std::vector<Vec3> satPosition(blockLength);
+        b.layers->setBlockSize(blockLength, _radarGrid.width());
 
-        // For each line in block
-        double tline;
-        for (size_t blockLine = 0; blockLine < blockLength; ++blockLine) {
-
-            // Global line index
-            size_t line = lineStart + blockLine;
-
-            // Initialize orbital data for this azimuth line
-            Basis TCNbasis;
-            Vec3 pos, vel;
-            _initAzimuthLine(line, tline, pos, vel, TCNbasis);
-            satPosition[blockLine] = pos;
-
-            // Compute velocity magnitude
-            const double satVmag = vel.norm();
+        totalconv += _topoBlock(b.lineStart, *b.layers, *b.demInterp,
+                                b.satPosition);
+    });
 
-            // For each slant range bin
-            #pragma omp parallel for reduction(+:totalconv)
-            for (size_t rbin = 0; rbin < _radarGrid.width(); ++rbin) {
-
-                // Get current slant range
-                const double rng = _radarGrid.slantRange(rbin);
-
-                // Get current Doppler value
-                const double dopfact = (0.5 * _radarGrid.wavelength()
-                                     * (_doppler.eval(tline, rng) / satVmag)) * rng;
-
-                // Store slant range bin data in Pixel
-                Pixel pixel(rng, dopfact, rbin);
-
-                // Initialize LLH to middle of input DEM and average height
-                Vec3 llh = demInterp.midLonLat();
-
-                // Perform rdr->geo iterations
-                int geostat = rdr2geo(
-                    pixel, TCNbasis, pos, vel, _ellipsoid, demInterp, llh,
-                    _lookSide, _threshold, _numiter, _extraiter);
-                totalconv += geostat;
-
-                // Save data in output arrays
-                _setOutputTopoLayers(llh, layers, blockLine, pixel, pos, vel, TCNbasis, demInterp);
-
-            } // end OMP for loop pixels in block
-        } // end for loop lines in block
-
-        // Compute layover/shadow masks for the block
+    // Compute layover/shadow masks and write out the block, overlapped with
+    // rdr2geo of the next block
+    pipeline.io([&](int, int slot) {
+        TopoBlock & b = slots[slot];
         if (_computeMask) {
-            setLayoverShadow(layers, demInterp, satPosition);
+            setLayoverShadow(*b.layers, *b.demInterp, b.satPosition);
+        }
+        b.layers->writeData(0, b.lineStart);
+    });
+
+    // Each slot needs its own layers buffers (sharing the output rasters) and,
+    // when subsetting a DEM raster, its own DEM interpolator
+    std::vector<std::unique_ptr<TopoLayers>> slotLayers;
+    std::vector<std::unique_ptr<DEMInterpolator>> slotDEMs;
+    slots.resize(pipeline.numSlots());
+    for (size_t slot = 0; slot < slots.size(); ++slot) {
+        TopoBlock & b = slots[slot];
+        if (slot == 0) {
+            b.layers = &layers;
+        } else {
+            slotLayers.push_back(std::make_unique<TopoLayers>());
+            slotLayers.back()->setRasters(layers);
+            b.layers = slotLayers.back().get();
         }
 
-        // Write out block of data for all topo layers
-        layers.writeData(0, lineStart);
+        if (demRaster != nullptr) {
+            slotDEMs.push_back(
+                    std::make_unique<DEMInterpolator>(-500.0, _demMethod));
+            b.demInterp = slotDEMs.back().get();
+        } else {
+            b.demInterp = demInterp;
+        }
+    }
 
-    } // end for loop blocks
+    pipeline.run(nBlocks);
 
     // Print out convergence statistics
     info << "Total convergence: " << totalconv << " out of "
@@ -256,128 +269,92 @@ topo(Raster & demRaster, TopoLayers & layers)
          << pyre::journal::newline;
 }
 
-void isce3::geometry::Topo::topo(DEMInterpolator& demInterp,
-                                TopoLayers& layers) {
-    // Create reusable pyre::journal channels
-    pyre::journal::warning_t warning("isce.geometry.Topo");
-    pyre::journal::info_t info("isce.geometry.Topo");
-
-    // Create and start a timer
-    auto timerStart = std::chrono::steady_clock::now();
-
-    // Compute number of blocks needed to process image
-    size_t nBlocks = _radarGrid.length() / _linesPerBlock;
-    if ((_radarGrid.length() % _linesPerBlock) != 0)
-        nBlocks += 1;
+size_t isce3::geometry::Topo::
+_topoBlock(size_t lineStart, TopoLayers & layers, DEMInterpolator & demInterp,
+           std::vector<Vec3> & satPosition)
+{
+    const size_t blockLength = layers.length();
+    const size_t width = _radarGrid.width();
+
+    // Orbital data for each azimuth line in block
+    std::vector<double> tlines(blockLength);
+    std::vector<Vec3> satVelocity(blockLength);
+    std::vector<Basis> TCNbases(blockLength);
+    satPosition.resize(blockLength);
+
+    // Interpolate orbit at all azimuth lines
+    for (size_t blockLine = 0; blockLine < blockLength; ++blockLine) {
+        tlines[blockLine] = _radarGrid.sensingTime(lineStart + blockLine);
+    }
+    _ephemeris.interpolate(tlines.data(), blockLength, satPosition.data(),
+                           satVelocity.data(), nullptr,
+                           isce3::core::OrbitInterpBorderMode::FillNaN);
 
-    // Cache range bounds for diagnostics
-    const double startingRange = _radarGrid.startingRange();
-    const double endingRange = _radarGrid.endingRange();
-    const double midRange = _radarGrid.midRange();
+    // Split lines into tiles of up to _tileWidth range bins
+    const size_t tilesPerLine = (width + _tileWidth - 1) / _tileWidth;
+    const size_t nTiles = blockLength * tilesPerLine;
 
-    // Loop over blocks
     size_t totalconv = 0;
-    for (size_t block = 0; block < nBlocks; ++block) {
-
-        // Get block extents
-        size_t lineStart, blockLength;
-        lineStart = block * _linesPerBlock;
-        if (block == (nBlocks - 1)) {
-            blockLength = _radarGrid.length() - lineStart;
-        } else {
-            blockLength = _linesPerBlock;
+    #pragma omp parallel reduction(+:totalconv)
+    {
+        // Get geocentric TCN basis for all azimuth lines
+        #pragma omp for
+        for (size_t blockLine = 0; blockLine < blockLength; ++blockLine) {
+            TCNbases[blockLine] = Basis(satPosition[blockLine],
+                                        satVelocity[blockLine]);
         }
 
-        // Diagnostics
-        const double tblock = _radarGrid.sensingTime(lineStart);
-        info << "Processing block: " << block << " " << pyre::journal::newline
-             << "  - line start: " << lineStart << pyre::journal::newline
-             << "  - line end  : " << lineStart + blockLength
-             << pyre::journal::newline << "  - dopplers near mid far: "
-             << _doppler.eval(tblock, startingRange) << " "
-             << _doppler.eval(tblock, midRange) << " "
-             << _doppler.eval(tblock, endingRange) << " "
-             << pyre::journal::endl;
-
-        // Compute max and mean DEM height for the subset
-        float demmax, dem_avg;
-        demInterp.computeHeightStats(demmax, dem_avg, info);
+        // Per-thread tile buffers
+        std::vector<double> rngs(_tileWidth), dopfacts(_tileWidth);
+        std::vector<double> lons(_tileWidth), lats(_tileWidth), hs(_tileWidth);
 
-        // Set output block sizes in layers
-        layers.setBlockSize(blockLength, _radarGrid.width());
-
-        // Allocate vector for storing satellite position for each line
-        std::vector<Vec3> satPosition(blockLength);
+        // For each (line, range tile) in block
+        #pragma omp for schedule(dynamic)
+        for (size_t tile = 0; tile < nTiles; ++tile) {
 
-        // For each line in block
-        double tline;
-        for (size_t blockLine = 0; blockLine < blockLength; ++blockLine) {
+            const size_t blockLine = tile / tilesPerLine;
+            const size_t rbinStart = (tile % tilesPerLine) * _tileWidth;
+            const size_t rbinEnd = std::min(rbinStart + _tileWidth, width);
 
-            // Global line index
-            size_t line = lineStart + blockLine;
-
-            // Initialize orbital data for this azimuth line
-            Basis TCNbasis;
-            Vec3 pos, vel;
-            _initAzimuthLine(line, tline, pos, vel, TCNbasis);
-            satPosition[blockLine] = pos;
+            // Orbital data for this azimuth line
+            const double tline = tlines[blockLine];
+            Vec3 pos = satPosition[blockLine];
+            Vec3 vel = satVelocity[blockLine];
+            Basis TCNbasis = TCNbases[blockLine];
 
             // Compute velocity magnitude
             const double satVmag = vel.norm();
 
-// For each slant range bin
-#pragma omp parallel for reduction(+ : totalconv)
-            for (size_t rbin = 0; rbin < _radarGrid.width(); ++rbin) {
-
-                // Get current slant range
-                const double rng = _radarGrid.slantRange(rbin);
-
-                // Get current Doppler value
-                const double dopfact = (0.5 * _radarGrid.wavelength() *
-                                        (_doppler.eval(tline, rng) / satVmag)) *
-                                       rng;
-
-                // Store slant range bin data in Pixel
-                Pixel pixel(rng, dopfact, rbin);
-
-                // Initialize LLH to middle of input DEM and average height
-                Vec3 llh = demInterp.midLonLat();
-
-                // Perform rdr->geo iterations
-                int geostat = rdr2geo(pixel, TCNbasis, pos, vel, _ellipsoid,
-                                      demInterp, llh, _lookSide, _threshold,
-                                      _numiter, _extraiter);
-                totalconv += geostat;
+            // Slant range and Doppler factor for each range bin in tile
+            const size_t n = rbinEnd - rbinStart;
+            for (size_t i = 0; i < n; ++i) {
+                rngs[i] = _radarGrid.slantRange(rbinStart + i);
+            }
+            _doppler.eval(tline, rngs.data(), n, dopfacts.data());
+            for (size_t i = 0; i < n; ++i) {
+                dopfacts[i] = (0.5 * _radarGrid.wavelength()
+                            * (dopfacts[i] / satVmag)) * rngs[i];
+            }
 
-                // Save data in output arrays
+            // Initialize heights to average height of input DEM and perform
+            // rdr->geo iterations for all range bins in tile
+            std::fill(hs.begin(), hs.begin() + n, demInterp.midLonLat()[2]);
+            totalconv += rdr2geoBatch(
+                rngs.data(), dopfacts.data(), n, TCNbasis, pos, vel,
+                _ellipsoid, demInterp, lons.data(), lats.data(), hs.data(),
+                _lookSide, _threshold, _numiter, _extraiter);
+
+            // Save data in output arrays
+            for (size_t i = 0; i < n; ++i) {
+                Vec3 llh {lons[i], lats[i], hs[i]};
+                Pixel pixel(rngs[i], dopfacts[i], rbinStart + i);
                 _setOutputTopoLayers(llh, layers, blockLine, pixel, pos, vel,
                                      TCNbasis, demInterp);
+            }
+        } // end OMP for loop tiles in block
+    }
 
-            } // end OMP for loop pixels in block
-        }     // end for loop lines in block
-
-        // Compute layover/shadow masks for the block
-        if (_computeMask) {
-            setLayoverShadow(layers, demInterp, satPosition);
-        }
-
-        // Write out block of data for all topo layers
-        layers.writeData(0, lineStart);
-
-    } // end for loop blocks
-
-    // Print out convergence statistics
-    info << "Total convergence: " << totalconv << " out of "
-         << _radarGrid.size() << pyre::journal::endl;
-
-    // Print out timing information and reset
-    auto timerEnd = std::chrono::steady_clock::now();
-    const double elapsed =
-            1.0e-3 * std::chrono::duration_cast<std::chrono::milliseconds>(
-                             timerEnd - timerStart)
-                             .count();
-    info << "Elapsed processing time: " << elapsed << " sec"
-         << pyre::journal::newline;
+    return totalconv;
 }
 
 /**
@@ -549,8 +526,8 @@ _initAzimuthLine(size_t line, double& tline, Vec3& pos, Vec3& vel, Basis& TCNbas
     tline = _radarGrid.sensingTime(line);
 
     // Get state vector
-    _orbit.interpolate(&pos, &vel, tline,
-                       isce3::core::OrbitInterpBorderMode::FillNaN);
+    _ephemeris.interpolate(&pos, &vel, tline,
+                           isce3::core::OrbitInterpBorderMode::FillNaN);
 
     // Get geocentric TCN basis using satellite basis
     TCNbasis = Basis(pos, vel);
@@ -10,6 +10,7 @@
 
 #include <isce3/core/forward.h>
 #include <isce3/core/Ellipsoid.h>
+#include <isce3/core/EphemerisTable.h>
 #include <isce3/core/LUT2d.h>
 #include <isce3/core/Orbit.h>
 
@@ -149,6 +150,16 @@ public:
      */
     void decimaldegMargin(double deg) { _margin = deg; }
 
+    /**
+     * Set tile width for parallel processing
+     *
+     * Each block is split into tiles of one azimuth line by up to this many
+     * range bins, which are distributed dynamically across threads.
+     *
+     * @param[in] width Number of range bins per tile
+     */
+    void tileWidth(size_t width);
+
     // Get topo processing options
 
     /** Get lookSide used for processing */
@@ -181,6 +192,9 @@ public:
     /** Get margin in decimal degrees */
     double decimaldegMargin() const { return _margin; }
 
+    /** Get number of range bins per processing tile */
+    size_t tileWidth() const { return _tileWidth; }
+
     /** Get read-only reference to RadarGridParameters */
     const isce3::product::RadarGridParameters & radarGridParameters() const { return _radarGrid; }
 
@@ -395,6 +409,36 @@ private:
                               isce3::core::Basis &,
                               DEMInterpolator &);
 
+    /**
+     * Run rdr2geo for all pixels of a block
+     *
+     * All lines of the block are processed in a single parallel region, with
+     * (line, range tile) work items scheduled dynamically across threads.
+     *
+     * @param[in] lineStart first line of the block
+     * @param[in] layers output layers sized for the block
+     * @param[in] demInterp DEM interpolator covering the block
+     * @param[out] satPosition satellite position for each line in block
+     * @returns number of converged pixels
+     */
+    size_t _topoBlock(size_t lineStart, TopoLayers & layers,
+                      DEMInterpolator & demInterp,
+                      std::vector<isce3::core::Vec3> & satPosition);
+
+    /**
+     * Process all blocks of the radar grid
+     *
+     * Layover/shadow masking and output of each block run on a background
+     * thread concurrently with rdr2geo of the next block.
+     *
+     * @param[in] layers TopoLayers object for storing and writing results
+     * @param[in] demRaster DEM raster to subset for each block, or nullptr
+     * to use demInterp for all blocks
+     * @param[in] demInterp DEM interpolator used when demRaster is nullptr
+     */
+    void _topoBlocks(TopoLayers & layers, isce3::io::Raster * demRaster,
+                     DEMInterpolator * demInterp);
+
     /** Main entry point for the module; internal creation of topo rasters */
     template<typename T> void _topo(T& dem, const std::string& outdir);
 
@@ -415,6 +459,8 @@ private:
 
     // isce3::core objects
     isce3::core::Orbit _orbit;
+    // Piecewise polynomials of _orbit for fast interpolation
+    isce3::core::EphemerisTable _ephemeris;
     isce3::core::Ellipsoid _ellipsoid;
     isce3::core::LUT2d<double> _doppler;
 
@@ -429,6 +475,7 @@ private:
     double _maxH = isce3::core::GLOBAL_MAX_HEIGHT;   //Highest altitude in scene (global maximum default)
     double _margin = 0.15;        //Margin for bounding box in decimal degrees
     size_t _linesPerBlock = 1000; //Block size for processing
+    size_t _tileWidth = 256;      //Range bins per tile for parallel processing
     bool _computeMask = true;     //Flag for generating shadow-layover mask
 
     isce3::core::LookSide _lookSide;
@@ -119,6 +119,7 @@ class isce3::geometry::TopoLayers {
             _localIncRaster = &localIncRaster;
             _localPsiRaster = &localPsiRaster;
             _simRaster = &simRaster;
+            _maskRaster = nullptr;
         }
 
         // Set rasters (plus mask raster) from externally created rasters
@@ -138,6 +139,19 @@ class isce3::geometry::TopoLayers {
             _maskRaster = &maskRaster;
         }
 
+        // Share the output rasters of another TopoLayers object (not owned)
+        void setRasters(const TopoLayers & layers) {
+            _xRaster = layers._xRaster;
+            _yRaster = layers._yRaster;
+            _zRaster = layers._zRaster;
+            _incRaster = layers._incRaster;
+            _hdgRaster = layers._hdgRaster;
+            _localIncRaster = layers._localIncRaster;
+            _localPsiRaster = layers._localPsiRaster;
+            _simRaster = layers._simRaster;
+            _maskRaster = layers._maskRaster;
+        }
+
         // Get array references
         std::valarray<double> & x() { return _x; }
         std::valarray<double> & y() { return _y; }
@@ -7,12 +7,14 @@
 
 #include "geometry.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <limits>
 
 #include <isce3/core/Basis.h>
 #include <isce3/core/Ellipsoid.h>
+#include <isce3/core/EphemerisTable.h>
 #include <isce3/core/LUT2d.h>
 #include <isce3/core/Orbit.h>
 #include <isce3/core/Peg.h>
@@ -253,6 +255,243 @@ geo2rdr(const Vec3 & inputLLH, const Ellipsoid & ellipsoid, const Orbit & orbit,
     return (status == ErrorCode::Success);
 }
 
+int isce3::geometry::
+geo2rdr(const Vec3 & inputLLH, const Ellipsoid & ellipsoid,
+        const EphemerisTable & ephemeris, const LUT2d<double> & doppler,
+        double & aztime, double & slantRange, double wavelength, LookSide side,
+        double threshold, int maxIter, double deltaRange)
+{
+    double t0 = aztime;
+    detail::Geo2RdrParams params = {threshold, maxIter, deltaRange};
+    auto status =
+            detail::geo2rdr(&aztime, &slantRange, inputLLH, ellipsoid,
+                            ephemeris, doppler, wavelength, side, t0, params);
+    return (status == ErrorCode::Success);
+}
+
+double isce3::geometry::detail::
+computeDopplerAztimeDiff(double t, double r, const Vec3& rvec, const Vec3& vel,
+                         const LUT2d<double>& doppler, double wvl,
+                         const Geo2RdrParams& /*params*/)
+{
+    // compute Doppler and its derivative with respect to range
+    const auto dopfact = rvec.dot(vel);
+    const auto fdop = 0.5 * wvl * doppler.eval(t, r);
+    const auto fdopder = 0.5 * wvl * doppler.eval_dx(t, r);
+
+    // evaluate cost function and its derivative
+    const auto fn = dopfact - fdop * r;
+    const auto c1 = -vel.dot(vel);
+    const auto c2 = (fdop / r) + fdopder;
+    const auto fnprime = c1 + c2 * dopfact;
+
+    const auto dt = fn / fnprime;
+    return dt;
+}
+
+namespace isce3::geometry {
+namespace {
+
+// Number of points iterated in lock-step by the batch kernels
+constexpr int batchLanes = 8;
+
+// Per-lane radar geometry for the batch rdr2geo kernel, in
+// structure-of-arrays layout
+struct Rdr2GeoLanes {
+    double posX[batchLanes], posY[batchLanes], posZ[batchLanes];
+    double tX[batchLanes], tY[batchLanes], tZ[batchLanes];
+    double cX[batchLanes], cY[batchLanes], cZ[batchLanes];
+    double nX[batchLanes], nY[batchLanes], nZ[batchLanes];
+    double ndotv[batchLanes], vdott[batchLanes];
+    double satDist[batchLanes], radius[batchLanes], satHeight[batchLanes];
+    double range[batchLanes], dopfact[batchLanes];
+    bool valid[batchLanes];
+
+    // Set up lane l (same quantities as detail::rdr2geo)
+    void set(int l, const Pixel& pixel, const Basis& tcnbasis,
+             const Vec3& pos, const Vec3& vel, const Ellipsoid& ellipsoid)
+    {
+        const Vec3 vhat = vel.normalized();
+        const Vec3& that = tcnbasis.x0();
+        const Vec3& chat = tcnbasis.x1();
+        const Vec3& nhat = tcnbasis.x2();
+
+        const double major = ellipsoid.a();
+        const double minor = major * std::sqrt(1. - ellipsoid.e2());
+        const double dist = pos.norm();
+        const double x = pos[0] / major;
+        const double y = pos[1] / major;
+        const double z = pos[2] / minor;
+        const double eta = 1. / std::sqrt((x * x) + (y * y) + (z * z));
+
+        posX[l] = pos[0]; posY[l] = pos[1]; posZ[l] = pos[2];
+        tX[l] = that[0]; tY[l] = that[1]; tZ[l] = that[2];
+        cX[l] = chat[0]; cY[l] = chat[1]; cZ[l] = chat[2];
+        nX[l] = nhat[0]; nY[l] = nhat[1]; nZ[l] = nhat[2];
+        ndotv[l] = nhat.dot(vhat);
+        vdott[l] = vhat.dot(that);
+        satDist[l] = dist;
+        radius[l] = eta * dist;
+        satHeight[l] = (1. - eta) * dist;
+        range[l] = pixel.range();
+        dopfact[l] = pixel.dopfact();
+        valid[l] = true;
+    }
+
+    // Target ECEF position for target height estimates h
+    void targetXYZ(int nl, const double* h, LookSide side, double* x,
+                   double* y, double* z) const
+    {
+        const double sign = (side == LookSide::Right) ? 1. : -1.;
+        #pragma omp simd
+        for (int l = 0; l < nl; ++l) {
+            // compute angles
+            const double a = satDist[l];
+            const double b = radius[l] + h[l];
+            const double r = range[l];
+            const double cos_theta = 0.5 * (a / r + r / a - (b / a) * (b / r));
+            const double sin_theta = std::sqrt(1. - cos_theta * cos_theta);
+
+            // compute TCN scale factors
+            const double gamma = r * cos_theta;
+            const double alpha = (dopfact[l] - gamma * ndotv[l]) / vdott[l];
+            const double rs = r * sin_theta;
+            const double beta = sign * std::sqrt((rs * rs) - (alpha * alpha));
+
+            // add vector from satellite to ground
+            x[l] = posX[l] + ((alpha * tX[l] + beta * cX[l]) + gamma * nX[l]);
+            y[l] = posY[l] + ((alpha * tY[l] + beta * cY[l]) + gamma * nY[l]);
+            z[l] = posZ[l] + ((alpha * tZ[l] + beta * cZ[l]) + gamma * nZ[l]);
+        }
+    }
+};
+
+// Run rdr2geo iterations for nl lanes in lock-step. Lanes that are not
+// valid are left untouched. Returns the number of converged lanes.
+size_t rdr2geoLanes(const Rdr2GeoLanes& g, int nl, const Ellipsoid& ellipsoid,
+                    const DEMInterpolator& dem, LookSide side, double* lon,
+                    double* lat, double* height, unsigned char* converged,
+                    const detail::Rdr2GeoParams& params)
+{
+    double h[batchLanes], x[batchLanes], y[batchLanes], z[batchLanes];
+    Vec3 llh_new[batchLanes], llh_old[batchLanes];
+    bool active[batchLanes], conv[batchLanes];
+
+    for (int l = 0; l < nl; ++l) {
+        h[l] = std::isnan(height[l]) ? g.satHeight[l] : height[l];
+        active[l] = g.valid[l];
+        conv[l] = false;
+    }
+
+    const int niter = params.maxiter + params.extraiter;
+    for (int i = 0; i < niter; ++i) {
+
+        // near nadir test
+        int nactive = 0;
+        for (int l = 0; l < nl; ++l) {
+            if (active[l] and g.satHeight[l] - h[l] >= g.range[l]) {
+                active[l] = false;
+            }
+            nactive += active[l];
+        }
+        if (nactive == 0) {
+            break;
+        }
+
+        // estimate target LLH
+        g.targetXYZ(nl, h, side, x, y, z);
+        for (int l = 0; l < nl; ++l) {
+            if (active[l]) {
+                llh_new[l] = ellipsoid.xyzToLonLat(Vec3{x[l], y[l], z[l]});
+
+                // snap to interpolated DEM height at target lon/lat
+                llh_new[l][2] = dem.interpolateLonLat(llh_new[l][0],
+                                                      llh_new[l][1]);
+            }
+        }
+
+        // update target height estimates and check for convergence
+        const bool extra = (i > params.maxiter);
+        for (int l = 0; l < nl; ++l) {
+            if (not active[l]) {
+                continue;
+            }
+            const Vec3 xyz_new = ellipsoid.lonLatToXyz(llh_new[l]);
+            h[l] = xyz_new.norm() - g.radius[l];
+
+            const Vec3 pos{g.posX[l], g.posY[l], g.posZ[l]};
+            const double dr = std::abs(g.range[l] - (pos - xyz_new).norm());
+            if (dr < params.tol) {
+                conv[l] = true;
+                active[l] = false;
+                continue;
+            }
+
+            // in extra iterations, use average of new & old estimated
+            // target position
+            if (extra) {
+                const Vec3 xyz_old = ellipsoid.lonLatToXyz(llh_old[l]);
+                const Vec3 xyz_avg = 0.5 * (xyz_old + xyz_new);
+                llh_new[l] = ellipsoid.xyzToLonLat(xyz_avg);
+                h[l] = xyz_avg.norm() - g.radius[l];
+            }
+
+            llh_old[l] = llh_new[l];
+        }
+    }
+
+    // final computation - output points exactly at pixel range
+    g.targetXYZ(nl, h, side, x, y, z);
+    size_t nconv = 0;
+    for (int l = 0; l < nl; ++l) {
+        if (not g.valid[l]) {
+            continue;
+        }
+        const Vec3 llh = ellipsoid.xyzToLonLat(Vec3{x[l], y[l], z[l]});
+        lon[l] = llh[0];
+        lat[l] = llh[1];
+        height[l] = llh[2];
+        nconv += conv[l];
+    }
+
+    if (converged != nullptr) {
+        for (int l = 0; l < nl; ++l) {
+            converged[l] = conv[l];
+        }
+    }
+    return nconv;
+}
+
+} // anonymous namespace
+} // isce3::geometry
+
+size_t isce3::geometry::
+rdr2geoBatch(const double* slantRange, const double* dopfact, size_t n,
+             const Basis& TCNbasis, const Vec3& pos, const Vec3& vel,
+             const Ellipsoid& ellipsoid, const DEMInterpolator& demInterp,
+             double* lon, double* lat, double* height, LookSide side,
+             double threshold, int maxIter, int extraIter,
+             unsigned char* converged)
+{
+    const detail::Rdr2GeoParams params = {threshold, maxIter, extraIter};
+
+    size_t nconv = 0;
+    Rdr2GeoLanes lanes {};
+    for (size_t i0 = 0; i0 < n; i0 += batchLanes) {
+        const int nl = static_cast<int>(std::min<size_t>(batchLanes, n - i0));
+        for (int l = 0; l < nl; ++l) {
+            const size_t i = i0 + l;
+            lanes.set(l, Pixel(slantRange[i], dopfact[i], 0), TCNbasis, pos,
+                      vel, ellipsoid);
+        }
+
+        nconv += rdr2geoLanes(lanes, nl, ellipsoid, demInterp, side,
+                              lon + i0, lat + i0, height + i0,
+                              converged ? converged + i0 : nullptr, params);
+    }
+    return nconv;
+}
+
 // Utility function to compute geographic bounds for a radar grid
 void isce3::geometry::
 computeDEMBounds(const Orbit & orbit,
@@ -19,6 +19,8 @@
 #include <isce3/product/forward.h>
 #include <isce3/core/Constants.h>
 
+#include <cstddef>
+
 // Declaration
 namespace isce3 {
 //! The isce3::geometry namespace
@@ -120,6 +122,46 @@ int rdr2geo(const isce3::core::Vec3& radarXYZ,
             isce3::core::Vec3& targetXYZ, isce3::core::LookSide side,
             double threshold, int maxIter, int extraIter);
 
+/**
+ * Batch radar geometry coordinates to map coordinates transformer for points
+ * sharing the same platform position and TCN basis (e.g. a range line).
+ *
+ * Equivalent to calling rdr2geo(const Pixel&, ...) for each of the n input
+ * points, but the points are iterated in lock-step in small groups with
+ * per-point convergence masks, so that the target position update of the
+ * iteration is vectorized. DEM interpolation and the geodetic conversions
+ * are still done one point at a time.
+ *
+ * @param[in] slantRange  slant range of each point
+ * @param[in] dopfact     doppler factor of each point (see Pixel)
+ * @param[in] n           number of points
+ * @param[in] TCNbasis    Geocentric TCN basis corresponding to pixel
+ * @param[in] pos         Platform position vector
+ * @param[in] vel         Platform velocity vector
+ * @param[in] ellipsoid   Ellipsoid object
+ * @param[in] demInterp   DEMInterpolator object
+ * @param[out] lon        output longitude (radians)
+ * @param[out] lat        output latitude (radians)
+ * @param[in,out] height  initial height guess (NaN for satellite height) on
+ *                        input, output height above ellipsoid on output
+ * @param[in] side        Left or Right
+ * @param[in] threshold   Distance threshold for convergence
+ * @param[in] maxIter     Number of primary iterations
+ * @param[in] extraIter   Number of secondary iterations
+ * @param[out] converged  optional per-point convergence flags
+ * @returns number of converged points
+ */
+size_t rdr2geoBatch(const double* slantRange, const double* dopfact, size_t n,
+                    const isce3::core::Basis & TCNbasis,
+                    const isce3::core::Vec3& pos,
+                    const isce3::core::Vec3& vel,
+                    const isce3::core::Ellipsoid & ellipsoid,
+                    const DEMInterpolator & demInterp,
+                    double* lon, double* lat, double* height,
+                    isce3::core::LookSide side, double threshold,
+                    int maxIter, int extraIter,
+                    unsigned char* converged = nullptr);
+
 /**
  * Map coordinates to radar geometry coordinates transformer
  *
@@ -170,7 +212,8 @@ int geo2rdr(const isce3::core::Vec3 & inputLLH,
  * @param[in] side        Left or Right
  * @param[in] threshold   azimuth time convergence threshold in seconds
  * @param[in] maxIter     Maximum number of Newton-Raphson iterations
- * @param[in] deltaRange  step size used for computing derivative of doppler
+ * @param[in] deltaRange  unused (the range derivative of the LUT2d Doppler
+ *                        is computed analytically)
  */
 int geo2rdr(const isce3::core::Vec3 & inputLLH,
             const isce3::core::Ellipsoid & ellipsoid,
@@ -180,6 +223,34 @@ int geo2rdr(const isce3::core::Vec3 & inputLLH,
             double wavelength, isce3::core::LookSide side, double threshold,
             int maxIter, double deltaRange);
 
+/**
+ * Map coordinates to radar geometry coordinates transformer
+ *
+ * Same as geo2rdr(const Vec3&, const Ellipsoid&, const Orbit&,
+ * const LUT2d<double>&, ...), with the platform position and velocity
+ * interpolated from a precomputed ephemeris table of the orbit.
+ *
+ * @param[in] inputLLH    Lon/Lat/Hae of target of interest
+ * @param[in] ellipsoid   Ellipsoid object
+ * @param[in] ephemeris   Ephemeris table of the orbit
+ * @param[in] doppler     LUT2d Doppler model
+ * @param[out] aztime     azimuth time of inputLLH w.r.t reference epoch of the orbit
+ * @param[out] slantRange slant range to inputLLH
+ * @param[in] wavelength  Radar wavelength
+ * @param[in] side        Left or Right
+ * @param[in] threshold   azimuth time convergence threshold in seconds
+ * @param[in] maxIter     Maximum number of Newton-Raphson iterations
+ * @param[in] deltaRange  unused (the range derivative of the LUT2d Doppler
+ *                        is computed analytically)
+ */
+int geo2rdr(const isce3::core::Vec3 & inputLLH,
+            const isce3::core::Ellipsoid & ellipsoid,
+            const isce3::core::EphemerisTable & ephemeris,
+            const isce3::core::LUT2d<double> & doppler,
+            double & aztime, double & slantRange,
+            double wavelength, isce3::core::LookSide side, double threshold,
+            int maxIter, double deltaRange);
+
 /**
  * Utility function to compute geographic bounds for a radar grid
  *
@@ -9,15 +9,18 @@
 #include <iostream>
 #include <chrono>
 #include <cmath>
+#include <vector>
 
 // pyre
 #include <pyre/journal.h>
 
 // isce3::core
+#include <isce3/core/BlockPipeline.h>
 #include <isce3/core/Constants.h>
 
 // isce3::image
 #include "ResampSlc.h"
+#include "SincResampler.h"
 #include "Tile.h"
 
 using isce3::io::Raster;
@@ -79,33 +82,65 @@ resamp(isce3::io::Raster & inputSlc, isce3::io::Raster & outputSlc,
     // Start timer
     auto timerStart = std::chrono::steady_clock::now();
 
-    // For each full tile of _linesPerTile lines...
-    for (int tileCount = 0; tileCount < nTiles; tileCount++) {
+    // Per-slot buffers for the tiles in flight
+    struct TileBuffers {
+        Tile_t tile;
+        isce3::image::Tile<float> azOffTile, rgOffTile;
+        std::valarray<std::complex<float>> imgOut;
+    };
+    std::vector<TileBuffers> slots;
+
+    // Read offsets and SLC data for the next tile, remove carrier and
+    // interpolate the current tile, and write out the previous tile
+    // concurrently
+    isce3::core::BlockPipeline pipeline;
+    pipeline.io([&](int tileCount, int slot) {
+        TileBuffers & b = slots[slot];
 
         // Make a tile for representing input SLC data
-        Tile_t tile;
-        tile.width(inWidth);
+        b.tile = Tile_t();
+        b.tile.width(inWidth);
         // Set its line index bounds (line number in output image)
-        tile.rowStart(tileCount * _linesPerTile);
+        b.tile.rowStart(tileCount * _linesPerTile);
         if (tileCount == (nTiles - 1)) {
-            tile.rowEnd(outLength);
+            b.tile.rowEnd(outLength);
         } else {
-            tile.rowEnd(tile.rowStart() + _linesPerTile);
+            b.tile.rowEnd(b.tile.rowStart() + _linesPerTile);
         }
 
         // Initialize offsets tiles
-        isce3::image::Tile<float> azOffTile, rgOffTile;
-        _initializeOffsetTiles(tile, azOffsetRaster, rgOffsetRaster,
-                               azOffTile, rgOffTile, outWidth);
+        _initializeOffsetTiles(b.tile, azOffsetRaster, rgOffsetRaster,
+                               b.azOffTile, b.rgOffTile, outWidth);
 
-        // Get corresponding image indices
+        // Get corresponding image indices and read image data
         std::cout << "Reading in image data for tile " << tileCount << "\n";
-        _initializeTile(tile, inputSlc, azOffTile, outLength, rowBuffer, chipSize/2); 
-    
+        _initializeTile(b.tile, inputSlc, b.azOffTile, outLength, rowBuffer,
+                        chipSize/2);
+    });
+    pipeline.compute([&](int tileCount, int slot) {
+        TileBuffers & b = slots[slot];
+
+        // Remove carrier from input data
+        _removeCarrier(b.tile);
+
         // Perform interpolation
         std::cout << "Interpolating tile " << tileCount << "\n";
-        _transformTile(tile, outputSlc, rgOffTile, azOffTile, inLength, flatten, chipSize);
-    }
+        _transformTile(b.tile, b.imgOut, b.rgOffTile, b.azOffTile, inLength,
+                       flatten, chipSize);
+    });
+    pipeline.io([&](int, int slot) {
+        TileBuffers & b = slots[slot];
+
+        // Write block of data
+        outputSlc.setBlock(b.imgOut, 0, b.tile.rowStart(), outWidth,
+                           b.azOffTile.length());
+
+        // Release tile memory
+        b = TileBuffers();
+    });
+
+    slots.resize(pipeline.numSlots());
+    pipeline.run(nTiles);
 
     // Print out timing information and reset
     auto timerEnd = std::chrono::steady_clock::now();
@@ -214,8 +249,14 @@ _initializeTile(Tile_t & tile, Raster & inputSlc, const isce3::image::Tile<float
     // Read in tile.length() lines of data from the input image to the image block
     inputSlc.getBlock(&tile[0], 0, tile.firstImageRow(), tile.width(),
                       tile.length(), _inputBand);
+}
 
-    // Remove carrier from input data
+// Remove carrier from input tile data
+void isce3::image::ResampSlc::
+_removeCarrier(Tile_t & tile) {
+
+    const int inWidth = tile.width();
+    #pragma omp parallel for
     for (int i = 0; i < tile.length(); i++) {
         for (int j = 0; j < inWidth; j++) {
             // Evaluate the pixel's carrier phase
@@ -231,8 +272,8 @@ _initializeTile(Tile_t & tile, Raster & inputSlc, const isce3::image::Tile<float
 
 // Interpolate tile to perform transformation
 void isce3::image::ResampSlc::
-_transformTile(Tile_t & tile,
-               Raster & outputSlc,
+_transformTile(const Tile_t & tile,
+               std::valarray<std::complex<float>> & imgOut,
                const isce3::image::Tile<float> & rgOffTile,
                const isce3::image::Tile<float> & azOffTile,
                int inLength, bool flatten,
@@ -248,28 +289,38 @@ _transformTile(Tile_t & tile,
     const double az0 = _sensingStart;
 
     // Allocate valarray for output image block
-    std::valarray<std::complex<float>> imgOut(outLength * outWidth);
+    imgOut.resize(outLength * outWidth);
     // Initialize to zeros
     imgOut = std::complex<float>(0.0, 0.0);
+    if (outLength == 0 || outWidth == 0)
+        return;
+
+    // Split output block into 2D sub-tiles that are processed independently
+    const int subLength = std::min(_subtileLength, outLength);
+    const int subWidth = std::min(_subtileWidth, outWidth);
+    const int nSubRows = (outLength + subLength - 1) / subLength;
+    const int nSubCols = (outWidth + subWidth - 1) / subWidth;
 
     // From this point on, transformation is multithreaded
-    int tileLine = 0;
-    #pragma omp parallel shared(imgOut)
-    {
+    #pragma omp parallel for schedule(dynamic)
+    for (int sub = 0; sub < nSubRows * nSubCols; ++sub) {
+
+    const int lineStart = (sub / nSubCols) * subLength;
+    const int lineEnd = std::min(lineStart + subLength, outLength);
+    const int colStart = (sub % nSubCols) * subWidth;
+    const int colEnd = std::min(colStart + subWidth, outWidth);
 
-    // set half chip size
-    // Allocate matrix for working sinc chip
-    isce3::core::Matrix<std::complex<float>> chip(chipSize, chipSize);
+    // Loop over lines of sub-tile to perform interpolation
+    for (int tileLine = lineStart; tileLine < lineEnd; ++tileLine) {
 
-    // Loop over lines to perform interpolation
-    for (int i = tile.rowStart(); i < tile.rowEnd(); ++i) {
+        // Line in output image
+        const int i = tile.rowStart() + tileLine;
 
         // Compute current azimuth time
         const double az = az0 + i / _prf;
 
-        // Loop over width
-        #pragma omp for
-        for (int j = 0; j < outWidth; ++j) {
+        // Loop over width of sub-tile
+        for (int j = colStart; j < colEnd; ++j) {
 
             // Unpack offsets (units of bins)
             const float azOff = azOffTile(tileLine, j);
@@ -309,24 +360,11 @@ _transformTile(Tile_t & tile,
             // Modulate by 2*PI
             phase = modulo_f(phase, 2.0*M_PI);
             
-            // Read data chip without the carrier phases
-            for (int ii = 0; ii < chipSize; ++ii) {
-                // Row to read from
-                const int chipRow = intAz - tile.firstImageRow() + ii - chipHalf;
-                // Carrier phase
-                const double phase = dop * (ii - 4.0);
-                const std::complex<float> cval(std::cos(phase), -std::sin(phase));
-                // Set the data values after removing doppler in azimuth
-                for (int jj = 0; jj < chipSize; ++jj) {
-                    // Column to read from
-                    const int chipCol = intRg + jj - chipHalf;
-                    chip(ii,jj) = tile(chipRow,chipCol) * cval;
-                }
-            }
-
-            // Interpolate chip
-            const std::complex<float> cval = _interp->interpolate(
-                isce3::core::SINC_HALF + fracRg, isce3::core::SINC_HALF + fracAz, chip
+            // Interpolate directly from the tile after removing the azimuth
+            // Doppler ramp
+            const std::complex<float> cval = _sinc->interpolate(
+                &tile[0], inWidth, intAz - tile.firstImageRow(), intRg,
+                fracAz, fracRg, dop
             );
 
             // Add doppler to interpolated value and save
@@ -336,18 +374,9 @@ _transformTile(Tile_t & tile,
 
         } // end for over width
 
-        // Update input line counter
-        #pragma omp single
-        {
-        ++tileLine;
-        }
-
     } // end for over length
 
-    } // end multithreaded block
-
-    // Write block of data
-    outputSlc.setBlock(imgOut, 0, tile.rowStart(), outWidth, outLength);
+    } // end multithreaded loop over sub-tiles
 }
 
 // end of file
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <complex>
+#include <memory>
 #include <valarray>
 
 // isce3::core
@@ -23,6 +24,9 @@
 // isce3::io
 #include <isce3/io/forward.h>
 
+// isce3::image
+#include "SincResampler.h"
+
 // isce3::product
 #include <isce3/product/Product.h>
 #include <isce3/product/RadarGridParameters.h>
@@ -135,14 +139,17 @@ class isce3::image::ResampSlc {
     protected:
         // Number of lines per tile
         size_t _linesPerTile = 1000;
+        // Size of output sub-tiles interpolated in parallel
+        int _subtileLength = 64;
+        int _subtileWidth = 512;
         // Band number
         int _inputBand;
         // Filename of the input product
         std::string _filename;
         // Flag indicating if we have a reference data (for flattening)
         bool _haveRefData;
-        // Interpolator pointer
-        isce3::core::Interpolator<std::complex<float>> * _interp;
+        // Separable sinc interpolation kernel
+        std::shared_ptr<isce3::image::SincResampler> _sinc;
 
         // Polynomials and LUTs
         isce3::core::Poly2d _rgCarrier;            // range carrier polynomial
@@ -172,9 +179,12 @@ class isce3::image::ResampSlc {
                              const isce3::image::Tile<float> &,
                              int, int, int);
 
-        // Tile transformation
-        void _transformTile(Tile_t & tile,
-                            isce3::io::Raster & outputSlc,
+        // Remove carrier phase from input SLC tile
+        void _removeCarrier(Tile_t &);
+
+        // Tile transformation into output block
+        void _transformTile(const Tile_t & tile,
+                            std::valarray<std::complex<float>> & imgOut,
                             const isce3::image::Tile<float> & rgOffTile,
                             const isce3::image::Tile<float> & azOffTile,
                             int inLength, bool flatten,
@@ -0,0 +1,76 @@
+// -*- C++ -*-
+// -*- coding: utf-8 -*-
+
+#include "SincResampler.h"
+
+#include <cmath>
+
+#include <isce3/core/Interpolator.h>
+#include <isce3/except/Error.h>
+
+isce3::image::SincResampler::
+SincResampler(int sincLen, int sincSub) :
+    _sincLen{sincLen}, _sincSub{sincSub}
+{
+    if (sincLen < 2 or sincLen % 2 != 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "sinc length must be even and positive");
+    }
+    if (sincSub < 1) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "sinc oversampling factor must be positive");
+    }
+
+    // Use the normalized kernel of the generic 2D sinc interpolator, whose
+    // taps are ordered from the last to the first input sample
+    const isce3::core::Sinc2dInterpolator<float> interp(sincLen, sincSub);
+    const auto & kernel = interp.kernel();
+
+    _weights.resize(static_cast<size_t>(sincSub) * sincLen);
+    for (int i = 0; i < sincSub; ++i) {
+        for (int k = 0; k < sincLen; ++k) {
+            _weights[static_cast<size_t>(i) * sincLen + k] =
+                static_cast<float>(kernel(i, sincLen - 1 - k));
+        }
+    }
+}
+
+std::complex<float> isce3::image::SincResampler::
+interpolate(const std::complex<float>* data, size_t stride, int intAz,
+            int intRg, double fracAz, double fracRg, double dop) const
+{
+    const int half = _sincLen / 2;
+    const float* wrg = weights(fracRg);
+    const float* waz = weights(fracAz);
+
+    // Deramp phasor of first row and its increment between rows
+    const std::complex<double> step(std::cos(dop), -std::sin(dop));
+    const double phase0 = dop * (1 - isce3::core::SINC_HALF);
+    std::complex<double> ramp(std::cos(phase0), -std::sin(phase0));
+
+    float re = 0.0f, im = 0.0f;
+    for (int k = 0; k < _sincLen; ++k) {
+
+        // Range pass over input row, treated as interleaved floats
+        const std::complex<float>* row =
+            data + static_cast<size_t>(intAz + k + 1 - half) * stride
+                 + (intRg + 1 - half);
+        const float* x = reinterpret_cast<const float*>(row);
+        float rowRe = 0.0f, rowIm = 0.0f;
+        #pragma omp simd reduction(+:rowRe,rowIm)
+        for (int j = 0; j < _sincLen; ++j) {
+            rowRe += wrg[j] * x[2 * j];
+            rowIm += wrg[j] * x[2 * j + 1];
+        }
+
+        // Azimuth pass with Doppler deramp
+        const float wr = waz[k] * static_cast<float>(ramp.real());
+        const float wi = waz[k] * static_cast<float>(ramp.imag());
+        re += rowRe * wr - rowIm * wi;
+        im += rowRe * wi + rowIm * wr;
+
+        ramp *= step;
+    }
+
+    return {re, im};
+}
@@ -3,6 +3,7 @@
 namespace isce3 { namespace image {
 
     class ResampSlc;
+    class SincResampler;
 
     template<class> class Tile;
 }}
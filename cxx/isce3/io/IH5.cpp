@@ -1,5 +1,9 @@
 #include "IH5.h"
 
+#include <algorithm>
+#include <cstring>
+#include <zlib.h>
+
 #include <isce3/core/Constants.h>
 
 ///////////////////////// UTILITIES ///////////////////////////////////
@@ -17,6 +21,39 @@ inline unsigned int mapFileAccessMode(const char mode) {
     }
 }
 
+// Smallest prime not less than n (chunk cache hash table size)
+inline size_t nextPrime(size_t n) {
+    for (;; ++n) {
+        bool prime = (n > 1);
+        for (size_t d = 2; prime and d * d <= n; ++d)
+            prime = (n % d != 0);
+        if (prime)
+            return n;
+    }
+}
+
+// Access property list setting the given chunk cache
+inline H5::DSetAccPropList chunkCacheAccessPlist(
+        const isce3::io::ChunkCache& cache) {
+    H5::DSetAccPropList dapl;
+    dapl.setChunkCache(cache.nslots > 0 ? cache.nslots
+                                        : H5D_CHUNK_CACHE_NSLOTS_DEFAULT,
+                       cache.nbytes, cache.w0);
+    return dapl;
+}
+
+// File access property list with the given alignment and chunk cache
+inline H5::FileAccPropList fileAccessPlist(
+        const isce3::io::FileAccessProps& props) {
+    H5::FileAccPropList fapl;
+    fapl.setAlignment(props.alignThreshold, props.alignment);
+    // 521 is the HDF5 default number of slots
+    const isce3::io::ChunkCache& cache = props.chunkCache;
+    fapl.setCache(0, cache.nslots > 0 ? cache.nslots : 521, cache.nbytes,
+                  cache.w0);
+    return fapl;
+}
+
 // The first argument refers to the H5Object that gets used to call
 // this function as an operator.
 void attrsNames(H5::H5Object&, H5std_string nameAttr, void* opdata) {
@@ -299,6 +336,180 @@ std::vector<int> isce3::io::IDataSet::getChunkSize() {
     return out;
 }
 
+/** @param[in] buf Lines to write
+ *  @param[in] typeSize Size in bytes of an element
+ *  @param[in] yidx Index of the first line
+ *  @param[in] nlines Number of lines
+ *
+ * Compress the chunks covered by whole rows of chunks of a 2D dataset in
+ * parallel and write them with H5Dwrite_chunk. Returns false without writing
+ * anything if the dataset layout, its filters or the lines do not allow it. */
+bool isce3::io::IDataSet::writeChunks(const void* buf, size_t typeSize,
+                                     hsize_t yidx, hsize_t nlines) {
+#if H5_VERSION_GE(1, 10, 3)
+    H5::DSetCreatPropList plist = getCreatePlist();
+    if (plist.getLayout() != H5D_CHUNKED)
+        return false;
+
+    // Only deflate, optionally preceded by byte shuffling, is supported
+    const int nfilters = plist.getNfilters();
+    bool shuffle = false;
+    int level = -1;
+    for (int i = 0; i < nfilters; i++) {
+        unsigned int flags, config;
+        unsigned int cdValues[1] = {0};
+        size_t nvalues = 1;
+        char name[64];
+        const H5Z_filter_t filter =
+                H5Pget_filter2(plist.getId(), i, &flags, &nvalues, cdValues,
+                               sizeof(name), name, &config);
+        if (filter == H5Z_FILTER_SHUFFLE and i == 0)
+            shuffle = true;
+        else if (filter == H5Z_FILTER_DEFLATE and i == nfilters - 1)
+            level = cdValues[0];
+        else
+            return false;
+    }
+    if (level < 0)
+        return false;
+
+    // Only whole rows of chunks (the last one may be partial)
+    const std::vector<int> dims = getDimensions();
+    hsize_t chunkDims[2];
+    plist.getChunk(2, chunkDims);
+    const hsize_t length = dims[0], width = dims[1];
+    if (yidx % chunkDims[0] != 0 or
+        (nlines % chunkDims[0] != 0 and yidx + nlines != length))
+        return false;
+
+    const hsize_t nchunksX = (width + chunkDims[1] - 1) / chunkDims[1];
+    const hsize_t nchunksY = (nlines + chunkDims[0] - 1) / chunkDims[0];
+    const long nchunks = nchunksX * nchunksY;
+    const size_t chunkSize = chunkDims[0] * chunkDims[1];
+    const size_t chunkBytes = chunkSize * typeSize;
+    const unsigned char* src = static_cast<const unsigned char*>(buf);
+
+    std::vector<std::vector<unsigned char>> chunks(nchunks);
+    std::vector<int> status(nchunks, Z_OK);
+
+    #pragma omp parallel
+    {
+        std::vector<unsigned char> raw(chunkBytes);
+        std::vector<unsigned char> shuffled(shuffle ? chunkBytes : 0);
+
+        #pragma omp for schedule(dynamic)
+        for (long k = 0; k < nchunks; k++) {
+            const hsize_t y0 = (k / nchunksX) * chunkDims[0];
+            const hsize_t x0 = (k % nchunksX) * chunkDims[1];
+            const hsize_t rows = std::min(chunkDims[0], nlines - y0);
+            const hsize_t cols = std::min(chunkDims[1], width - x0);
+
+            // Gather the chunk, padding edge chunks with zeros
+            if (rows < chunkDims[0] or cols < chunkDims[1])
+                std::fill(raw.begin(), raw.end(), 0);
+            for (hsize_t r = 0; r < rows; r++) {
+                std::memcpy(&raw[r * chunkDims[1] * typeSize],
+                            &src[((y0 + r) * width + x0) * typeSize],
+                            cols * typeSize);
+            }
+
+            // Same byte order as the HDF5 shuffle filter
+            const unsigned char* in = raw.data();
+            if (shuffle) {
+                for (size_t b = 0; b < typeSize; b++)
+                    for (size_t e = 0; e < chunkSize; e++)
+                        shuffled[b * chunkSize + e] = raw[e * typeSize + b];
+                in = shuffled.data();
+            }
+
+            uLongf nbytes = compressBound(chunkBytes);
+            chunks[k].resize(nbytes);
+            status[k] = compress2(chunks[k].data(), &nbytes, in, chunkBytes,
+                                  level);
+            chunks[k].resize(nbytes);
+        }
+    }
+
+    if (std::any_of(status.begin(), status.end(),
+                    [](int s) { return s != Z_OK; }))
+        return false;
+
+    // HDF5 calls are serialized
+    for (long k = 0; k < nchunks; k++) {
+        const hsize_t offset[2] = {yidx + (k / nchunksX) * chunkDims[0],
+                                   (k % nchunksX) * chunkDims[1]};
+        if (H5Dwrite_chunk(getId(), H5P_DEFAULT, 0, offset, chunks[k].size(),
+                           chunks[k].data()) < 0) {
+            throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                                             "Failed to write dataset chunk");
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/** @param[in] nlines Number of lines of the windows to be read
+ *  @param[in] ncols  Number of columns of the windows to be read (0 for the
+ *  full width of the dataset)
+ *
+ * The cache is large enough to hold every chunk intersected by a window at
+ * any offset, so that reading a dataset in consecutive strips or tiles
+ * decompresses each chunk once. Fully read chunks are evicted first. The
+ * HDF5 default is returned for datasets that are not chunked. */
+isce3::io::ChunkCache isce3::io::IDataSet::getChunkCache(size_t nlines,
+                                                       size_t ncols) {
+    ChunkCache cache;
+
+    const std::vector<int> dims = getDimensions();
+    const std::vector<int> chunks = getChunkSize();
+    const int rank = dims.size();
+    if (rank < 2 or chunks[rank - 1] == 0)
+        return cache;
+
+    // Size in bytes of a chunk
+    size_t chunkBytes = getDataType().getSize();
+    for (int i = 0; i < rank; ++i)
+        chunkBytes *= chunks[i];
+
+    // Maximum number of chunks intersected by a window along an axis
+    auto chunksAlong = [&](size_t n, int axis) {
+        const size_t len = dims[axis], chunk = chunks[axis];
+        n = (n == 0) ? len : std::min(n, len);
+        return std::min((len + chunk - 1) / chunk,
+                        (n + chunk - 2) / chunk + 1);
+    };
+    const size_t nchunks = chunksAlong(nlines, rank - 2) *
+                           chunksAlong(ncols, rank - 1);
+
+    cache.nbytes = std::max(cache.nbytes, nchunks * chunkBytes);
+    cache.nslots = nextPrime(100 * (cache.nbytes / chunkBytes + 1));
+    cache.w0 = 1.0;
+    return cache;
+}
+
+isce3::io::ChunkCache isce3::io::IDataSet::getAccessChunkCache() const {
+    ChunkCache cache;
+    H5::DSetAccPropList dapl = getAccessPlist();
+    dapl.getChunkCache(cache.nslots, cache.nbytes, cache.w0);
+    return cache;
+}
+
+isce3::io::IDataSet isce3::io::IDataSet::reopen(const ChunkCache& cache) const {
+    const hid_t file = H5Iget_file_id(getId());
+    const hid_t id = H5Dopen2(file, getObjName().c_str(),
+                              chunkCacheAccessPlist(cache).getId());
+    H5Fclose(file);
+    if (id < 0)
+        throw H5::DataSetIException("IDataSet::reopen", "H5Dopen2 failed");
+
+    // the wrapper takes its own reference to the id
+    IDataSet dataset(id);
+    H5Dclose(id);
+    return dataset;
+}
+
 /** @param[in] v Name of the attribute (optional).
  *  Returns the actual number of bit used to store the current dataset or given
  *  attribute data in the file. */
@@ -334,11 +545,13 @@ int isce3::io::IDataSet::getNumBits(const std::string& v) {
     return (int) precision;
 }
 
-/** @param[out] str String representation for GDAL's IH5Dataset driver
+/** @param[in] cacheLines Number of full lines read at once
+ *  @param[out] str String representation for GDAL's IH5Dataset driver
 
-  Returns IH5:::ID=string*/
-std::string isce3::io::IDataSet::toGDAL() const {
-    return "IH5:::ID=" + std::to_string(getId());
+  Returns IH5:::ID=string,LINES=cacheLines*/
+std::string isce3::io::IDataSet::toGDAL(size_t cacheLines) const {
+    return "IH5:::ID=" + std::to_string(getId()) +
+           ",LINES=" + std::to_string(cacheLines);
 }
 
 /** @param[in] att  Name of the attribute (optional).
@@ -855,6 +1068,15 @@ isce3::io::IDataSet isce3::io::IGroup::openDataSet(const H5std_string& name) {
     return H5::Group::openDataSet(name);
 }
 
+/** @param[in] name Name of the dataset to open.
+ *  @param[in] cache Chunk cache of the dataset.
+ *
+ * The cache settings are ignored if the dataset is already open. */
+isce3::io::IDataSet isce3::io::IGroup::openDataSet(const H5std_string& name,
+                                                 const ChunkCache& cache) {
+    return H5::Group::openDataSet(name, chunkCacheAccessPlist(cache));
+}
+
 /** @param[in] name Name of the group to open.
  *
  * name must contain the full path from root location and name of the group
@@ -1014,6 +1236,17 @@ isce3::io::IDataSet isce3::io::IH5File::openDataSet(const H5std_string& name) {
     return H5::H5File::openDataSet(name);
 }
 
+/** @param[in] name Name of the dataset to open.
+ *  @param[in] cache Chunk cache of the dataset.
+ *
+ * name must contain the full path from root location and name of the dataset
+ * to open. HDF5 shares a single chunk cache between all the handles of a
+ * dataset, so the cache settings are ignored if the dataset is already open. */
+isce3::io::IDataSet isce3::io::IH5File::openDataSet(const H5std_string& name,
+                                                  const ChunkCache& cache) {
+    return H5::H5File::openDataSet(name, chunkCacheAccessPlist(cache));
+}
+
 /** @param[in] name Name of the group to open.
  *
  * name must contain the full path from root location and name of the group
@@ -1073,3 +1306,8 @@ std::vector<std::string> isce3::io::IH5File::find(const std::string name,
 
 isce3::io::IH5File::IH5File(const H5std_string& name, const char mode)
     : H5::H5File(name, mapFileAccessMode(mode)) {}
+
+isce3::io::IH5File::IH5File(const H5std_string& name, const char mode,
+                          const FileAccessProps& props)
+    : H5::H5File(name, mapFileAccessMode(mode),
+                 H5::FileCreatPropList::DEFAULT, fileAccessPlist(props)) {}
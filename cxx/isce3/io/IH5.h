@@ -32,6 +32,47 @@ typedef struct n1bit {
 typedef struct n2bit {
 } n2bit;
 
+/** Parameters of the raw data chunk cache of a dataset
+ *  (see H5Pset_chunk_cache). The defaults are those of HDF5. */
+struct ChunkCache {
+    /** Total size of the cache in bytes */
+    size_t nbytes = 1024 * 1024;
+    /** Number of hash table slots (0 to keep the file default). Should be a
+     *  prime about 100 times the number of chunks fitting in the cache */
+    size_t nslots = 0;
+    /** Preemption weight [0, 1] of chunks that have been fully read */
+    double w0 = 0.75;
+};
+
+/** Storage properties of a dataset created with IGroup::createDataSet */
+struct DataSetCreateProps {
+    /** Chunk dimensions, one per dataset dimension. Empty for 128 x 128
+     *  chunks on the first two dimensions. For datasets read in full-width
+     *  strips, chunks spanning the whole width avoid reading partial chunks */
+    std::vector<hsize_t> chunks;
+    /** Enable (true) or disable (false) byte shuffling */
+    bool shuffle = false;
+    /** [0..9] level of deflate compression */
+    int deflate = 0;
+    /** Enable (true) or disable (false) the fill value */
+    bool useFillValue = false;
+    /** Value of unwritten elements (both parts of complex elements) */
+    double fillValue = 0.0;
+    /** Chunk cache of the created dataset */
+    ChunkCache chunkCache;
+};
+
+/** File access properties of an IH5File */
+struct FileAccessProps {
+    /** Alignment in bytes of the file objects larger than alignThreshold
+     *  bytes, e.g. the block size of the file system (1 for no alignment) */
+    hsize_t alignment = 1;
+    /** Minimum size in bytes of the aligned objects */
+    hsize_t alignThreshold = 1;
+    /** Default chunk cache of the datasets of the file */
+    ChunkCache chunkCache;
+};
+
 // Parameters containers for HDF5 searching capability
 struct findMeta {
     std::vector<std::string> outList;
@@ -73,11 +114,28 @@ public:
     /** Get the storage chunk size of the dataset */
     std::vector<int> getChunkSize();
 
+    /** Get a chunk cache holding all the chunks intersected by a window of
+     *  nlines x ncols pixels (ncols = 0 for full rows) of the last two
+     *  dimensions, for use with IH5File::openDataSet */
+    ChunkCache getChunkCache(size_t nlines, size_t ncols = 0);
+
+    /** Get the chunk cache the dataset was opened with */
+    ChunkCache getAccessChunkCache() const;
+
+    /** Open the dataset again with the given chunk cache, which is fixed
+     *  when a dataset is opened */
+    IDataSet reopen(const ChunkCache& cache) const;
+
     /** Get the number of bit used to store each dataset element */
     int getNumBits(const std::string& v = "");
 
-    /** Generate GDALDataset Representation */
-    std::string toGDAL() const;
+    /** Generate GDALDataset Representation
+     *
+     *  The IH5 driver reopens chunked datasets with a chunk cache sized for
+     *  reads of cacheLines full lines (see getChunkCache), so that reading
+     *  the raster line by line, block by block or in strips of cacheLines
+     *  lines decompresses each chunk once. */
+    std::string toGDAL(size_t cacheLines = 1) const;
 
     // Dataset reading queries
 
@@ -226,6 +284,12 @@ public:
     /** Writing a raw pointer buffer into a dataset */
     template<typename T> inline void write(const T* buf, const size_t sz);
 
+    /** Writing lines of a chunked 2D dataset, compressing whole chunks in
+     *  parallel */
+    template<typename T>
+    inline void writeLines(const T* buf, const size_t yidx,
+                           const size_t nlines);
+
     /** Writing a raw pointer into a multi-dimensional dataset using std::array
      * for subsetting */
     template<typename T, size_t S>
@@ -296,6 +360,9 @@ public:
 private:
     template<typename T> void read(T* buffer, const H5::DataSpace& dspace);
 
+    bool writeChunks(const void* buf, size_t typeSize, hsize_t yidx,
+                     hsize_t nlines);
+
     void read(std::string* buffer, const H5::DataSpace& dspace);
     void read(std::string* buf, const std::string& att);
 
@@ -363,6 +430,9 @@ public:
     /** Open a given dataset */
     IDataSet openDataSet(const H5std_string& name);
 
+    /** Open a given dataset with the given chunk cache */
+    IDataSet openDataSet(const H5std_string& name, const ChunkCache& cache);
+
     /** Open a given group */
     IGroup openGroup(const H5std_string& name);
 
@@ -414,6 +484,12 @@ public:
                            const std::array<T2, S>& dims, const int chunk = 0,
                            const int shuffle = 0, const int deflate = 0);
 
+    /** Create a datatset with the given storage properties*/
+    template<typename T, typename T2, size_t S>
+    IDataSet createDataSet(const std::string& name,
+                           const std::array<T2, S>& dims,
+                           const DataSetCreateProps& props);
+
     /** Creating and writing a scalar as an attribute */
     template<typename T>
     inline void createAttribute(const std::string& name, const T& data);
@@ -473,11 +549,20 @@ public:
      * - a: create file, fails if exist */
     IH5File(const H5std_string& name, const char mode = 'r');
 
+    /** @param[in] name Name of the Hdf5 file to open.
+     *  @param[in] mode File opening mode (see above)
+     *  @param[in] props File access properties */
+    IH5File(const H5std_string& name, const char mode,
+            const FileAccessProps& props);
+
     void openFile(const H5std_string& name);
 
     /** Open a given dataset */
     IDataSet openDataSet(const H5std_string& name);
 
+    /** Open a given dataset with the given chunk cache */
+    IDataSet openDataSet(const H5std_string& name, const ChunkCache& cache);
+
     /** Open a given group */
     IGroup openGroup(const H5std_string& name);
 
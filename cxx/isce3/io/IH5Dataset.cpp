@@ -5,6 +5,7 @@
 // Copyright 2019
 
 #include "IH5Dataset.h"
+#include <algorithm>
 
 #include <cpl_config.h>
 #include <cpl_conv.h>
@@ -61,6 +62,11 @@ IH5RasterBand::IH5RasterBand( IH5Dataset *ds, int bandIn,
     nBlockYSize = ds->chunks[indexOffset];
     nBlockXSize = ds->chunks[indexOffset+1];
 
+    hsize_t blockdims[2];
+    blockdims[0] = nBlockYSize;
+    blockdims[1] = nBlockXSize;
+    blockSpace = H5::DataSpace(2, blockdims);
+
 }
 
 /************************************************************************/
@@ -92,34 +98,25 @@ CPLErr IH5RasterBand::IReadBlock( int nBlockXOff,
         return CE_None;
     }
 
-    int dims = poGDS->_dataset->getRank();
-    int starts[3];
-    int counts[3];
-    int offset = 0;
+    int starts[2];
+    int counts[2];
 
-    //If 3D dataset is being used
-    if (dims == 3)
-    {
-        starts[0] = nBand-1;
-        counts[0] = 1;
-        offset = 1;
-    }
-
-    starts[offset] = nBlockYOff * nBlockYSize;
-    starts[offset+1] = nBlockXOff * nBlockXSize;
+    starts[0] = nBlockYOff * nBlockYSize;
+    starts[1] = nBlockXOff * nBlockXSize;
 
     //Account for partial blocks
-    counts[offset] = std::min(nBlockYSize, poGDS->GetRasterYSize() - starts[offset]);
-    counts[offset+1] = std::min(nBlockXSize, poGDS->GetRasterXSize() - starts[offset+1]);
+    counts[0] = std::min(nBlockYSize, poGDS->GetRasterYSize() - starts[0]);
+    counts[1] = std::min(nBlockXSize, poGDS->GetRasterXSize() - starts[1]);
 
     std::stringstream ss;
     ss << poGDS->_dataset->getId() << " Read, "
         << "band=" << nBand << ", "
-        << "starts=(" << starts[offset] << "," << starts[offset+1] << "), "
-        << "counts=(" << counts[offset] << "," << counts[offset+1] << ")";
+        << "starts=(" << starts[0] << "," << starts[1] << "), "
+        << "counts=(" << counts[0] << "," << counts[1] << ")";
     CPLDebug("GDAL_IH5", "%s", ss.str().c_str());
 
-    H5::DataSpace dspace = poGDS->_dataset->getDataSpace(starts, counts, nullptr);
+    H5::DataSpace & dspace = poGDS->selectWindow(nBand, starts[1], starts[0],
+                                                 counts[1], counts[0]);
     if (!H5::IdComponent::isValid(dspace.getId()))
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -128,29 +125,24 @@ CPLErr IH5RasterBand::IReadBlock( int nBlockXOff,
     }
 
 
-    //Set up appropriate memory space
-    hsize_t blockdims[2];
-    blockdims[0] = nBlockYSize;
-    blockdims[1] = nBlockXSize;
-
+    //Select the valid part of the block in memory
     hsize_t blockcounts[2];
-    blockcounts[0] = counts[offset];
-    blockcounts[1] = counts[offset+1];
+    blockcounts[0] = counts[0];
+    blockcounts[1] = counts[1];
 
     hsize_t blockoffsets[2];
     blockoffsets[0] = 0;
     blockoffsets[1] = 0;
 
-    H5::DataSpace mspace(2, blockdims);
-    mspace.selectHyperslab( H5S_SELECT_SET, blockcounts, blockoffsets);
-    if (!H5::IdComponent::isValid(dspace.getId()))
+    blockSpace.selectHyperslab( H5S_SELECT_SET, blockcounts, blockoffsets);
+    if (!H5::IdComponent::isValid(blockSpace.getId()))
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Failure to get memory space in Read Block");
         return CE_Failure;
     }
 
-    poGDS->_dataset->H5::DataSet::read(pImage, readType, mspace, dspace);
+    poGDS->_dataset->H5::DataSet::read(pImage, readType, blockSpace, dspace);
     if (!H5::IdComponent::isValid(poGDS->_dataset->getId()))
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -158,12 +150,6 @@ CPLErr IH5RasterBand::IReadBlock( int nBlockXOff,
         return CE_Failure;
     }
 
-    if (H5::IdComponent::isValid(dspace.getId()))
-        dspace.close();
-
-    if (H5::IdComponent::isValid(mspace.getId()))
-        mspace.close();
-
     return CE_None;
 }
 
@@ -180,36 +166,25 @@ CPLErr IH5RasterBand::IWriteBlock( int nBlockXOff,
     IH5Dataset *poGDS = static_cast<IH5Dataset *>(poDS);
     H5::DataType writeType = poGDS->nativeType;
 
-    int dims = poGDS->_dataset->getRank();
-    int starts[3];
-    int counts[3];
-    int offset = 0;
-
-    //If 3D dataset is being used
-    if (dims == 3)
-    {
-        starts[0] = nBand-1;
-        counts[0] = 1;
-        offset = 1;
-    }
+    int starts[2];
+    int counts[2];
 
-    starts[offset] = nBlockYOff * nBlockYSize;
-    starts[offset+1] = nBlockXOff * nBlockXSize;
+    starts[0] = nBlockYOff * nBlockYSize;
+    starts[1] = nBlockXOff * nBlockXSize;
 
     //Account for partial blocks
-    counts[offset] = std::min(nBlockYSize,
-                        poGDS->GetRasterYSize() - starts[offset]);
-    counts[offset+1] = std::min(nBlockXSize,
-                        poGDS->GetRasterXSize() - starts[offset+1]);
+    counts[0] = std::min(nBlockYSize, poGDS->GetRasterYSize() - starts[0]);
+    counts[1] = std::min(nBlockXSize, poGDS->GetRasterXSize() - starts[1]);
 
     std::stringstream ss;
     ss << poGDS->_dataset->getId() << " Write, "
         << "band=" << nBand << ", "
-        << "starts=(" << starts[offset] << "," << starts[offset+1] << "), "
-        << "counts=(" << counts[offset] << "," << counts[offset+1] << ")";
+        << "starts=(" << starts[0] << "," << starts[1] << "), "
+        << "counts=(" << counts[0] << "," << counts[1] << ")";
     CPLDebug("GDAL_IH5", "%s", ss.str().c_str());
 
-    H5::DataSpace dspace = poGDS->_dataset->getDataSpace(starts, counts, nullptr);
+    H5::DataSpace & dspace = poGDS->selectWindow(nBand, starts[1], starts[0],
+                                                 counts[1], counts[0]);
     if (!H5::IdComponent::isValid(dspace.getId()))
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -217,23 +192,18 @@ CPLErr IH5RasterBand::IWriteBlock( int nBlockXOff,
         return CE_Failure;
     }
 
-    //Set up appropriate memory space
-    hsize_t blockdims[2];
-    blockdims[0] = nBlockYSize;
-    blockdims[1] = nBlockXSize;
-
+    //Select the valid part of the block in memory
     hsize_t blockcounts[2];
-    blockcounts[0] = counts[offset];
-    blockcounts[1] = counts[offset+1];
+    blockcounts[0] = counts[0];
+    blockcounts[1] = counts[1];
 
     hsize_t blockoffsets[2];
     blockoffsets[0] = 0;
     blockoffsets[1] = 0;
 
-    H5::DataSpace mspace(2, blockdims);
-    mspace.selectHyperslab( H5S_SELECT_SET, blockcounts,
+    blockSpace.selectHyperslab( H5S_SELECT_SET, blockcounts,
                 blockoffsets);
-    if (!H5::IdComponent::isValid(mspace.getId()))
+    if (!H5::IdComponent::isValid(blockSpace.getId()))
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Failure to get memory space in Write Block");
@@ -241,18 +211,89 @@ CPLErr IH5RasterBand::IWriteBlock( int nBlockXOff,
     }
 
     poGDS->_dataset->H5::DataSet::write(pImage, writeType,
-            mspace, dspace);
+            blockSpace, dspace);
     if (!H5::IdComponent::isValid(poGDS->_dataset->getId()))
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "Failure to write data in Write Block");
         return CE_Failure;
     }
-    if (H5::IdComponent::isValid(dspace.getId()))
-        dspace.close();
 
-    if (H5::IdComponent::isValid(mspace.getId()))
-        mspace.close();
+    return CE_None;
+}
+
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr IH5RasterBand::IRasterIO( GDALRWFlag eRWFlag,
+                                 int nXOff, int nYOff, int nXSize, int nYSize,
+                                 void * pData, int nBufXSize, int nBufYSize,
+                                 GDALDataType eBufType,
+                                 GSpacing nPixelSpace, GSpacing nLineSpace,
+                                 GDALRasterIOExtraArg * psExtraArg )
+{
+    IH5Dataset *poGDS = static_cast<IH5Dataset *>(poDS);
+    const int nTypeSize = GDALGetDataTypeSize(eDataType) / 8;
+
+    //Only reads of at least a block of lines that span several blocks,
+    //without resampling or type conversion, are coalesced. Everything else
+    //(including line by line reads, which benefit from the cached blocks)
+    //goes through the GDAL block cache.
+    const bool multiBlock =
+        (nXOff / nBlockXSize != (nXOff + nXSize - 1) / nBlockXSize) ||
+        (nYOff / nBlockYSize != (nYOff + nYSize - 1) / nBlockYSize);
+
+    if ( eRWFlag != GF_Read || poGDS->eAccess != GA_ReadOnly ||
+         nXSize != nBufXSize || nYSize != nBufYSize ||
+         eBufType != eDataType || nPixelSpace != nTypeSize ||
+         nLineSpace < nPixelSpace * nBufXSize ||
+         nLineSpace % nTypeSize != 0 ||
+         nYSize < nBlockYSize || !multiBlock )
+    {
+        return GDALPamRasterBand::IRasterIO(eRWFlag, nXOff, nYOff,
+                nXSize, nYSize, pData, nBufXSize, nBufYSize, eBufType,
+                nPixelSpace, nLineSpace, psExtraArg);
+    }
+
+    std::stringstream ss;
+    ss << poGDS->_dataset->getId() << " RasterIO, "
+        << "band=" << nBand << ", "
+        << "starts=(" << nYOff << "," << nXOff << "), "
+        << "counts=(" << nYSize << "," << nXSize << ")";
+    CPLDebug("GDAL_IH5", "%s", ss.str().c_str());
+
+    H5::DataSpace & dspace = poGDS->selectWindow(nBand, nXOff, nYOff,
+                                                 nXSize, nYSize);
+
+    //Memory space with the line stride of the output buffer
+    hsize_t memdims[2];
+    memdims[0] = nYSize;
+    memdims[1] = nLineSpace / nTypeSize;
+
+    hsize_t memcounts[2];
+    memcounts[0] = nYSize;
+    memcounts[1] = nXSize;
+
+    hsize_t memoffsets[2];
+    memoffsets[0] = 0;
+    memoffsets[1] = 0;
+
+    H5::DataSpace mspace(2, memdims);
+    mspace.selectHyperslab( H5S_SELECT_SET, memcounts, memoffsets);
+
+    try
+    {
+        poGDS->_dataset->H5::DataSet::read(pData, poGDS->nativeType,
+                                           mspace, dspace);
+    }
+    catch (const H5::Exception & e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Failure to read data in RasterIO: %s",
+                 e.getDetailMsg().c_str());
+        return CE_Failure;
+    }
 
     return CE_None;
 }
@@ -287,7 +328,8 @@ CPLErr IH5RasterBand::SetNoDataValue( double dfNewValue )
 /*                            IH5Dataset()                              */
 /************************************************************************/
 
-IH5Dataset::IH5Dataset(const hid_t &inputds, GDALAccess eAccessIn ):
+IH5Dataset::IH5Dataset(const hid_t &inputds, GDALAccess eAccessIn,
+                       size_t cacheLines):
     dimensions(), chunks()
 {
     bGeoTransformSet = false;
@@ -332,6 +374,26 @@ IH5Dataset::IH5Dataset(const hid_t &inputds, GDALAccess eAccessIn ):
         return;
     }
 
+    //The default chunk cache (1 MB) cannot hold a row of chunks of most
+    //images, so that reading lines or blocks decompresses the same chunks
+    //again. The cache is set when a dataset is opened, so reopen it.
+    try
+    {
+        const isce3::io::ChunkCache cache = _dataset->getChunkCache(cacheLines);
+        if (cache.nslots > 0)
+        {
+            auto reopened = new isce3::io::IDataSet(_dataset->reopen(cache));
+            _dataset->close();
+            delete _dataset;
+            _dataset = reopened;
+        }
+    }
+    catch (const H5::Exception & e)
+    {
+        CPLDebug("GDAL_IH5", "Keeping the default chunk cache: %s",
+                 e.getCDetailMsg());
+    }
+
     if (populateFromDataset())
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -375,6 +437,31 @@ IH5Dataset::~IH5Dataset()
     }
 }
 
+/************************************************************************/
+/*                            selectWindow()                            */
+/************************************************************************/
+
+H5::DataSpace & IH5Dataset::selectWindow(int band, int xoff, int yoff,
+                                         int xsize, int ysize)
+{
+    int offset = (ndims == 3) ? 1 : 0;
+
+    hsize_t starts[3];
+    hsize_t counts[3];
+
+    //Band axis of a 3D dataset
+    starts[0] = band - 1;
+    counts[0] = 1;
+
+    starts[offset] = yoff;
+    starts[offset+1] = xoff;
+    counts[offset] = ysize;
+    counts[offset+1] = xsize;
+
+    fileSpace.selectHyperslab(H5S_SELECT_SET, counts, starts);
+    return fileSpace;
+}
+
 // Thought this might be handy to pass back to the application
 void * IH5Dataset::GetInternalHandle(const char *)
 {
@@ -557,6 +644,9 @@ CPLErr IH5Dataset::populateFromDataset()
     for(int ii=0; ii < ndims; ii++)
         dimensions[ii] = dims[ii];
 
+    //Keep the file dataspace to select windows in
+    fileSpace = _dataset->getSpace();
+
     nRasterYSize = dimensions[axisOffset];
     nRasterXSize = dimensions[axisOffset+1];
 
@@ -756,7 +846,12 @@ GDALDataset *IH5Dataset::Open( GDALOpenInfo * poOpenInfo )
     const hid_t h5datasetid = atoll(CSLFetchNameValue(papszOptions, "ID"));
     GDALAccess eacc = poOpenInfo->eAccess;
 
-    IH5Dataset *poDS = new IH5Dataset(h5datasetid, eacc);
+    //Number of full lines read at once, for sizing the chunk cache
+    const char *pszLines = CSLFetchNameValue(papszOptions, "LINES");
+    const size_t cacheLines = pszLines ? std::max(atoll(pszLines), 1LL) : 1;
+    CSLDestroy( papszOptions );
+
+    IH5Dataset *poDS = new IH5Dataset(h5datasetid, eacc, cacheLines);
 
     poDS->SetDescription(poOpenInfo->pszFilename);
     return poDS;
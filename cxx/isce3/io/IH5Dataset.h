@@ -47,12 +47,22 @@ class IH5Dataset final: public GDALDataset
     int dimensions[3];
     int chunks[3];
 
+    //File dataspace, reused by all reads and writes
+    H5::DataSpace fileSpace;
+
     protected:
         CPLErr populateFromDataset();
 
+        /** Select a window of a band in the file dataspace */
+        H5::DataSpace & selectWindow(int band, int xoff, int yoff,
+                                     int xsize, int ysize);
+
     public:
-        /**Empty constructor */
-        IH5Dataset(const hid_t &inputds, GDALAccess eAccess);
+        /** Constructor from the id of an open HDF5 dataset. Chunked
+         *  datasets are reopened with a chunk cache sized for reads of
+         *  cacheLines full lines (see IDataSet::getChunkCache) */
+        IH5Dataset(const hid_t &inputds, GDALAccess eAccess,
+                   size_t cacheLines = 1);
 
         /** Destructor */
         virtual ~IH5Dataset();
@@ -112,6 +122,9 @@ class IH5RasterBand : public GDALPamRasterBand
         bool bNoDataSet;
         double dfNoData;
 
+        //Memory dataspace of a block, reused by IReadBlock and IWriteBlock
+        H5::DataSpace blockSpace;
+
     public:
         IH5RasterBand(IH5Dataset *ds, int band, 
                       GDALDataType eTypeIn);
@@ -120,6 +133,13 @@ class IH5RasterBand : public GDALPamRasterBand
 
         virtual CPLErr IReadBlock( int, int, void * ) override;
         virtual CPLErr IWriteBlock( int, int, void * ) override;
+
+        /** Read windows spanning several blocks with a single hyperslab
+         *  read, bypassing the GDAL block cache */
+        virtual CPLErr IRasterIO( GDALRWFlag, int, int, int, int,
+                                  void *, int, int, GDALDataType,
+                                  GSpacing, GSpacing,
+                                  GDALRasterIOExtraArg * ) override;
         virtual double GetNoDataValue( int *pbSuccess = nullptr ) override;
         virtual CPLErr SetNoDataValue( double ) override;
 };
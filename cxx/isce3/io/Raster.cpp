@@ -7,13 +7,448 @@
 //
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
+#include <sys/mman.h>
 #include "Raster.h"
 
 
+/** Bounded pool of read-only dataset handles.
+ *
+ * Each handle is a separate (non-shared) GDALDataset opened from the name
+ * of the shared dataset, so that GDAL never sees the same handle used by two
+ * threads at once. A read checks out a free handle by atomically claiming
+ * its slot, opening it on first use, and returns it when done, so the read
+ * path takes no lock and the number of open handles is bounded by the
+ * number of slots whatever the number of threads. When every slot is busy,
+ * or if the dataset cannot be reopened, reads are serialized on the shared
+ * handle instead. Writes go through the shared handle, so before the next
+ * read through a pooled handle its dirty blocks are flushed and the blocks
+ * cached by the pooled handle are dropped, so that reads never return stale
+ * data. */
+class isce3::io::Raster::ReadHandles {
+public:
+    explicit ReadHandles(GDALDataset * dataset) :
+        _dataset(dataset),
+        _numHandles(std::max(std::thread::hardware_concurrency(), 1u)),
+        _handles(new Handle[_numHandles]) {
+
+        // Make pending writes visible to the new handles
+        _dataset->FlushCache();
+
+        // In-memory datasets do not have a name that can be reopened
+        const std::string name = _dataset->GetDescription();
+        const GDALDriver * driver = _dataset->GetDriver();
+        _reopen = !name.empty() &&
+                  !(driver && std::string(driver->GetDescription()) == "MEM");
+    }
+
+    ~ReadHandles() {
+        for (size_t i = 0; i < _numHandles; ++i) {
+            if (_handles[i].dataset != nullptr)
+                GDALClose(_handles[i].dataset);
+        }
+    }
+
+    ReadHandles(const ReadHandles &) = delete;
+    ReadHandles & operator=(const ReadHandles &) = delete;
+
+    /** Call fn(dataset) with a dataset that the calling thread may read from */
+    template<class Fn>
+    auto apply(Fn && fn) -> decltype(fn(std::declval<GDALDataset*>())) {
+        Handle * handle = _checkout();
+        if (handle != nullptr) {
+            // return the handle to the pool even if fn throws
+            struct Checkin {
+                Handle * handle;
+                ~Checkin() { handle->busy.store(false, std::memory_order_release); }
+            } checkin{handle};
+
+            const uint64_t generation = _flush();
+            if (handle->generation != generation) {
+                handle->dataset->FlushCache();
+                handle->generation = generation;
+            }
+            return fn(handle->dataset);
+        }
+
+        std::lock_guard<std::mutex> lock(_sharedMutex);
+        return fn(_dataset);
+    }
+
+    /** Record a write through the shared dataset */
+    void written() { _writes.fetch_add(1, std::memory_order_acq_rel); }
+
+private:
+    // Pooled handle and the write generation its block cache reflects. The
+    // dataset and generation belong to the thread that set busy.
+    struct Handle {
+        GDALDataset * dataset = nullptr;
+        uint64_t generation = 0;
+        std::atomic<bool> busy {false};
+    };
+
+    // Flush the dirty blocks of the shared dataset if it was written to
+    // since the last flush, and return the current write generation
+    uint64_t _flush() {
+        uint64_t writes = _writes.load(std::memory_order_acquire);
+        if (writes == _flushed.load(std::memory_order_acquire))
+            return writes;
+
+        std::lock_guard<std::mutex> lock(_sharedMutex);
+        writes = _writes.load(std::memory_order_acquire);
+        if (writes != _flushed.load(std::memory_order_relaxed)) {
+            _dataset->FlushCache();
+            _flushed.store(writes, std::memory_order_release);
+        }
+        return writes;
+    }
+
+    // Claim a free handle, opening it if needed, or return null if there is
+    // none
+    Handle * _checkout() {
+        if (!_reopen.load(std::memory_order_relaxed))
+            return nullptr;
+
+        // start from a slot that depends on the thread, so that threads
+        // tend to claim different slots (and reuse the same one)
+        const size_t start = std::hash<std::thread::id>()(
+                std::this_thread::get_id()) % _numHandles;
+        for (size_t k = 0; k < _numHandles; ++k) {
+            Handle & handle = _handles[(start + k) % _numHandles];
+            bool busy = false;
+            if (handle.busy.load(std::memory_order_relaxed) ||
+                !handle.busy.compare_exchange_strong(
+                        busy, true, std::memory_order_acquire))
+                continue;
+
+            if (handle.dataset == nullptr && !_open(handle)) {
+                handle.busy.store(false, std::memory_order_release);
+                return nullptr;
+            }
+            return &handle;
+        }
+        return nullptr;
+    }
+
+    // Open the dataset of a claimed handle, returning whether it was opened
+    bool _open(Handle & handle) {
+        auto dataset = static_cast<GDALDataset*>(GDALOpenEx(
+                _dataset->GetDescription(), GDAL_OF_RASTER | GDAL_OF_READONLY,
+                nullptr, nullptr, nullptr));
+
+        // Only accept a handle that looks like the dataset it replaces
+        if (dataset != nullptr &&
+            (dataset->GetRasterXSize() != _dataset->GetRasterXSize() ||
+             dataset->GetRasterYSize() != _dataset->GetRasterYSize() ||
+             dataset->GetRasterCount() != _dataset->GetRasterCount())) {
+            GDALClose(dataset);
+            dataset = nullptr;
+        }
+
+        if (dataset == nullptr) {
+            _reopen.store(false, std::memory_order_relaxed);
+            return false;
+        }
+
+        // the new handle sees every write flushed so far
+        handle.dataset = dataset;
+        handle.generation = _flushed.load(std::memory_order_acquire);
+        return true;
+    }
+
+    GDALDataset * _dataset;
+    std::atomic<bool> _reopen;
+    size_t _numHandles;
+    std::unique_ptr<Handle[]> _handles;
+    std::mutex _sharedMutex;
+    std::atomic<uint64_t> _writes {0}, _flushed {0};
+};
+
+
+/** Sharded LRU cache of decoded tiles.
+ *
+ * Tiles are keyed by band and tile indices and spread over shards by a hash
+ * of the key. A lookup holds its shard lock in shared mode and records the
+ * use of a tile by ticking an atomic shard clock into the tile's atomic
+ * stamp, so concurrent hits never serialize, even on the same shard. Tiles
+ * are decoded outside of the lock, and inserting a tile takes the shard lock
+ * exclusively to evict the tiles with the oldest stamps until the shard fits
+ * in its share of the memory budget. */
+class isce3::io::Raster::BlockCache {
+public:
+    BlockCache(GDALDataset * dataset, size_t tileWidth, size_t tileLength,
+               size_t maxBytes, size_t numShards) :
+        _dataset(dataset),
+        _tileWidth(tileWidth > 0 ? tileWidth : dataset->GetRasterXSize()),
+        _tileLength(std::max<size_t>(tileLength, 1)),
+        _numShards(std::max<size_t>(numShards, 1)),
+        _shardBytes(maxBytes / _numShards),
+        _shards(new Shard[_numShards]) {}
+
+    BlockCache(const BlockCache &) = delete;
+    BlockCache & operator=(const BlockCache &) = delete;
+
+    /** Read a window of a band into buffer through the cache */
+    CPLErr read(ReadHandles * handles, size_t band, size_t xidx, size_t yidx,
+                size_t iowidth, size_t iolength, void * buffer,
+                GDALDataType dtype, GSpacing pixelspace, GSpacing linespace) {
+
+        if (iowidth == 0 || iolength == 0)
+            return CE_None;
+        if (xidx + iowidth > size_t(_dataset->GetRasterXSize()) ||
+            yidx + iolength > size_t(_dataset->GetRasterYSize()))
+            return CE_Failure;
+
+        if (pixelspace == 0)
+            pixelspace = GDALGetDataTypeSizeBytes(dtype);
+        if (linespace == 0)
+            linespace = pixelspace * iowidth;
+
+        const size_t tx0 = xidx / _tileWidth;
+        const size_t tx1 = (xidx + iowidth - 1) / _tileWidth;
+        const size_t ty0 = yidx / _tileLength;
+        const size_t ty1 = (yidx + iolength - 1) / _tileLength;
+
+        for (size_t ty = ty0; ty <= ty1; ++ty) {
+            for (size_t tx = tx0; tx <= tx1; ++tx) {
+
+                CPLErr status = CE_None;
+                auto tile = _tile(handles, band, tx, ty, status);
+                if (tile == nullptr)
+                    return status;
+
+                // overlap of the tile with the requested window
+                const size_t x0 = std::max(xidx, tile->x0);
+                const size_t x1 = std::min(xidx + iowidth,
+                                           tile->x0 + tile->width);
+                const size_t y0 = std::max(yidx, tile->y0);
+                const size_t y1 = std::min(yidx + iolength,
+                                           tile->y0 + tile->length);
+
+                const size_t tileTypeSize =
+                        GDALGetDataTypeSizeBytes(tile->dtype);
+                for (size_t y = y0; y < y1; ++y) {
+                    const unsigned char * src = tile->data.data() +
+                            ((y - tile->y0) * tile->width + (x0 - tile->x0)) *
+                            tileTypeSize;
+                    unsigned char * dst = static_cast<unsigned char *>(buffer) +
+                            (y - yidx) * linespace + (x0 - xidx) * pixelspace;
+                    GDALCopyWords(src, tile->dtype, tileTypeSize,
+                                  dst, dtype, static_cast<int>(pixelspace),
+                                  static_cast<int>(x1 - x0));
+                }
+            }
+        }
+        return CE_None;
+    }
+
+    /** Drop the tiles of a band that overlap a window */
+    void invalidate(size_t band, size_t xidx, size_t yidx,
+                    size_t iowidth, size_t iolength) {
+        if (iowidth == 0 || iolength == 0)
+            return;
+        for (size_t ty = yidx / _tileLength;
+             ty <= (yidx + iolength - 1) / _tileLength; ++ty) {
+            for (size_t tx = xidx / _tileWidth;
+                 tx <= (xidx + iowidth - 1) / _tileWidth; ++tx) {
+                const uint64_t key = _key(band, tx, ty);
+                Shard & shard = _shard(key);
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                auto it = shard.tiles.find(key);
+                if (it != shard.tiles.end())
+                    shard.erase(it);
+            }
+        }
+    }
+
+    BlockCacheStats stats() const {
+        BlockCacheStats stats;
+        for (size_t i = 0; i < _numShards; ++i) {
+            const Shard & shard = _shards[i];
+            stats.hits += shard.hits.load(std::memory_order_relaxed);
+            stats.misses += shard.misses.load(std::memory_order_relaxed);
+            stats.evictions += shard.evictions.load(std::memory_order_relaxed);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            stats.bytes += shard.bytes;
+        }
+        return stats;
+    }
+
+private:
+    struct Tile {
+        size_t x0, y0, width, length;
+        GDALDataType dtype;
+        std::vector<unsigned char> data;
+    };
+
+    // Cached tile and the shard clock at its last use
+    struct Entry {
+        Entry(std::shared_ptr<const Tile> tile, uint64_t stamp) :
+            tile(std::move(tile)), stamp(stamp) {}
+
+        std::shared_ptr<const Tile> tile;
+        std::atomic<uint64_t> stamp;
+    };
+
+    using TileMap = std::unordered_map<uint64_t, Entry>;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        TileMap tiles;
+        size_t bytes = 0;
+        std::atomic<uint64_t> clock {0};
+        std::atomic<size_t> hits {0}, misses {0}, evictions {0};
+
+        void erase(TileMap::iterator it) {
+            bytes -= it->second.tile->data.size();
+            tiles.erase(it);
+        }
+
+        // Least recently used tile (the shard must not be empty)
+        TileMap::iterator oldest() {
+            auto oldest = tiles.begin();
+            for (auto it = tiles.begin(); it != tiles.end(); ++it) {
+                if (it->second.stamp.load(std::memory_order_relaxed) <
+                    oldest->second.stamp.load(std::memory_order_relaxed))
+                    oldest = it;
+            }
+            return oldest;
+        }
+    };
+
+    static uint64_t _key(size_t band, size_t tx, size_t ty) {
+        return (uint64_t(band) << 48) | (uint64_t(ty) << 24) | uint64_t(tx);
+    }
+
+    Shard & _shard(uint64_t key) {
+        // spread neighboring tiles over the shards
+        const uint64_t hash = key * 0x9e3779b97f4a7c15ull;
+        return _shards[(hash >> 32) % _numShards];
+    }
+
+    std::shared_ptr<const Tile> _tile(ReadHandles * handles, size_t band,
+                                      size_t tx, size_t ty, CPLErr & status) {
+        const uint64_t key = _key(band, tx, ty);
+        Shard & shard = _shard(key);
+
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.tiles.find(key);
+            if (it != shard.tiles.end()) {
+                // only tick the clock if another tile was used since, so
+                // that repeated hits on a hot tile do not write to it
+                auto & stamp = it->second.stamp;
+                if (stamp.load(std::memory_order_relaxed) !=
+                    shard.clock.load(std::memory_order_relaxed)) {
+                    stamp.store(shard.clock.fetch_add(
+                            1, std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+                }
+                shard.hits.fetch_add(1, std::memory_order_relaxed);
+                return it->second.tile;
+            }
+        }
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+
+        // decode the tile outside of the shard lock
+        auto tile = std::make_shared<Tile>();
+        tile->x0 = tx * _tileWidth;
+        tile->y0 = ty * _tileLength;
+        tile->width = std::min<size_t>(_tileWidth,
+                _dataset->GetRasterXSize() - tile->x0);
+        tile->length = std::min<size_t>(_tileLength,
+                _dataset->GetRasterYSize() - tile->y0);
+        tile->dtype = _dataset->GetRasterBand(band)->GetRasterDataType();
+        tile->data.resize(tile->width * tile->length *
+                          GDALGetDataTypeSizeBytes(tile->dtype));
+
+        auto io = [&](GDALDataset * ds) {
+            return ds->GetRasterBand(band)->RasterIO(
+                    GF_Read, tile->x0, tile->y0, tile->width, tile->length,
+                    tile->data.data(), tile->width, tile->length,
+                    tile->dtype, 0, 0);
+        };
+        if (handles != nullptr) {
+            status = handles->apply(io);
+        } else {
+            std::lock_guard<std::mutex> lock(_ioMutex);
+            status = io(_dataset);
+        }
+        if (status != CE_None)
+            return nullptr;
+
+        const size_t tileBytes = tile->data.size();
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        // another thread may have inserted the same tile meanwhile
+        auto it = shard.tiles.find(key);
+        if (it != shard.tiles.end())
+            return it->second.tile;
+
+        // tiles larger than the shard budget are not kept
+        if (tileBytes > _shardBytes)
+            return tile;
+
+        while (shard.bytes + tileBytes > _shardBytes) {
+            shard.erase(shard.oldest());
+            shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const uint64_t now =
+                shard.clock.fetch_add(1, std::memory_order_relaxed) + 1;
+        shard.tiles.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(key),
+                            std::forward_as_tuple(tile, now));
+        shard.bytes += tileBytes;
+        return tile;
+    }
+
+    GDALDataset * _dataset;
+    size_t _tileWidth, _tileLength, _numShards, _shardBytes;
+    std::unique_ptr<Shard[]> _shards;
+    std::mutex _ioMutex;
+};
+
+
+/** Memory maps of the bands of a dataset, created on first use */
+class isce3::io::Raster::MemoryMaps {
+public:
+    const isce3::io::gdal::detail::MemoryMap & get(GDALDataset * dataset,
+                                                   size_t band) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _maps.find(band);
+        if (it == _maps.end()) {
+            isce3::io::gdal::detail::MemoryMap mmap(
+                    dataset->GetRasterBand(band), dataset->GetAccess());
+            it = _maps.emplace(band, mmap).first;
+        }
+        return it->second;
+    }
+
+    const isce3::io::gdal::detail::MemoryMap * find(size_t band) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _maps.find(band);
+        return it == _maps.end() ? nullptr : &it->second;
+    }
+
+private:
+    std::map<size_t, isce3::io::gdal::detail::MemoryMap> _maps;
+    std::mutex _mutex;
+};
+
+
 /**
  * @param[in] fname Existing filename
  * @param[in] access GDAL access mode
@@ -115,6 +550,139 @@ isce3::io::Raster::Raster(const Raster &rast) {
 
     dataset( rast._dataset );
     dataset()->Reference();
+    _readHandles = rast._readHandles;
+    _blockCache = rast._blockCache;
+    _memmaps = rast._memmaps;
+}
+
+
+/**
+ * @param[in] flag Enable (true) or disable (false) concurrent reads
+ *
+ * Enabling flushes the dataset cache so that previously written data is
+ * visible to the pooled handles. Copies of this raster made afterwards
+ * share the same handles.*/
+void isce3::io::Raster::concurrentReads(bool flag) {
+    if (!flag)
+        _readHandles.reset();
+    else if (!_readHandles)
+        _readHandles = std::make_shared<ReadHandles>(_dataset);
+}
+
+
+CPLErr isce3::io::Raster::_rasterIO(GDALRWFlag iodir, size_t band,
+                                    size_t xidx, size_t yidx,
+                                    size_t iowidth, size_t iolength,
+                                    void * buffer, GDALDataType dtype,
+                                    GSpacing pixelspace, GSpacing linespace) {
+
+    auto io = [&](GDALDataset * ds) {
+        return ds->GetRasterBand(band)->RasterIO(iodir, xidx, yidx, iowidth,
+                                                 iolength, buffer, iowidth,
+                                                 iolength, dtype, pixelspace,
+                                                 linespace);
+    };
+
+    if (iodir == GF_Read && _blockCache)
+        return _blockCache->read(_readHandles.get(), band, xidx, yidx, iowidth,
+                                 iolength, buffer, dtype, pixelspace,
+                                 linespace);
+    if (iodir == GF_Read && _readHandles)
+        return _readHandles->apply(io);
+
+    const CPLErr status = io(_dataset);
+    if (iodir == GF_Write && _readHandles)
+        _readHandles->written();
+    if (iodir == GF_Write && _blockCache)
+        _blockCache->invalidate(band, xidx, yidx, iowidth, iolength);
+    return status;
+}
+
+
+/**
+ * @param[in] flag Enable (true) or disable (false) the tile cache
+ * @param[in] tileWidth Tile width in pixels (0 for the raster width)
+ * @param[in] tileLength Tile length in lines
+ * @param[in] maxBytes Memory budget in bytes, split evenly over the shards
+ * @param[in] numShards Number of shards
+ *
+ * Enabling flushes the dataset cache so that previously written data is
+ * visible to the tile reads. Copies of this raster made afterwards share the
+ * same cache.*/
+void isce3::io::Raster::blockCache(bool flag, size_t tileWidth,
+                                   size_t tileLength, size_t maxBytes,
+                                   size_t numShards) {
+    if (!flag) {
+        _blockCache.reset();
+        return;
+    }
+    _dataset->FlushCache();
+    _blockCache = std::make_shared<BlockCache>(_dataset, tileWidth,
+                                               tileLength, maxBytes,
+                                               numShards);
+}
+
+
+isce3::io::Raster::BlockCacheStats
+isce3::io::Raster::blockCacheStats() const {
+    return _blockCache ? _blockCache->stats() : BlockCacheStats();
+}
+
+
+isce3::io::gdal::Buffer isce3::io::Raster::_memmap(size_t band) {
+    if (band < 1 || band > numBands()) {
+        throw isce3::except::OutOfRange(ISCE_SRCINFO(), "band index out of range");
+    }
+
+    // make pending writes visible through the mapping
+    _dataset->FlushCache();
+
+    if (!_memmaps)
+        _memmaps = std::make_shared<MemoryMaps>();
+    const auto & mmap = _memmaps->get(_dataset, band);
+
+    std::array<int, 2> shape = {int(length()), int(width())};
+    std::array<std::size_t, 2> strides = {mmap.rowstride(), mmap.colstride()};
+    return isce3::io::gdal::Buffer(const_cast<void *>(mmap.data()), dtype(band),
+                                   shape, strides, access());
+}
+
+
+/**
+ * @param[in] advice Expected access pattern
+ * @param[in] yidx First line (0-based)
+ * @param[in] nlines Number of lines
+ * @param[in] band Band index (1-based)*/
+void isce3::io::Raster::memmapAdvise(MemmapAdvice advice, size_t yidx,
+                                     size_t nlines, size_t band) {
+    const auto * mmap = _memmaps ? _memmaps->find(band) : nullptr;
+    if (mmap == nullptr)
+        return;
+
+    int posixAdvice = POSIX_MADV_NORMAL;
+    switch (advice) {
+        case MEMMAP_SEQUENTIAL: posixAdvice = POSIX_MADV_SEQUENTIAL; break;
+        case MEMMAP_RANDOM:     posixAdvice = POSIX_MADV_RANDOM;     break;
+        case MEMMAP_WILLNEED:   posixAdvice = POSIX_MADV_WILLNEED;   break;
+        case MEMMAP_DONTNEED:   posixAdvice = POSIX_MADV_DONTNEED;   break;
+        default: break;
+    }
+    mmap->advise(yidx * mmap->rowstride(), nlines * mmap->rowstride(),
+                 posixAdvice);
+}
+
+
+/**
+ * @param[in] arr pointer to buffer of 6 double precision numbers
+ *
+ * No memory check is performed*/
+void isce3::io::Raster::getGeoTransform(double *arr) const
+{
+    auto get = [arr](GDALDataset * ds) { return ds->GetGeoTransform(arr); };
+    int status = _readHandles ? _readHandles->apply(get) : get(_dataset);
+    if (status != 0) {
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), "Could not fetch GDAL GeoTransform");
+    }
 }
 
 
@@ -142,7 +710,12 @@ isce3::io::Raster::Raster(const std::string& fname, const std::vector<Raster>& r
 int isce3::io::Raster::getEPSG()
 {
     //Extract WKT string corresponding to the dataset
-    const char* pszProjection = GDALGetProjectionRef(_dataset);
+    auto getWkt = [](GDALDataset * ds) {
+        const char* wkt = GDALGetProjectionRef(ds);
+        return std::string(wkt == nullptr ? "" : wkt);
+    };
+    const std::string wkt = _readHandles ? _readHandles->apply(getWkt) : getWkt(_dataset);
+    const char* pszProjection = wkt.c_str();
 
     //If WKT string is not empty
     if (pszProjection == nullptr || strlen(pszProjection) <= 0)
@@ -231,8 +804,13 @@ int isce3::io::Raster::setEPSG(int epsgcode)
     return status;
 }
 // Destructor. When GDALOpenShared() is used the dataset is dereferenced
-// and closed only if the referenced count is less than 1.
+// and closed only if the referenced count is less than 1. The memory maps,
+// tile cache and read handles are released first, since GDAL requires
+// virtual memory mappings to be freed before their dataset is closed.
 isce3::io::Raster::~Raster() {
+    _memmaps.reset();
+    _blockCache.reset();
+    _readHandles.reset();
     if (_owner) {
         GDALClose( _dataset );
     }
@@ -11,6 +11,7 @@
 
 #include <complex>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
@@ -100,7 +101,7 @@ class isce3::io::Raster {
       /** GDALDataset pointer setter
        *
        * @param[in] ds GDALDataset pointer*/
-      inline void         dataset(GDALDataset* ds) { _dataset=ds; }
+      inline void         dataset(GDALDataset* ds) { _dataset=ds; _readHandles.reset(); _blockCache.reset(); _memmaps.reset(); }
 
       /** Return GDALDatatype of specified band
        *
@@ -125,6 +126,95 @@ class isce3::io::Raster {
       inline void         addRawBandToVRT(const std::string &fname, GDALDataType dtype);
       //void close() { GDALClose( _dataset ); }  // todo: fix segfault conflict with destructor
 
+      /** Enable or disable thread-safe concurrent reads
+       *
+       * When enabled, reads issued from different threads (e.g. inside an
+       * OpenMP parallel region) are served by separate read-only GDAL dataset
+       * handles, checked out of a pool of one handle per hardware thread, and
+       * do not need to be serialized by the caller. Reads that find every
+       * handle busy, and reads of datasets that cannot be reopened by name
+       * (e.g. MEM datasets), are serialized on the shared handle. Writes are
+       * not affected and must still be serialized by the caller. Writes made
+       * through this raster are flushed before the next pooled read, so
+       * readers see them.
+       *
+       * @param[in] flag True to enable, false to close the pooled handles*/
+      void concurrentReads(bool flag);
+
+      /** Check whether thread-safe concurrent reads are enabled */
+      inline bool         concurrentReads() const { return _readHandles != nullptr; }
+
+      /** Hit/miss statistics of the tile cache */
+      struct BlockCacheStats {
+          size_t hits = 0;      ///< tile lookups served from the cache
+          size_t misses = 0;    ///< tile lookups read from the dataset
+          size_t evictions = 0; ///< tiles dropped to stay within the budget
+          size_t bytes = 0;     ///< size of the cached tiles in bytes
+      };
+
+      /** Enable or disable a read-only cache of decoded tiles
+       *
+       * When enabled, reads are served from a sharded LRU cache of tiles of
+       * tileLength lines by tileWidth pixels, stored in the native data type
+       * of each band. Hits lock their shard in shared mode and record the
+       * use of the tile atomically, so concurrent readers never serialize on
+       * a hit; only inserting a missed tile locks its shard exclusively.
+       * Tiles that miss are read
+       * through the pooled handles if concurrent reads are enabled, and
+       * serialized on the shared dataset otherwise. Writes through this
+       * raster invalidate the tiles they overlap.
+       *
+       * @param[in] flag       True to enable, false to drop the cache
+       * @param[in] tileWidth  Tile width in pixels (0 for the raster width)
+       * @param[in] tileLength Tile length in lines
+       * @param[in] maxBytes   Memory budget of the cache in bytes
+       * @param[in] numShards  Number of independently locked shards*/
+      void blockCache(bool flag, size_t tileWidth = 0, size_t tileLength = 64,
+                      size_t maxBytes = 256 << 20, size_t numShards = 16);
+
+      /** Check whether the tile cache is enabled */
+      inline bool         blockCache() const { return _blockCache != nullptr; }
+
+      /** Get hit/miss statistics of the tile cache (zero if disabled) */
+      BlockCacheStats     blockCacheStats() const;
+
+      /** Expected access pattern of a memory-mapped band */
+      enum MemmapAdvice { MEMMAP_NORMAL, MEMMAP_SEQUENTIAL, MEMMAP_RANDOM,
+                          MEMMAP_WILLNEED, MEMMAP_DONTNEED };
+
+      /** Memory-map a band of an uncompressed raster
+       *
+       * For flat binary rasters on local disk (ENVI, or VRT with raw bands)
+       * GDAL maps the file itself, so that pixels can be read (and written,
+       * in update mode) in place instead of being copied by getBlock and
+       * setBlock. The mapping is created on first use, is shared by copies of
+       * this raster and stays valid while any of them is alive.
+       *
+       * @param[in] band Band index (1-based)
+       * @returns Strided, typed view of the whole band
+       * @throws isce3::except::RuntimeError if the band cannot be memory
+       * mapped or T does not match its data type */
+      template<typename T> isce3::io::gdal::TypedBuffer<T> memmap(size_t band = 1);
+
+      /** Non-owning Matrix over a memory-mapped band
+       *
+       * @param[in] band Band index (1-based)
+       * @throws isce3::except::RuntimeError if the band cannot be memory
+       * mapped, T does not match its data type or its pixels are not
+       * contiguous in row-major order */
+      template<typename T> isce3::core::Matrix<T> memmapMatrix(size_t band = 1);
+
+      /** Hint the expected access to lines [yidx, yidx + nlines) of a
+       * memory-mapped band, e.g. MEMMAP_WILLNEED for the next block to be
+       * processed. Does nothing if the band is not memory mapped.
+       *
+       * @param[in] advice  Access pattern
+       * @param[in] yidx    First line (0-based)
+       * @param[in] nlines  Number of lines
+       * @param[in] band    Band index (1-based)*/
+      void memmapAdvise(MemmapAdvice advice, size_t yidx, size_t nlines,
+                        size_t band = 1);
+
       //Pixel read/write with buffer passed by reference, optional band index
       /** Get/Set single value for given band */
       template<typename T> void getSetValue(T& buffer, size_t xidz, size_t yidx, size_t band, GDALRWFlag);
@@ -175,7 +265,7 @@ class isce3::io::Raster {
       inline void setGeoTransform(std::vector<double>&);
       inline void setGeoTransform(std::valarray<double>&);
       /** Copy Raster GeoTransform into a buffer, vector, or valarray */
-      inline void getGeoTransform(double *) const;
+      void getGeoTransform(double *) const;
       inline void getGeoTransform(std::vector<double>&) const;
       inline void getGeoTransform(std::valarray<double>&) const;
       //Read only functions for specific elements of GeoTransform
@@ -189,8 +279,31 @@ class isce3::io::Raster {
       inline double dy() const;
 
 private:
+    /** Pool of read-only dataset handles used for concurrent reads */
+    class ReadHandles;
+
+    /** Sharded LRU cache of decoded tiles */
+    class BlockCache;
+
+    /** Memory maps of the bands of the dataset */
+    class MemoryMaps;
+
+    /** Memory-map a band and describe the mapping */
+    isce3::io::gdal::Buffer _memmap(size_t band);
+
+    /** Forward a RasterIO request to the shared dataset, or for reads with
+     * concurrent reads enabled, to a read-only handle of the pool.
+     * Reads go through the tile cache if it is enabled. */
+    CPLErr _rasterIO(GDALRWFlag iodir, size_t band, size_t xidx, size_t yidx,
+                     size_t iowidth, size_t iolength, void* buffer,
+                     GDALDataType dtype, GSpacing pixelspace = 0,
+                     GSpacing linespace = 0);
+
     GDALDataset * _dataset;
     bool _owner = true;
+    std::shared_ptr<ReadHandles> _readHandles;
+    std::shared_ptr<BlockCache> _blockCache;
+    std::shared_ptr<MemoryMaps> _memmaps;
 };
 
 #define ISCE_IO_RASTER_ICC
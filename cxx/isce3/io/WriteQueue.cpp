@@ -0,0 +1,92 @@
+#include "WriteQueue.h"
+
+#include <utility>
+
+#include <isce3/except/Error.h>
+
+namespace isce3 { namespace io {
+
+WriteQueue::WriteQueue(std::size_t maxPending)
+:
+    _maxPending(maxPending)
+{
+    if (maxPending == 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "write queue size must be > 0");
+    }
+
+    _thread = std::thread(&WriteQueue::_run, this);
+}
+
+WriteQueue::~WriteQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _notEmpty.notify_all();
+    _thread.join();
+}
+
+void WriteQueue::push(Task task)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _notFull.wait(lock, [this] { return _tasks.size() < _maxPending; });
+    _tasks.push_back(std::move(task));
+    lock.unlock();
+    _notEmpty.notify_one();
+}
+
+void WriteQueue::flush()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this] { return _tasks.empty() and _busy == 0; });
+
+    if (_error) {
+        auto error = _error;
+        _error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void WriteQueue::_run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _notEmpty.wait(lock, [this] { return _stop or not _tasks.empty(); });
+        if (_tasks.empty()) {
+            // stop requested and all writes done
+            return;
+        }
+
+        Task task = std::move(_tasks.front());
+        _tasks.pop_front();
+        _busy = 1;
+        const bool failed = static_cast<bool>(_error);
+        lock.unlock();
+        _notFull.notify_one();
+
+        // skip remaining writes after the first failure
+        std::exception_ptr error;
+        if (not failed) {
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        // release captured data before reporting completion
+        task = nullptr;
+
+        lock.lock();
+        _busy = 0;
+        if (error and not _error) {
+            _error = error;
+        }
+        if (_tasks.empty()) {
+            _idle.notify_all();
+        }
+    }
+}
+
+}}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "forward.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <isce3/core/Matrix.h>
+
+#include "Raster.h"
+
+namespace isce3 { namespace io {
+
+/**
+ * Ordered queue of raster writes executed on a dedicated writer thread.
+ *
+ * Compute threads hand finished blocks over to the queue instead of writing
+ * them in place, so that output I/O neither blocks computation nor needs to
+ * be serialized with critical sections. Writes are executed one at a time in
+ * the order in which they were submitted, which makes the queue the only
+ * writer to its target datasets.
+ *
+ * The number of queued writes is bounded: push() blocks while the queue is
+ * full so that memory usage stays predictable when computation outpaces I/O.
+ * Target rasters must outlive all writes submitted to the queue.
+ */
+class WriteQueue {
+public:
+
+    /** Write task */
+    using Task = std::function<void()>;
+
+    /**
+     * Start the writer thread.
+     *
+     * \param[in] maxPending Maximum number of queued writes
+     */
+    explicit WriteQueue(std::size_t maxPending = 16);
+
+    /**
+     * Complete all queued writes and stop the writer thread.
+     *
+     * Errors raised by writes that were not observed by flush() are discarded.
+     */
+    ~WriteQueue();
+
+    WriteQueue(const WriteQueue &) = delete;
+    WriteQueue & operator=(const WriteQueue &) = delete;
+
+    /**
+     * Submit a write task.
+     *
+     * Safe to call concurrently from multiple threads. Once a task has
+     * thrown, subsequent tasks are discarded until the exception has been
+     * rethrown by flush().
+     *
+     * \param[in] task Write to execute on the writer thread
+     */
+    void push(Task task);
+
+    /**
+     * Submit a block write from a matrix, taking ownership of the data.
+     *
+     * \param[in] raster    Output raster
+     * \param[in] data      Block data, of at least iowidth * iolength elements
+     * \param[in] xidx      Pixel index of the block (0-based)
+     * \param[in] yidx      Line index of the block (0-based)
+     * \param[in] iowidth   Number of pixels to write
+     * \param[in] iolength  Number of lines to write
+     * \param[in] band      Band index (1-based)
+     */
+    template<typename T>
+    void setBlock(Raster & raster, std::unique_ptr<isce3::core::Matrix<T>> data,
+                  std::size_t xidx, std::size_t yidx, std::size_t iowidth,
+                  std::size_t iolength, std::size_t band = 1)
+    {
+        // std::function requires a copyable callable
+        std::shared_ptr<isce3::core::Matrix<T>> block = std::move(data);
+        push([&raster, block, xidx, yidx, iowidth, iolength, band]() {
+            raster.setBlock(block->data(), xidx, yidx, iowidth, iolength, band);
+        });
+    }
+
+    /**
+     * Block until all submitted writes have completed.
+     *
+     * Rethrows the first exception raised by a write, if any.
+     */
+    void flush();
+
+private:
+    void _run();
+
+    std::size_t _maxPending;
+    std::deque<Task> _tasks;
+    std::size_t _busy = 0;
+    bool _stop = false;
+    std::exception_ptr _error;
+
+    std::mutex _mutex;
+    std::condition_variable _notEmpty;
+    std::condition_variable _notFull;
+    std::condition_variable _idle;
+
+    std::thread _thread;
+};
+
+}}
@@ -3,4 +3,5 @@
 namespace isce3 { namespace io {
 
     class Raster;
+    class WriteQueue;
 }}
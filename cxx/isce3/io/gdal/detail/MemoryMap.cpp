@@ -1,5 +1,9 @@
 #include "MemoryMap.h"
 
+#include <algorithm>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <isce3/except/Error.h>
 
 namespace isce3 { namespace io { namespace gdal { namespace detail {
@@ -28,4 +32,18 @@ MemoryMap::MemoryMap(GDALRasterBand * raster, GDALAccess access)
     _rowstride = std::size_t(rowstride);
 }
 
+void MemoryMap::advise(std::size_t offset, std::size_t length, int advice) const
+{
+    if (!_mmap || offset >= size()) {
+        return;
+    }
+    length = std::min(length, size() - offset);
+
+    const std::size_t pagesize = std::size_t(sysconf(_SC_PAGESIZE));
+    const std::size_t begin = reinterpret_cast<std::size_t>(data()) + offset;
+    const std::size_t first = begin / pagesize * pagesize;
+
+    posix_madvise(reinterpret_cast<void *>(first), begin + length - first, advice);
+}
+
 }}}}
@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "../forward.h"
+#include "../../forward.h"
 
 namespace isce3 { namespace io { namespace gdal { namespace detail {
 
@@ -33,7 +34,12 @@ public:
     // Stride in bytes between the start of adjacent rows
     std::size_t rowstride() const { return _rowstride; }
 
+    // Pass a posix_madvise() hint for a byte range of the mapping
+    // (the range is widened to page boundaries; failures are ignored)
+    void advise(std::size_t offset, std::size_t length, int advice) const;
+
     friend class isce3::io::gdal::Raster;
+    friend class isce3::io::Raster;
 
 private:
 
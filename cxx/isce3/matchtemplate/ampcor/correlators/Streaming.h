@@ -0,0 +1,116 @@
+// -*- C++ -*-
+// -*- coding: utf-8 -*-
+//
+// michael a.g. aïvázis <michael.aivazis@para-sim.com>
+// parasim
+// (c) 1998-2019 all rights reserved
+//
+
+// code guard
+#if !defined(ampcor_libampcor_correlators_Streaming_h)
+#define ampcor_libampcor_correlators_Streaming_h
+
+#include <functional>
+#include <memory>
+
+
+// out-of-core computation of a dense offset field: the tile pairs are streamed from the
+// rasters through a pair of {Sequential} workers in batches sized to fit a memory budget; the
+// tiles of the next batch are extracted while the current one is being correlated, and the
+// offsets of each batch are handed to the caller as soon as they are available
+template <typename raster_t>
+class ampcor::correlators::Streaming {
+    // types
+public:
+    // my client raster type
+    using raster_type = raster_t;
+    // the workers
+    using worker_type = Sequential<raster_t>;
+    // the underlying pixel complex type
+    using cell_type = typename raster_type::cell_type;
+    // the support of the pixel complex type
+    using value_type = typename cell_type::value_type;
+    // for describing slices of rasters
+    using slice_type = typename raster_type::slice_type;
+    // for describing the shapes of tiles
+    using shape_type = typename raster_type::shape_type;
+    // for describing the layouts of tiles
+    using layout_type = typename raster_type::layout_type;
+    // for index arithmetic
+    using index_type = typename raster_type::index_type;
+    // for sizing things
+    using size_type = typename raster_type::size_type;
+
+    // the sink for the offset field: receives the index of the first pair of a batch, the
+    // number of pairs in the batch, and their (row, column) offsets; pairs are numbered in
+    // row major order over the offset grid
+    using writer_type =
+        std::function<void(size_type first, size_type pairs, const value_type * offsets)>;
+
+    // interface
+public:
+    // compute the offset field of the target raster relative to the reference raster
+    inline void adjust(const raster_type & ref, const raster_type & tgt,
+                       const writer_type & writer) const;
+
+    // accessors
+    // the total number of tile pairs
+    inline auto pairs() const -> size_type;
+    // the number of pairs correlated at a time
+    inline auto batch() const -> size_type;
+    // the number of batches
+    inline auto batches() const -> size_type;
+
+    // an upper bound on the memory used by each pair in a batch, including the scratch space
+    // of the correlation pipeline
+    inline static auto footprint(const layout_type & refLayout, const layout_type & tgtLayout,
+                                 size_type refineFactor=2, size_type refineMargin=8,
+                                 size_type zoomFactor=4) -> size_type;
+
+    // meta-methods
+public:
+    // the reference tiles are placed on a grid of {gridShape} points, the first one with its
+    // upper left hand corner at {origin} and the rest {step} pixels apart; each target tile is
+    // centered on its reference tile; at most {memory} bytes are used at any one time
+    inline Streaming(const layout_type & refLayout, const layout_type & tgtLayout,
+                     const index_type & origin, const index_type & step,
+                     const shape_type & gridShape,
+                     size_type memory,
+                     size_type refineFactor=2, size_type refineMargin=8,
+                     size_type zoomFactor=4);
+
+    // implementation details: methods
+public:
+    // extract the tiles of {count} pairs starting at {first} into {worker}
+    inline void _load(worker_type & worker, const raster_type & ref, const raster_type & tgt,
+                      size_type first, size_type count) const;
+
+    // implementation details: data
+private:
+    // the shape of the reference tiles
+    const layout_type _refLayout;
+    // the shape of the search windows in the target image
+    const layout_type _tgtLayout;
+    // the location of the first reference tile
+    const index_type _origin;
+    // the distance between reference tiles
+    const index_type _step;
+    // the shape of the offset grid
+    const shape_type _gridShape;
+
+    // the refinement parameters of the workers
+    const size_type _refineFactor;
+    const size_type _refineMargin;
+    const size_type _zoomFactor;
+
+    // the total number of pairs
+    const size_type _pairs;
+    // the number of pairs per batch
+    const size_type _batch;
+};
+
+
+// code guard
+#endif
+
+// end of file
@@ -0,0 +1,257 @@
+// -*- C++ -*-
+// -*- coding: utf-8 -*-
+//
+// michael a.g. aïvázis <michael.aivazis@para-sim.com>
+// parasim
+// (c) 1998-2019 all rights reserved
+//
+
+// configuration
+#include <portinfo>
+// STL
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <valarray>
+// pyre
+#include <pyre/journal.h>
+// isce3
+#include <isce3/fft/FFTPlan.h>
+// pull the declarations
+#include "kernels.h"
+
+// the size of the transforms for a given target tile extent
+static int _fftDim(std::size_t tdim);
+
+// the normalization kernel
+template <typename value_t = float>
+static void
+_normalize(const value_t * arena,
+           std::size_t pairId,
+           const value_t * refStats,
+           const value_t * tgtStats,
+           const double * numerator, std::size_t fftDim,
+           std::size_t rdim, std::size_t rcells,
+           std::size_t tdim, std::size_t tcells,
+           std::size_t cdim, std::size_t ccells,
+           double * sat,
+           value_t * correlation);
+
+
+// implementation
+void
+ampcor::kernels::
+correlateFFT(const float * dArena, const float * refStats, const float * tgtStats,
+             std::size_t pairs,
+             std::size_t refCells, std::size_t tgtCells, std::size_t corCells,
+             std::size_t refDim, std::size_t tgtDim, std::size_t corDim,
+             float * dCorrelation)
+{
+    // the transforms are done in double precision so that the surface matches the direct
+    // sum to within single precision round-off
+    using spectrum_t = std::complex<double>;
+
+    // the placements of the reference tile within the target tile never wrap around, so the
+    // transforms need not be any bigger than the target tile
+    const int fftDim = _fftDim(tgtDim);
+    // the number of cells in a padded tile
+    const std::size_t fftCells = fftDim * fftDim;
+    // and in its half spectrum
+    const std::size_t specCells = fftDim * (fftDim/2 + 1);
+
+    // pairs are transformed in batches, sized so that the scratch space of each thread
+    // stays around 8MB
+    const std::size_t footprint = 3*fftCells*sizeof(double) + 2*specCells*sizeof(spectrum_t);
+    const std::size_t batch =
+        std::max<std::size_t>(1, std::min<std::size_t>(pairs, (8 << 20) / footprint));
+    // the number of batches
+    const std::size_t batches = (pairs + batch - 1) / batch;
+
+    // make a channel
+    pyre::journal::debug_t channel("ampcor");
+
+    // show me
+    channel
+        << pyre::journal::at(__HERE__)
+        << "launching multithreading on " << batches << " batches of " << batch
+        << " pairs of tiles, with " << fftDim << "x" << fftDim << " transforms"
+        << pyre::journal::endl;
+
+    #pragma omp parallel
+    {
+        // scratch space
+        std::valarray<double> ref(batch * fftCells);
+        std::valarray<double> tgt(batch * fftCells);
+        std::valarray<double> numerator(batch * fftCells);
+        std::valarray<spectrum_t> refSpectrum(batch * specCells);
+        std::valarray<spectrum_t> tgtSpectrum(batch * specCells);
+        // the sum area tables of the target amplitudes and their squares
+        std::valarray<double> sat(2 * (tgtDim+1) * (tgtDim+1));
+
+        // the plans come from the process-wide cache, so only the first thread to get here
+        // pays for planning
+        const int n[] = {fftDim, fftDim};
+        isce3::fft::FwdFFTPlan<double> refFFT(&refSpectrum[0], &ref[0], n, batch,
+                                              FFTW_ESTIMATE, 1);
+        isce3::fft::FwdFFTPlan<double> tgtFFT(&tgtSpectrum[0], &tgt[0], n, batch,
+                                              FFTW_ESTIMATE, 1);
+        isce3::fft::InvFFTPlan<double> corFFT(&numerator[0], &tgtSpectrum[0], n, batch,
+                                              FFTW_ESTIMATE, 1);
+
+        #pragma omp for schedule(dynamic)
+        for (std::size_t batchId = 0; batchId < batches; ++batchId) {
+            // the first pair in this batch
+            auto first = batchId * batch;
+            // the number of pairs in this batch
+            auto count = std::min(batch, pairs - first);
+
+            // clear the padding, as well as any unused slots in the last batch
+            ref = 0;
+            tgt = 0;
+            // embed the tiles in the transform buffers
+            for (std::size_t slot = 0; slot < count; ++slot) {
+                // reference and target grids are interleaved
+                auto r = dArena + (first + slot)*(refCells + tgtCells);
+                auto t = r + refCells;
+                for (std::size_t row = 0; row < refDim; ++row) {
+                    std::copy(r + row*refDim, r + (row+1)*refDim,
+                              &ref[slot*fftCells + row*fftDim]);
+                }
+                for (std::size_t row = 0; row < tgtDim; ++row) {
+                    std::copy(t + row*tgtDim, t + (row+1)*tgtDim,
+                              &tgt[slot*fftCells + row*fftDim]);
+                }
+            }
+
+            // go to the frequency domain
+            refFFT.execute();
+            tgtFFT.execute();
+            // form the cross spectrum
+            for (std::size_t cell = 0; cell < count*specCells; ++cell) {
+                tgtSpectrum[cell] *= std::conj(refSpectrum[cell]);
+            }
+            // and come back with the sum of {ref * tgt} for every placement
+            corFFT.execute();
+
+            // normalize
+            for (std::size_t slot = 0; slot < count; ++slot) {
+                _normalize(dArena, first + slot, refStats, tgtStats,
+                           &numerator[slot*fftCells], fftDim,
+                           refDim, refCells, tgtDim, tgtCells, corDim, corCells,
+                           &sat[0], dCorrelation);
+            }
+        }
+    }
+
+    // all done
+    return;
+}
+
+
+// the smallest size no smaller than {tdim} whose only prime factors are 2, 3, 5 and 7
+int
+_fftDim(std::size_t tdim)
+{
+    for (auto dim = std::max<std::size_t>(tdim, 1); ; ++dim) {
+        auto rest = dim;
+        for (std::size_t factor : {2, 3, 5, 7}) {
+            while (rest % factor == 0) {
+                rest /= factor;
+            }
+        }
+        if (rest == 1) {
+            return dim;
+        }
+    }
+}
+
+
+// the normalization kernel
+template <typename value_t>
+void
+_normalize(const value_t * arena, // the dataspace
+           std::size_t pairId, // the tile id
+           const value_t * refStats, // std dev (unormalized) of the ref tile
+           const value_t * tgtStats, // the mean table of the target tile
+           const double * numerator, // the unnormalized cross correlation of the pair
+           std::size_t fftDim, // and its row stride
+           std::size_t rdim, std::size_t rcells, // ref grid shape and size
+           std::size_t tdim, std::size_t tcells, // tgt grid shape and size
+           std::size_t cdim, std::size_t ccells, // cor grid shape and size
+           double * sat, // scratch space for the sum area tables
+           value_t * correlation)
+{
+    // reference and target grids are interleaved; compute the stride
+    std::size_t stride = rcells + tcells;
+    // my {ref} starting point
+    auto ref = arena + pairId*stride;
+    // my {tgt} starting point
+    auto tgt = arena + pairId*stride + rcells;
+
+    // the reference tiles have had their mean removed, but only up to round-off; keep track of
+    // the residual so that the result is the same as the direct sum over {ref * (tgt - mean)}
+    double refSum = 0;
+    for (std::size_t cell = 0; cell < rcells; ++cell) {
+        refSum += ref[cell];
+    }
+
+    // build the sum area tables of the target amplitudes and their squares, with a leading
+    // row and column of zeroes so that the window sums need no special cases
+    auto sdim = tdim + 1;
+    auto sat1 = sat;
+    auto sat2 = sat + sdim*sdim;
+    std::fill(sat1, sat1 + sdim, 0.0);
+    std::fill(sat2, sat2 + sdim, 0.0);
+    for (std::size_t row = 0; row < tdim; ++row) {
+        double sum1 = 0;
+        double sum2 = 0;
+        sat1[(row+1)*sdim] = 0;
+        sat2[(row+1)*sdim] = 0;
+        for (std::size_t col = 0; col < tdim; ++col) {
+            double t = tgt[row*tdim + col];
+            sum1 += t;
+            sum2 += t * t;
+            sat1[(row+1)*sdim + col+1] = sat1[row*sdim + col+1] + sum1;
+            sat2[(row+1)*sdim + col+1] = sat2[row*sdim + col+1] + sum2;
+        }
+    }
+
+    // the inverse transform is unnormalized
+    double scale = 1.0 / (fftDim * fftDim);
+    // looks up the sqrt of the reference tile variance
+    value_t refVariance = refStats[pairId];
+
+    // go through all possible placements of the reference tile
+    for (std::size_t row = 0; row < cdim; row++) {
+        for (std::size_t col = 0; col < cdim; col++) {
+            // look up the mean target amplitude
+            double mean = tgtStats[pairId*ccells + row*cdim + col];
+
+            // the corners of the window in the sum area tables
+            auto ul = row*sdim + col;
+            auto ur = row*sdim + col + rdim;
+            auto ll = (row + rdim)*sdim + col;
+            auto lr = (row + rdim)*sdim + col + rdim;
+            // the sum of the target amplitudes over the window
+            double sum1 = sat1[lr] - sat1[ur] - sat1[ll] + sat1[ul];
+            // and the sum of their squares
+            double sum2 = sat2[lr] - sat2[ur] - sat2[ll] + sat2[ul];
+
+            // the numerator: {sum ref * (tgt - mean)}
+            double num = scale * numerator[row*fftDim + col] - mean * refSum;
+            // the target variance: {sum (tgt - mean)^2}, which can't be negative
+            double tgtVariance = std::max(0.0, sum2 - 2*mean*sum1 + rcells*mean*mean);
+
+            // computes the correlation
+            value_t corr = num / (refVariance * std::sqrt(tgtVariance));
+            // and stores it
+            correlation[pairId*ccells + row*cdim + col] = corr;
+        }
+    }
+
+    // all done
+    return;
+}
+
+
+// end of file
@@ -49,11 +49,15 @@ namespace ampcor {
         // forward declarations of local classes
         // the manager
         template <typename raster_t> class Sequential;
+        // the out-of-core driver
+        template <typename raster_t> class Streaming;
 
         // the public type aliases for the local objects
         // workers
         template <typename raster_t>
         using sequential_t = Sequential<raster_t>;
+        template <typename raster_t>
+        using streaming_t = Streaming<raster_t>;
 
     } // of namespace correlators
 } // of namespace ampcor
@@ -63,12 +67,17 @@ namespace ampcor {
 
 // the class declarations
 #include "Sequential.h"
+#include "Streaming.h"
 
 // the inline definitions
 // sequential
 #define ampcor_correlators_Sequential_icc
 #include "Sequential.icc"
 #undef ampcor_correlators_Sequential_icc
+// streaming
+#define ampcor_correlators_Streaming_icc
+#include "Streaming.icc"
+#undef ampcor_correlators_Streaming_icc
 
 
 // code guard
@@ -44,6 +44,14 @@ namespace ampcor {
                        std::size_t refDim, std::size_t tgtDim, std::size_t corDim,
                        float * dCorrelation);
 
+        // compute the correlation matrix in the frequency domain; same interface and result as
+        // {correlate}, at a cost that grows with the size of the target tiles only
+        void correlateFFT(const float * rArena, const float * refStats, const float * tgtStats,
+                          std::size_t pairs,
+                          std::size_t refCells, std::size_t tgtCells, std::size_t corCells,
+                          std::size_t refDim, std::size_t tgtDim, std::size_t corDim,
+                          float * dCorrelation);
+
         // compute the locations of the maximum value of the correlation map
         void maxcor(const float * cor,
                     std::size_t pairs, std::size_t corCells, std::size_t corDim,
@@ -7,6 +7,7 @@
 
 #include "Covariance.h"
 
+#include <isce3/geocode/Geo2rdrCache.h>
 #include <isce3/geometry/DEMInterpolator.h>
 
 #include "Crossmul.h"
@@ -148,6 +149,23 @@ void isce3::signal::Covariance<T>::geocodeCovariance(
 
     std::cout << " nBlocks: " << nBlocks << std::endl;
 
+    // make sure precomputed radar coordinates cover the geocoded grid, whose
+    // pixels _geo2rdr samples at their centers, and match the radar geometry
+    if (_geo2rdrCache) {
+        isce3::product::GeoGridParameters geoGrid;
+        geoGrid.startX(_geoTrans[0]);
+        geoGrid.startY(_geoTrans[3]);
+        geoGrid.spacingX(_geoGridSpacingX);
+        geoGrid.spacingY(_geoGridSpacingY);
+        geoGrid.width(_geoGridWidth);
+        geoGrid.length(_geoGridLength);
+        geoGrid.epsg(_epsgOut);
+        _geo2rdrCache->checkGeoGrid(geoGrid, 0.5);
+        _geo2rdrCache->checkGeometry(_orbit, _doppler, _ellipsoid,
+                                     _radarGrid.wavelength(),
+                                     _radarGrid.lookSide());
+    }
+
     // loop over the blocks of the geocoded Grid
     for (size_t block = 0; block < nBlocks; ++block) {
         std::cout << "block : " << block << std::endl;
@@ -169,8 +187,9 @@ void isce3::signal::Covariance<T>::geocodeCovariance(
         int rangeFirstPixel, rangeLastPixel;
 
         // load a block of DEM for the current geocoded grid
-        _loadDEM(demRaster, demInterp, _proj, lineStart, geoBlockLength,
-                 _geoGridWidth, _demBlockMargin);
+        if (!_geo2rdrCache)
+            _loadDEM(demRaster, demInterp, _proj, lineStart, geoBlockLength,
+                     _geoGridWidth, _demBlockMargin);
 
         // Given the current block on geocoded grid,
         // compute the bounding box of a block of data in the radar image.
@@ -195,20 +214,14 @@ void isce3::signal::Covariance<T>::geocodeCovariance(
             // Global line index
             const size_t line = lineStart + blockLine;
 
-            // y coordinate in the out put grid
-            double y = _geoGridStartY + _geoGridSpacingY * line;
-
             // Loop over DEM pixels
             #pragma omp parallel for
             for (size_t pixel = 0; pixel < _geoGridWidth; ++pixel) {
 
-                // x in the output geocoded Grid
-                double x = _geoGridStartX + _geoGridSpacingX * pixel;
-
                 // compute the azimuth time and slant range for the
                 // x,y coordinates in the output grid
                 double aztime, srange;
-                _geo2rdr(x, y, aztime, srange, demInterp);
+                _geo2rdr(line, pixel, aztime, srange, demInterp);
 
                 // get the row and column index in the radar grid
                 double rdrX, rdrY;
@@ -719,34 +732,21 @@ void isce3::signal::Covariance<T>::_computeRangeAzimuthBoundingBox(
         isce3::geometry::DEMInterpolator & demInterp, int & azimuthFirstLine,
         int & azimuthLastLine, int & rangeFirstPixel, int & rangeLastPixel)
 {
-    // to store the four corner of the block on ground
-    std::valarray<double> X(4);
-    std::valarray<double> Y(4);
+    // the four corners of the block on ground
+    const size_t line[4] = {size_t(lineStart), size_t(lineStart),
+                            size_t(lineStart + blockLength - 1),
+                            size_t(lineStart + blockLength - 1)};
+    const size_t pixel[4] = {0, size_t(blockWidth - 1), 0,
+                             size_t(blockWidth - 1)};
 
     // to store the azimuth time and slant range corresponding to
     // the corner of the block on ground
     std::valarray<double> azimuthTime(4);
     std::valarray<double> slantRange(4);
 
-    // top left corener on ground
-    Y[0] = _geoGridStartY + _geoGridSpacingY * lineStart;
-    X[0] = _geoGridStartX;
-
-    // top right corener on ground
-    Y[1] = _geoGridStartY + _geoGridSpacingY * lineStart;
-    X[1] = _geoGridStartX + _geoGridSpacingX * (blockWidth - 1);
-
-    // bottom left corener on ground
-    Y[2] = _geoGridStartY + _geoGridSpacingY * (lineStart + blockLength - 1);
-    X[2] = _geoGridStartX;
-
-    // bottom right corener on ground
-    Y[3] = _geoGridStartY + _geoGridSpacingY * (lineStart + blockLength - 1);
-    X[3] = _geoGridStartX + _geoGridSpacingX * (blockWidth - 1);
-
     // compute geo2rdr for the 4 corners
     for (size_t i = 0; i < 4; ++i) {
-        _geo2rdr(X[i], Y[i], azimuthTime[i], slantRange[i], demInterp);
+        _geo2rdr(line[i], pixel[i], azimuthTime[i], slantRange[i], demInterp);
     }
 
     // the first azimuth line
@@ -786,11 +786,24 @@ void isce3::signal::Covariance<T>::_computeRangeAzimuthBoundingBox(
 
 template<class T>
 void isce3::signal::Covariance<T>::_geo2rdr(
-        double x, double y, double & azimuthTime, double & slantRange,
+        size_t line, size_t pixel, double & azimuthTime, double & slantRange,
         isce3::geometry::DEMInterpolator & demInterp)
 {
+    // look up the precomputed radar coordinates
+    if (_geo2rdrCache) {
+        azimuthTime = _geo2rdrCache->azimuthTime(line, pixel);
+        slantRange = _geo2rdrCache->slantRange(line, pixel);
+        if (std::isnan(azimuthTime) || std::isnan(slantRange)) {
+            azimuthTime = 0.0;
+            slantRange = -1.0e-16;
+        }
+        return;
+    }
+
     // coordinate in the output projection system
-    isce3::core::cartesian_t xyz {x, y, 0.0};
+    isce3::core::cartesian_t xyz {_geoGridStartX + _geoGridSpacingX * pixel,
+                                  _geoGridStartY + _geoGridSpacingY * line,
+                                  0.0};
 
     // coordinate in lon lat height
     isce3::core::cartesian_t llh;
@@ -801,7 +814,8 @@ void isce3::signal::Covariance<T>::_geo2rdr(
     // interpolate the height from the DEM for this pixel
     llh[2] = demInterp.interpolateLonLat(llh[0], llh[1]);
 
-    // Perform geo->rdr iterations
+    // Perform geo->rdr iterations, starting from the middle of the radar grid
+    azimuthTime = _radarGrid.sensingMid();
     int converged = isce3::geometry::geo2rdr(
             llh, _ellipsoid, _orbit, _doppler, azimuthTime, slantRange,
             _radarGrid.wavelength(), _radarGrid.lookSide(), _threshold,
@@ -10,6 +10,7 @@
 #include "forward.h"
 
 #include <map>
+#include <memory>
 
 // isce3::core
 #include <isce3/core/Ellipsoid.h>
@@ -25,6 +26,10 @@
 // isce3::geometry
 #include <isce3/geometry/geometry.h>
 
+namespace isce3 { namespace geocode {
+class Geo2rdrCache;
+}}
+
 /**
  * Covariance estimation from dual-polarization or quad-polarization data
  */
@@ -225,6 +230,19 @@ public:
     /** Set interpolator */
     void interpolator(isce3::core::Interpolator<T> * interp) { _interp = interp; }
 
+    /**
+     * Set precomputed radar coordinates of the geocoded grid, which are then
+     * used instead of the DEM and geo2rdr computations. The cache must cover
+     * the geocoded grid with a pixel offset of 0.5 and have been computed with
+     * the same orbit, Doppler, ellipsoid, wavelength, look side and DEM. Pass
+     * nullptr to go back to computing them.
+     */
+    void geo2rdrCache(
+            std::shared_ptr<const isce3::geocode::Geo2rdrCache> geo2rdrCache)
+    {
+        _geo2rdrCache = geo2rdrCache;
+    }
+
 private:
     void _correctRTC(std::valarray<std::complex<float>> & rdrDataBlock,
                      std::valarray<float> & rtcDataBlock);
@@ -242,7 +260,8 @@ private:
                   isce3::core::ProjectionBase * _proj, int lineStart,
                   int blockLength, int blockWidth, double demMargin);
 
-    void _geo2rdr(double x, double y, double & azimuthTime, double & slantRange,
+    void _geo2rdr(size_t line, size_t pixel, double & azimuthTime,
+                  double & slantRange,
                   isce3::geometry::DEMInterpolator & demInterp);
 
     void _interpolate(std::valarray<T> & rdrDataBlock,
@@ -337,6 +356,9 @@ private:
     // projection object
     isce3::core::ProjectionBase * _proj = nullptr;
 
+    // precomputed radar coordinates of the geocoded grid
+    std::shared_ptr<const isce3::geocode::Geo2rdrCache> _geo2rdrCache;
+
     // margin around a computed bounding box for DEM (in degrees)
     double _demBlockMargin;
 
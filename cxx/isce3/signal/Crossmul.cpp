@@ -7,6 +7,15 @@
 
 #include "Crossmul.h"
 
+#include <algorithm>
+#include <memory>
+#include <new>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "FFTPlanCache.h"
 #include "Filter.h"
 #include "Looks.h"
 #include "Signal.h"
@@ -20,6 +29,195 @@ size_t omp_thread_count() {
     return n;
 }
 
+/** Buffers for one block of crossmul processing. When oversampling, the
+ * upsampling, conjugate multiplication and look down are done a few rows at
+ * a time in per-thread chunk buffers that are carved out of a single
+ * SIMD-aligned FFTW allocation, so the oversampled SLCs and interferogram
+ * are never formed for the whole block. */
+struct isce3::signal::Crossmul::Workspace {
+
+    Workspace(size_t ncols, size_t fft_size, size_t blockRows,
+              size_t oversample, size_t ncolsLooked, size_t blockRowsLooked,
+              int nthreads) :
+        ncols(ncols), fft_size(fft_size), blockRows(blockRows),
+        oversample(oversample), ncolsLooked(ncolsLooked),
+        blockRowsLooked(blockRowsLooked), nthreads(nthreads),
+        refSlc(fft_size*blockRows), secSlc(fft_size*blockRows),
+        rngOffset(ncols*blockRows),
+        geometryIfgram(fft_size*blockRows),
+        geometryIfgramConj(fft_size*blockRows),
+        refSpectrum(fft_size*blockRows), secSpectrum(fft_size*blockRows),
+        refAzimuthSpectrum(fft_size*blockRows),
+        rangeFrequencies(fft_size),
+        ifgram(ncols*blockRows),
+        ifgramMultiLooked(ncolsLooked*blockRowsLooked),
+        refAmplitudeLooked(ncolsLooked*blockRowsLooked),
+        secAmplitudeLooked(ncolsLooked*blockRowsLooked),
+        coherence(ncolsLooked*blockRowsLooked)
+    {
+        if (oversample == 1)
+            return;
+
+        // Number of rows per chunk such that the chunk buffers of one
+        // thread (spectrum, upsampled spectrum, upsampled reference and
+        // secondary SLCs) fit in about 1 MB, i.e. stay cache resident
+        const size_t rowBytes = (fft_size + 3*oversample*fft_size) *
+                                sizeof(std::complex<float>);
+        chunkRows = std::max<size_t>(1, std::min<size_t>(
+                blockRows, (size_t(1) << 20) / rowBytes));
+
+        // chunk buffers, each padded to a multiple of 64 bytes so that all
+        // of them share the alignment of the arena and can run the same
+        // cached FFT plans
+        const size_t pad = 64 / sizeof(std::complex<float>);
+        auto padded = [pad](size_t n) { return (n + pad - 1) / pad * pad; };
+        spectrumSize = padded(chunkRows*fft_size);
+        upsampledSize = padded(chunkRows*oversample*fft_size);
+        threadStride = spectrumSize + 3*upsampledSize;
+
+        arena = static_cast<std::complex<float>*>(
+                isce3::fftw3cxx::malloc<float>(
+                        nthreads*threadStride*sizeof(std::complex<float>)));
+        if (arena == nullptr)
+            throw std::bad_alloc();
+    }
+
+    ~Workspace() {
+        if (arena != nullptr)
+            isce3::fftw3cxx::free<float>(arena);
+    }
+
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    bool matches(size_t ncols_, size_t fft_size_, size_t blockRows_,
+                 size_t oversample_, size_t ncolsLooked_,
+                 size_t blockRowsLooked_, int nthreads_) const {
+        return ncols == ncols_ and fft_size == fft_size_ and
+               blockRows == blockRows_ and oversample == oversample_ and
+               ncolsLooked == ncolsLooked_ and
+               blockRowsLooked == blockRowsLooked_ and nthreads == nthreads_;
+    }
+
+    // chunk buffers of a thread
+    std::complex<float>* spectrum(int thread) const {
+        return arena + thread*threadStride;
+    }
+    std::complex<float>* spectrumUpsampled(int thread) const {
+        return spectrum(thread) + spectrumSize;
+    }
+    std::complex<float>* refSlcUpsampled(int thread) const {
+        return spectrumUpsampled(thread) + upsampledSize;
+    }
+    std::complex<float>* secSlcUpsampled(int thread) const {
+        return refSlcUpsampled(thread) + upsampledSize;
+    }
+
+    // block geometry the buffers are sized for
+    size_t ncols, fft_size, blockRows, oversample;
+    size_t ncolsLooked, blockRowsLooked;
+    int nthreads;
+
+    // blocks of reference and secondary SLC data (zero padded to fft_size)
+    std::valarray<std::complex<float>> refSlc, secSlc;
+
+    // block of range offsets
+    std::valarray<double> rngOffset;
+
+    // simulated interferogram whose phase is the interferometric phase due
+    // to the imaging geometry, phase = (4*PI/wavelength)*(rngOffset), and
+    // its complex conjugate
+    std::valarray<std::complex<float>> geometryIfgram, geometryIfgramConj;
+
+    // range spectra used by the common band filters
+    std::valarray<std::complex<float>> refSpectrum, secSpectrum;
+
+    // azimuth spectrum used by the azimuth common band filter
+    std::valarray<std::complex<float>> refAzimuthSpectrum;
+
+    // range frequencies of the fft_size samples
+    std::valarray<double> rangeFrequencies;
+
+    // full resolution and multi-looked interferograms
+    std::valarray<std::complex<float>> ifgram, ifgramMultiLooked;
+
+    // multi-looked amplitudes of the SLCs and coherence
+    std::valarray<float> refAmplitudeLooked, secAmplitudeLooked, coherence;
+
+    // frequency response of the look-down shift for one range line
+    // (oversample > 1 only)
+    std::valarray<std::complex<float>> shiftImpact;
+
+    // aligned chunk buffers used when oversample > 1
+    size_t chunkRows = 0;
+    size_t spectrumSize = 0, upsampledSize = 0, threadStride = 0;
+    std::complex<float>* arena = nullptr;
+};
+
+// Range FFT plans used to upsample a chunk of rows
+struct UpsamplePlans {
+    std::shared_ptr<isce3::signal::FFTPlanCache<float>::plan_t> forward,
+                                                                  inverse;
+};
+
+// Get the plans to upsample chunks of the given number of rows. The forward
+// plan reads the SLC block at any row offset, so it is created unaligned.
+static UpsamplePlans upsamplePlans(std::complex<float>* slc,
+                                   std::complex<float>* spectrum,
+                                   std::complex<float>* spectrumUpsampled,
+                                   std::complex<float>* slcUpsampled,
+                                   size_t rows, size_t fft_size,
+                                   size_t oversample)
+{
+    using isce3::signal::FFTPlanCache;
+
+    UpsamplePlans plans;
+    plans.forward = FFTPlanCache<float>::rangePlan(slc, spectrum, fft_size,
+                                                   rows, FFTW_FORWARD, 1,
+                                                   true);
+    plans.inverse = FFTPlanCache<float>::rangePlan(spectrumUpsampled,
+                                                   slcUpsampled,
+                                                   oversample*fft_size, rows,
+                                                   FFTW_BACKWARD);
+    return plans;
+}
+
+// Upsample rows of data in range by zero padding their spectrum, applying
+// the look-down shift and normalization in the frequency domain
+static void upsampleRange(const UpsamplePlans& plans,
+                          std::complex<float>* slc,
+                          std::complex<float>* spectrum,
+                          std::complex<float>* spectrumUpsampled,
+                          const std::complex<float>* shiftImpact,
+                          std::complex<float>* slcUpsampled,
+                          size_t rows, size_t fft_size, size_t oversample)
+{
+    using isce3::signal::FFTPlanCache;
+
+    const size_t columns = oversample*fft_size;
+
+    FFTPlanCache<float>::execute(*plans.forward, slc, spectrum);
+
+    // The spectrum has values from begining to fft_size index for each
+    // line. The spectrum of the upsampled data has values from 0 to
+    // fft_size/2 and from oversample*fft_size - fft_size/2 to the end.
+    const float norm = 1.0f / fft_size;
+    const size_t half = fft_size / 2;
+    for (size_t line = 0; line < rows; ++line) {
+        const std::complex<float>* in = spectrum + line*fft_size;
+        std::complex<float>* out = spectrumUpsampled + line*columns;
+        for (size_t col = 0; col < half; ++col)
+            out[col] = in[col] * shiftImpact[col] * norm;
+        for (size_t col = half; col < columns - half; ++col)
+            out[col] = 0;
+        for (size_t col = columns - half; col < columns; ++col)
+            out[col] = in[col - columns + fft_size] * shiftImpact[col] * norm;
+    }
+
+    FFTPlanCache<float>::execute(*plans.inverse, spectrumUpsampled,
+                                 slcUpsampled);
+}
+
 /*
 isce3::signal::Crossmul::
 Crossmul(const isce3::product::Product& referenceSlcProduct,
@@ -97,13 +295,7 @@ crossmul(isce3::io::Raster& referenceSLC,
 
     size_t nrows = referenceSLC.length();
     size_t ncols = referenceSLC.width();
-    size_t nthreads = omp_thread_count();
-
-    //signal object for refSlc
-    isce3::signal::Signal<float> refSignal(nthreads);
-
-    //signal object for secSlc
-    isce3::signal::Signal<float> secSignal(nthreads);
+    int nthreads = omp_thread_count();
 
     // instantiate Looks used for multi-looking the interferogram
     isce3::signal::Looks<float> looksObj;
@@ -125,7 +317,7 @@ crossmul(isce3::io::Raster& referenceSLC,
     
     // Compute FFT size (power of 2)
     size_t fft_size;
-    refSignal.nextPowerOfTwo(ncols, fft_size);
+    isce3::signal::Signal<float>().nextPowerOfTwo(ncols, fft_size);
 
     // number of blocks to process
     size_t nblocks = nrows / blockRows;
@@ -135,85 +327,40 @@ crossmul(isce3::io::Raster& referenceSLC,
         nblocks += 1;
     }
 
-    // storage for a block of reference SLC data
-    std::valarray<std::complex<float>> refSlc(fft_size*blockRows);
-
-    // storage for a block of secondary SLC data
-    std::valarray<std::complex<float>> secSlc(fft_size*blockRows);
-
-    // storage for a block of range offsets
-    std::valarray<double> rngOffset(ncols*blockRows);
-
-    // storage for a simulated interferogram which its phase is the 
-    // interferometric phase due to the imaging geometry:
-    // phase = (4*PI/wavelength)*(rngOffset) 
-    std::valarray<std::complex<float>> geometryIfgram(fft_size*blockRows);
-
-    // complex conjugate of geometryIfgram
-    std::valarray<std::complex<float>> geometryIfgramConj(fft_size*blockRows);
-
-    // storage for spectrum of the block of data in reference SLC
-    std::valarray<std::complex<float>> refSpectrum(fft_size*blockRows);
-
-    // storage for spectrum of the block of data in secondary SLC
-    std::valarray<std::complex<float>> secSpectrum(fft_size*blockRows);
-
-    // upsampled spectrum of the block of reference SLC
-    std::valarray<std::complex<float>> refSpectrumUpsampled(oversample*fft_size*blockRows);
-
-    // upsampled spectrum of the block of secondary SLC
-    std::valarray<std::complex<float>> secSpectrumUpsampled(oversample*fft_size*blockRows);
-
-    // upsampled block of reference SLC 
-    std::valarray<std::complex<float>> refSlcUpsampled(oversample*fft_size*blockRows);
-
-    // upsampled block of secondary SLC
-    std::valarray<std::complex<float>> secSlcUpsampled(oversample*fft_size*blockRows);
-
-    // upsampled interferogram
-    std::valarray<std::complex<float>> ifgramUpsampled(oversample*ncols*blockRows);
-
-    // full resolution interferogram
-    std::valarray<std::complex<float>> ifgram(ncols*blockRows);
-
-    // multi-looked interferogram
-    std::valarray<std::complex<float>> ifgramMultiLooked(ncolsMultiLooked*blockRowsMultiLooked);
-
-    // multi-looked amplitude of reference SLC
-    std::valarray<float> refAmplitudeLooked(ncolsMultiLooked*blockRowsMultiLooked);
-
-    // multi-looked amplitude of secondary SLC
-    std::valarray<float> secAmplitudeLooked(ncolsMultiLooked*blockRowsMultiLooked);
-
-    // coherence for multi-looked interferogram
-    std::valarray<float> coherence(ncolsMultiLooked*blockRowsMultiLooked);
-
-    // make forward and inverse fft plans for the reference SLC 
-    refSignal.forwardRangeFFT(refSlc, refSpectrum, fft_size, blockRows);
-    refSignal.inverseRangeFFT(refSpectrumUpsampled, refSlcUpsampled, fft_size*oversample, blockRows);
-
-    // make forward and inverse fft plans for the secondary SLC
-    secSignal.forwardRangeFFT(secSlc, secSpectrum, fft_size, blockRows);
-    secSignal.inverseRangeFFT(secSpectrumUpsampled, secSlcUpsampled, fft_size*oversample, blockRows);
+    // (re)allocate the block buffers if the block geometry changed since
+    // the last call
+    if (not _workspace or
+        not _workspace->matches(ncols, fft_size, blockRows, oversample,
+                                ncolsMultiLooked, blockRowsMultiLooked,
+                                nthreads)) {
+        _workspace.reset();
+        _workspace = std::make_shared<Workspace>(
+                ncols, fft_size, blockRows, oversample,
+                ncolsMultiLooked, blockRowsMultiLooked, nthreads);
+
+        // looking down the upsampled interferogram may shift the samples by
+        // a fraction of a pixel depending on the oversample factor.
+        // predicting the impact of the shift in frequency domain which is a
+        // linear phase allows to account for it during the upsampling
+        // process
+        if (oversample > 1) {
+            _workspace->shiftImpact.resize(oversample*fft_size);
+            lookdownShiftImpact(oversample, fft_size, 1,
+                                _workspace->shiftImpact);
+        }
+    }
+    Workspace& ws = *_workspace;
 
-    // looking down the upsampled interferogram may shift the samples by a fraction of a pixel
-    // depending on the oversample factor. predicting the impact of the shift in frequency domain 
-    // which is a linear phase allows to account for it during the upsampling process
-    std::valarray<std::complex<float>> shiftImpact(oversample*fft_size*blockRows);
-    lookdownShiftImpact(oversample,  fft_size, 
-                        blockRows, shiftImpact);
+    // the range sampling frequency may differ between calls
+    fftfreq(1.0/_rangeSamplingFrequency, ws.rangeFrequencies);
 
     //filter objects which will be used for azimuth and range common band filtering
     isce3::signal::Filter<float> azimuthFilter;
     isce3::signal::Filter<float> rangeFilter;
 
-    std::valarray<double> rangeFrequencies(fft_size);
-    fftfreq(1.0/_rangeSamplingFrequency, rangeFrequencies);
-
-    rangeFilter.initiateRangeFilter(refSlc, refSpectrum, fft_size, blockRows);
-
-    // storage for azimuth spectrum used by filter
-    std::valarray<std::complex<float>> refAzimuthSpectrum(fft_size*blockRows);
+    if (_doCommonRangebandFilter)
+        rangeFilter.initiateRangeFilter(ws.refSlc, ws.refSpectrum,
+                                        fft_size, blockRows);
 
     if (_doCommonAzimuthbandFilter){
         // construct azimuth common band filter for a block of data
@@ -222,13 +369,17 @@ crossmul(isce3::io::Raster& referenceSLC,
                                             _commonAzimuthBandwidth,
                                             _prf, 
                                             _beta,
-                                            refSlc, refAzimuthSpectrum,
+                                            ws.refSlc, ws.refAzimuthSpectrum,
                                             fft_size, blockRows);
     }
 
     // loop over all blocks
     std::cout << "nblocks : " << nblocks << std::endl;
 
+    // storage for a line of data read from the rasters
+    std::valarray<std::complex<float>> dataLine(ncols);
+    std::valarray<double> offsetLine(ncols);
+
     for (size_t block = 0; block < nblocks; ++block) {
         std::cout << "block: " << block << std::endl;       
         // start row for this block
@@ -248,29 +399,25 @@ crossmul(isce3::io::Raster& referenceSLC,
         }
 
         // fill the valarray with zero before getting the block of the data
-        refSlc = 0;
-        secSlc = 0;
-        ifgramUpsampled = 0;
-        ifgram = 0;
+        ws.refSlc = 0;
+        ws.secSlc = 0;
+        ws.ifgram = 0;
 
         // get a block of reference and secondary SLC data
         // and a block of range offsets
         // This will change once we have the functionality to 
         // get a block of data directly in to a slice
-        std::valarray<std::complex<float>> dataLine(ncols);
         for (size_t line = 0; line < blockRowsData; ++line){
             referenceSLC.getLine(dataLine, rowStart + line);
-            refSlc[std::slice(line*fft_size, ncols, 1)] = dataLine;
+            ws.refSlc[std::slice(line*fft_size, ncols, 1)] = dataLine;
             secondarySLC.getLine(dataLine, rowStart + line);
-            secSlc[std::slice(line*fft_size, ncols, 1)] = dataLine;
+            ws.secSlc[std::slice(line*fft_size, ncols, 1)] = dataLine;
         }
-        //referenceSLC.getBlock(refSlc, 0, rowStart, ncols, blockRowsData);
-        //secondarySLC.getBlock(secSlc, 0, rowStart, ncols, blockRowsData);
    
         //commaon azimuth band-pass filter the reference and secondary SLCs
         if (_doCommonAzimuthbandFilter){
-            azimuthFilter.filter(refSlc, refAzimuthSpectrum);
-            azimuthFilter.filter(secSlc, refAzimuthSpectrum);
+            azimuthFilter.filter(ws.refSlc, ws.refAzimuthSpectrum);
+            azimuthFilter.filter(ws.secSlc, ws.refAzimuthSpectrum);
         }
 
         // common range band-pass filtering
@@ -281,35 +428,38 @@ crossmul(isce3::io::Raster& referenceSLC,
             std::cout << " - wavelength: " << _wavelength << std::endl;
 
             // Read range offsets
-            std::valarray<double> offsetLine(ncols);
             for (size_t line = 0; line < blockRowsData; ++line){
                 rngOffsetRaster.getLine(offsetLine, rowStart + line);
-                rngOffset[std::slice(line*ncols, ncols, 1)] = offsetLine;
+                ws.rngOffset[std::slice(line*ncols, ncols, 1)] = offsetLine;
             }
 
             #pragma omp parallel for
             for (size_t line = 0; line < blockRowsData; ++line){
                 for (size_t col = 0; col < ncols; ++col){
-                    double phase = 4.0*M_PI*_rangePixelSpacing*rngOffset[line*ncols+col]/_wavelength;
-                    geometryIfgram[line*fft_size + col] = std::complex<float> (std::cos(phase), std::sin(phase));
-                    geometryIfgramConj[line*fft_size + col] = std::complex<float> (std::cos(phase), 
+                    double phase = 4.0*M_PI*_rangePixelSpacing*ws.rngOffset[line*ncols+col]/_wavelength;
+                    ws.geometryIfgram[line*fft_size + col] = std::complex<float> (std::cos(phase), std::sin(phase));
+                    ws.geometryIfgramConj[line*fft_size + col] = std::complex<float> (std::cos(phase), 
                                                                             -1.0*std::sin(phase));
 
                 }
             }
 
             // Forward FFT to compute topo-dependent spectrum
-            refSignal.forward(geometryIfgramConj, refSpectrum);
-            refSignal.forward(geometryIfgram, secSpectrum);
+            FFTPlanCache<float>::rangeFFT(&ws.geometryIfgramConj[0],
+                                          &ws.refSpectrum[0], fft_size,
+                                          blockRows, FFTW_FORWARD, nthreads);
+            FFTPlanCache<float>::rangeFFT(&ws.geometryIfgram[0],
+                                          &ws.secSpectrum[0], fft_size,
+                                          blockRows, FFTW_FORWARD, nthreads);
 
             // do the range common band filter
-            rangeCommonBandFilter(refSlc,
-                                secSlc,
-                                geometryIfgram,
-                                geometryIfgramConj,
-                                refSpectrum,
-                                secSpectrum,
-                                rangeFrequencies,
+            rangeCommonBandFilter(ws.refSlc,
+                                ws.secSlc,
+                                ws.geometryIfgram,
+                                ws.geometryIfgramConj,
+                                ws.refSpectrum,
+                                ws.secSpectrum,
+                                ws.rangeFrequencies,
                                 rangeFilter,
                                 blockRows,
                                 fft_size);
@@ -319,40 +469,83 @@ crossmul(isce3::io::Raster& referenceSLC,
         if (_computeCoherence) {
             looksObj.ncols(fft_size);
             // refAmplitudeLooked = sum(abs(refSlc)^2)
-            looksObj.multilook(refSlc, refAmplitudeLooked, 2);
-            looksObj.multilook(secSlc, secAmplitudeLooked, 2);
+            looksObj.multilook(ws.refSlc, ws.refAmplitudeLooked, 2);
+            looksObj.multilook(ws.secSlc, ws.secAmplitudeLooked, 2);
         }
 
-        // upsample the reference and secondary SLCs
         if (oversample == 1) {
-            refSlcUpsampled = refSlc;
-            secSlcUpsampled = secSlc;
-        } else {
-            refSignal.upsample(refSlc, refSlcUpsampled, blockRows, fft_size,
-                               oversample, shiftImpact);
-            secSignal.upsample(secSlc, secSlcUpsampled, blockRows, fft_size,
-                               oversample, shiftImpact);
-        }
-
-        // Compute oversampled interferogram data
-        #pragma omp parallel for
-        for (size_t line = 0; line < blockRowsData; line++){
-            for (size_t col = 0; col < oversample*ncols; col++){
-                ifgramUpsampled[line*(oversample*ncols) + col] = 
-                        refSlcUpsampled[line*(oversample*fft_size) + col]*
-                        std::conj(secSlcUpsampled[line*(oversample*fft_size) + col]);
+            // Compute interferogram data directly from the SLCs
+            #pragma omp parallel for
+            for (size_t line = 0; line < blockRowsData; line++){
+                for (size_t col = 0; col < ncols; col++){
+                    ws.ifgram[line*ncols + col] =
+                            ws.refSlc[line*fft_size + col]*
+                            std::conj(ws.secSlc[line*fft_size + col]);
+                }
             }
-        }
-
-        // Reclaim the extra oversample looks across
-        float ov = oversample;
-        #pragma omp parallel for
-        for (size_t line = 0; line < blockRowsData; line++){
-            for (size_t col = 0; col < ncols; col++){
-                std::complex<float> sum = 0;
-                for (size_t j=0; j< oversample; j++)
-                    sum += ifgramUpsampled[line*(ncols*oversample) + j + col*oversample];
-                ifgram[line*ncols + col] = sum/ov;            
+        } else {
+            // Upsample, cross-multiply and look down the oversampled
+            // interferogram a chunk of rows at a time, so that the
+            // oversampled data stay in per-thread cache-sized buffers
+            const size_t nchunks =
+                    (blockRowsData + ws.chunkRows - 1) / ws.chunkRows;
+            const float ov = oversample;
+
+            // Plans for the full chunks and the last (possibly shorter)
+            // chunk, created before the parallel loop so that the threads
+            // only execute them
+            const size_t lastRows =
+                    blockRowsData - (nchunks - 1)*ws.chunkRows;
+            const UpsamplePlans chunkPlans = upsamplePlans(
+                    &ws.refSlc[0], ws.spectrum(0), ws.spectrumUpsampled(0),
+                    ws.refSlcUpsampled(0), ws.chunkRows, fft_size,
+                    oversample);
+            const UpsamplePlans lastChunkPlans = upsamplePlans(
+                    &ws.refSlc[0], ws.spectrum(0), ws.spectrumUpsampled(0),
+                    ws.refSlcUpsampled(0), lastRows, fft_size, oversample);
+
+            #pragma omp parallel for schedule(dynamic)
+            for (size_t chunk = 0; chunk < nchunks; ++chunk) {
+#ifdef _OPENMP
+                const int thread = omp_get_thread_num();
+#else
+                const int thread = 0;
+#endif
+                const size_t rowStart = chunk*ws.chunkRows;
+                const size_t rows = std::min(ws.chunkRows,
+                                             blockRowsData - rowStart);
+                const UpsamplePlans& plans =
+                        (rows == ws.chunkRows) ? chunkPlans : lastChunkPlans;
+
+                std::complex<float>* refUpsampled = ws.refSlcUpsampled(thread);
+                std::complex<float>* secUpsampled = ws.secSlcUpsampled(thread);
+                upsampleRange(plans, &ws.refSlc[rowStart*fft_size],
+                              ws.spectrum(thread),
+                              ws.spectrumUpsampled(thread),
+                              &ws.shiftImpact[0], refUpsampled,
+                              rows, fft_size, oversample);
+                upsampleRange(plans, &ws.secSlc[rowStart*fft_size],
+                              ws.spectrum(thread),
+                              ws.spectrumUpsampled(thread),
+                              &ws.shiftImpact[0], secUpsampled,
+                              rows, fft_size, oversample);
+
+                // Reclaim the extra oversample looks across
+                for (size_t line = 0; line < rows; ++line) {
+                    const std::complex<float>* ref =
+                            refUpsampled + line*oversample*fft_size;
+                    const std::complex<float>* sec =
+                            secUpsampled + line*oversample*fft_size;
+                    std::complex<float>* out =
+                            &ws.ifgram[(rowStart + line)*ncols];
+                    for (size_t col = 0; col < ncols; ++col) {
+                        std::complex<float> sum = 0;
+                        for (size_t j = 0; j < oversample; ++j)
+                            sum += ref[col*oversample + j] *
+                                   std::conj(sec[col*oversample + j]);
+                        out[col] = sum/ov;
+                    }
+                }
             }
         }
 
@@ -360,23 +553,23 @@ crossmul(isce3::io::Raster& referenceSLC,
         if (_doMultiLook){
 
             looksObj.ncols(ncols);
-            looksObj.multilook(ifgram, ifgramMultiLooked);
-            interferogram.setBlock(ifgramMultiLooked, 0, rowStart/_azimuthLooks,
+            looksObj.multilook(ws.ifgram, ws.ifgramMultiLooked);
+            interferogram.setBlock(ws.ifgramMultiLooked, 0, rowStart/_azimuthLooks,
                         ncols/_rangeLooks, blockRowsData/_azimuthLooks);
 
             if (_computeCoherence) {
                 #pragma omp parallel for
-                for (size_t i = 0; i< ifgramMultiLooked.size(); ++i){
-                    coherence[i] = std::abs(ifgramMultiLooked[i])/
-                            std::sqrt(refAmplitudeLooked[i]*secAmplitudeLooked[i]);
+                for (size_t i = 0; i< ws.ifgramMultiLooked.size(); ++i){
+                    ws.coherence[i] = std::abs(ws.ifgramMultiLooked[i])/
+                            std::sqrt(ws.refAmplitudeLooked[i]*ws.secAmplitudeLooked[i]);
                 }
 
-                coherenceRaster.setBlock(coherence, 0, rowStart/_azimuthLooks,
+                coherenceRaster.setBlock(ws.coherence, 0, rowStart/_azimuthLooks,
                         ncols/_rangeLooks, blockRowsData/_azimuthLooks);
             }
         } else {
             // set the block of interferogram
-            interferogram.setBlock(ifgram, 0, rowStart, ncols, blockRowsData);
+            interferogram.setBlock(ws.ifgram, 0, rowStart, ncols, blockRowsData);
         }
     }
 }
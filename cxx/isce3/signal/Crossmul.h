@@ -10,12 +10,18 @@
 #include "forward.h"
 
 #include <complex>
+#include <memory>
+#include <valarray>
 #include <isce3/core/LUT1d.h>
 #include <isce3/io/forward.h>
 
 /** \brief Intereferogram generation by cross-multiplication of reference and secondary SLCs.
  *
  *  The secondary SLC must be on the same image grid as the reference SLC, 
+ *
+ *  Block buffers are kept between calls to crossmul and range FFT plans are
+ *  taken from isce3::signal::FFTPlanCache, so processing several pairs with
+ *  the same image size through one Crossmul object allocates and plans once.
  */
 class isce3::signal::Crossmul {
     public:
@@ -100,6 +106,9 @@ class isce3::signal::Crossmul {
         /** Set number of azimuth looks */
         inline void azimuthLooks(int);
 
+        /** Set range oversampling factor used to form the interferogram */
+        inline void oversampleFactor(size_t);
+
         /** Set common azimuth band filtering flag */
         inline void doCommonAzimuthbandFiltering(bool);
 
@@ -169,7 +178,9 @@ class isce3::signal::Crossmul {
         // upsampling factor
         size_t oversample = 1;
 
-        
+        // Block buffers reused between calls with the same block geometry
+        struct Workspace;
+        std::shared_ptr<Workspace> _workspace;
 };
 
 // Get inline implementations for Crossmul
@@ -0,0 +1,70 @@
+// -*- C++ -*-
+// -*- coding: utf-8 -*-
+
+#pragma once
+
+#include "forward.h"
+
+#include <complex>
+#include <memory>
+
+#include <isce3/fft/detail/FFTWWrapper.h>
+
+/** Batched one-dimensional complex range FFT plans
+ *
+ * A plan transforms howmany contiguous rows of n samples each. Plans are
+ * taken from the process-wide plan cache of isce3::fft (see
+ * isce3/fft/PlanCache.h), which owns them, serializes the FFTW planner and
+ * keys them by layout, direction, flags, number of FFTW threads and the
+ * FFTW alignment of the arrays they were created for. A plan may therefore
+ * be executed (with the new-array execute interface) on any arrays with the
+ * same layout and alignment, or on arrays of any alignment if it was
+ * created unaligned. Repeated processing of blocks with the same geometry
+ * only pays for planning once per process. All methods are thread-safe, and
+ * a plan may be executed by several threads at once.
+ */
+template<class T>
+class isce3::signal::FFTPlanCache {
+public:
+    typedef typename isce3::fft::detail::FFTWPlanType<T>::plan_t plan_t;
+
+    /** Get a plan for the range (row-wise) FFT of a block of data
+     *
+     * @param[in] in        Input block
+     * @param[in] out       Output block (may be equal to in)
+     * @param[in] n         Length of each transform
+     * @param[in] howmany   Number of rows
+     * @param[in] sign      FFTW_FORWARD or FFTW_BACKWARD
+     * @param[in] nthreads  Number of FFTW threads
+     * @param[in] unaligned Create a plan executable on arrays of any
+     *                      alignment
+     * @returns shared handle of the cached plan, which stays valid while
+     * the handle is held
+     */
+    static std::shared_ptr<plan_t>
+    rangePlan(std::complex<T>* in, std::complex<T>* out, int n, int howmany,
+              int sign, int nthreads = 1, bool unaligned = false)
+    {
+        int dims[] = {n};
+        const unsigned flags = FFTW_ESTIMATE | (unaligned ? FFTW_UNALIGNED : 0);
+        return isce3::fft::detail::getPlan(1, dims, howmany,
+                                           in, dims, 1, n,
+                                           out, dims, 1, n,
+                                           sign, flags, nthreads);
+    }
+
+    /** Execute a plan on arrays laid out like the ones it was created for */
+    static void execute(const plan_t plan, std::complex<T>* in,
+                        std::complex<T>* out)
+    {
+        isce3::fft::detail::executePlan(plan, in, out);
+    }
+
+    /** Execute a cached range FFT, creating its plan if needed */
+    static void rangeFFT(std::complex<T>* in, std::complex<T>* out, int n,
+                         int howmany, int sign, int nthreads = 1)
+    {
+        const auto plan = rangePlan(in, out, n, howmany, sign, nthreads);
+        execute(*plan, in, out);
+    }
+};
@@ -7,21 +7,32 @@
 
 #include "Signal.h"
 #include <iostream>
+#include <mutex>
+#include <isce3/fft/detail/FFTWWrapper.h>
 #include "fftw3cxx.h"
 
+using isce3::fft::detail::plannerMutex;
+
 template<class T>
 struct isce3::signal::Signal<T>::impl {
     isce3::fftw3cxx::plan<T> _plan_fwd;
     isce3::fftw3cxx::plan<T> _plan_inv;
+
+    // destroying the plans calls the (non thread-safe) FFTW planner
+    static void deleteImpl(impl* p) {
+        std::lock_guard<std::mutex> lock(plannerMutex());
+        delete p;
+    }
 };
 
 template <class T>
 isce3::signal::Signal<T>::
-Signal() : pimpl(new impl, [](impl* p) { delete p; }) {}
+Signal() : pimpl(new impl, impl::deleteImpl) {}
 
 template <class T>
 isce3::signal::Signal<T>::
-Signal(int nthreads) : pimpl(new impl, [](impl* p) { delete p; }) {
+Signal(int nthreads) : pimpl(new impl, impl::deleteImpl) {
+    std::lock_guard<std::mutex> lock(plannerMutex());
     fftw3cxx::init_threads<T>();
     fftw3cxx::plan_with_nthreads<T>(nthreads);
 }
@@ -83,6 +94,7 @@ fftPlanForward(std::complex<T> *input, std::complex<T> *output,
                inembed, istride, idist, 
                onembed, ostride, odist);
 
+    std::lock_guard<std::mutex> lock(plannerMutex());
     pimpl->_plan_fwd = fftw3cxx::plan<T>::plan_many_dft(rank, n, howmany,
                                             input, inembed, istride, idist,
                                             output, onembed, ostride, odist,
@@ -143,6 +155,7 @@ fftPlanForward(T *input, std::complex<T> *output,
                inembed, istride, idist, 
                onembed, ostride, odist);
 
+    std::lock_guard<std::mutex> lock(plannerMutex());
     pimpl->_plan_fwd = fftw3cxx::plan<T>::plan_many_dft_r2c(rank, n, howmany,
                                             input, inembed, istride, idist,
                                             output, onembed, ostride, odist,
@@ -209,6 +222,7 @@ fftPlanBackward(std::complex<T> *input, std::complex<T> *output,
                inembed, istride, idist, 
                onembed, ostride, odist);
 
+    std::lock_guard<std::mutex> lock(plannerMutex());
     pimpl->_plan_inv = fftw3cxx::plan<T>::plan_many_dft(rank, n, howmany,
                                             input, inembed, istride, idist,
                                             output, onembed, ostride, odist,
@@ -271,6 +285,7 @@ fftPlanBackward(std::complex<T> *input, T *output,
                inembed, istride, idist, 
                onembed, ostride, odist);
 
+    std::lock_guard<std::mutex> lock(plannerMutex());
     pimpl->_plan_inv = fftw3cxx::plan<T>::plan_many_dft_c2r(rank, n, howmany,
                                             input, inembed, istride, idist,
                                             output, onembed, ostride, odist,
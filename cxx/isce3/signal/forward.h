@@ -4,6 +4,7 @@ namespace isce3 { namespace signal {
 
     class Crossmul;
     template<class> class Covariance;
+    template<class> class FFTPlanCache;
     template<class> class Filter;
     template<class> class Looks;
     template<class> class NFFT;
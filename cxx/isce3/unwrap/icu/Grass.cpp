@@ -1,9 +1,10 @@
 #include <algorithm> // std::min
 #include <cmath> // round
-#include <cstdint> // uint8_t, UINT8_MAX
+#include <cstdint> // UINT32_MAX
 #include <exception> // std::out_of_range, std::runtime_error
+#include <vector> // std::vector
 
-#include "ICU.h" // ICU, LabelMap, idx2_t, offset2_t
+#include "ICU.h" // ICU, LabelMap, label_t, idx2_t, offset2_t
 
 namespace isce3::unwrap::icu
 {
@@ -123,7 +124,7 @@ BootstrapStatus_t estimBootstrapPhase(
     const float * unw,
     const bool * currcc,
     const float * bsunw,
-    const uint8_t * bsccl,
+    const label_t * bsccl,
     const size_t width,
     const size_t numBsLines,
     const size_t minBsPts,
@@ -171,16 +172,16 @@ BootstrapStatus_t estimBootstrapPhase(
     return status;
 }
 
-uint8_t bootstrapLabel(
+label_t bootstrapLabel(
     LabelMap & labelmap,
     const bool * currcc,
-    const uint8_t * bsccl, 
+    const label_t * bsccl, 
     const size_t width, 
     const size_t numBsLines)
 {
     // Get the min label among connected components in the bootstrap overlap 
     // region.
-    uint8_t minlabel = UINT8_MAX;
+    label_t minlabel = UINT32_MAX;
     const size_t bssize = numBsLines * width;
     for (size_t i = 0; i < bssize; ++i)
     {
@@ -196,7 +197,7 @@ uint8_t bootstrapLabel(
     {
         if (currcc[i] && bsccl[i] != 0)
         {
-            uint8_t oldlabel = labelmap.getlabel(bsccl[i]);
+            label_t oldlabel = labelmap.getlabel(bsccl[i]);
             if (oldlabel != minlabel)
             {
                 labelmap.setlabel(oldlabel, minlabel);
@@ -210,10 +211,10 @@ uint8_t bootstrapLabel(
 template<bool DO_BOOTSTRAP>
 void ICU::growGrass(
     float * unw,
-    uint8_t * ccl,
+    label_t * ccl,
     bool * currcc,
     float * bsunw,
-    uint8_t * bsccl, 
+    label_t * bsccl, 
     LabelMap & labelmap,
     const float * phase, 
     const bool * tree, 
@@ -281,7 +282,7 @@ void ICU::growGrass(
                         // bootstrap overlap region. 
                         // (If there was overlap with multiple connected 
                         // components, their labels will be merged later.)
-                        uint8_t bslabel = bootstrapLabel(
+                        label_t bslabel = bootstrapLabel(
                             labelmap, &currcc[bsoff], bsccl, width, _NumBsLines);
 
                         // Apply bootstrap phase and label.
@@ -300,7 +301,7 @@ void ICU::growGrass(
                         // No overlap/insufficient overlap in bootstrap region.
                         // Don't apply phase bootstrapping. Assign connected 
                         // component a new unique label.
-                        uint8_t newlabel = labelmap.nextlabel();
+                        label_t newlabel = labelmap.nextlabel();
                         for (size_t i = 0; i < tilesize; ++i)
                         {
                             if (currcc[i]) { ccl[i] = newlabel; }
@@ -330,7 +331,7 @@ void ICU::growGrass(
             {
                 // Don't apply phase bootstrapping. Assign connected component 
                 // a new unique label.
-                uint8_t newlabel = labelmap.nextlabel();
+                label_t newlabel = labelmap.nextlabel();
                 for (size_t i = 0; i < tilesize; ++i)
                 {
                     if (currcc[i]) { ccl[i] = newlabel; }
@@ -344,16 +345,91 @@ void ICU::growGrass(
     for (size_t i = 0; i < tilesize; ++i) { if (ccl[i] == 0) { unw[i] = 0.f; } }
 }
 
+template<bool DO_BOOTSTRAP>
+bool ICU::bootstrapTile(
+    float * unw,
+    label_t * ccl,
+    bool * bscc,
+    const float * bsunw,
+    const label_t * bsccl,
+    LabelMap & labelmap,
+    const size_t numTileLabels,
+    const size_t length,
+    const size_t width)
+{
+    // Make sure bootstrap lines are not out-of-range of tile.
+    if (DO_BOOTSTRAP && length < _NumOverlapLines/2 + _NumBsLines/2)
+    {
+        throw std::out_of_range("bootstrap lines out-of-range");
+    }
+
+    // Offset to first bootstrap line from start of tile
+    const size_t bsoff = (_NumOverlapLines/2 - _NumBsLines/2) * width;
+    const size_t bssize = _NumBsLines * width;
+
+    // Bootstrap phase and global label of each tile label. Tile labels were 
+    // assigned in the same order that growGrass() visits connected 
+    // components, so the label map is updated exactly as if the tile had 
+    // been unwrapped with bootstrapping.
+    auto bsphase = std::vector<float>(numTileLabels + 1, 0.f);
+    auto newlabels = std::vector<label_t>(numTileLabels + 1, 0);
+    for (size_t l = 1; l <= numTileLabels; ++l)
+    {
+        if (DO_BOOTSTRAP)
+        {
+            // Get mask of the connected component in the bootstrap lines.
+            for (size_t i = 0; i < bssize; ++i) { bscc[i] = (ccl[bsoff + i] == l); }
+
+            BootstrapStatus_t status = estimBootstrapPhase(
+                &bsphase[l], &unw[bsoff], bscc, bsunw, bsccl, width, 
+                _NumBsLines, _MinBsPts, _BsPhaseVarThr);
+
+            if (status == BootstrapFailure) { return false; }
+            if (status == BootstrapSuccess)
+            {
+                newlabels[l] = bootstrapLabel(
+                    labelmap, bscc, bsccl, width, _NumBsLines);
+                continue;
+            }
+        }
+
+        // Assign connected component a new unique label.
+        newlabels[l] = labelmap.nextlabel();
+    }
+
+    // Apply bootstrap phase and labels.
+    const size_t tilesize = length * width;
+    for (size_t i = 0; i < tilesize; ++i)
+    {
+        if (ccl[i] != 0)
+        {
+            unw[i] -= bsphase[ccl[i]];
+            ccl[i] = newlabels[ccl[i]];
+        }
+    }
+
+    return true;
+}
+
 // Explicit template instantiation
 template void ICU::growGrass<true>(
-    float * unw, uint8_t * ccl, bool * currcc, float * bsunw, uint8_t * bsccl, 
+    float * unw, label_t * ccl, bool * currcc, float * bsunw, label_t * bsccl, 
     LabelMap & labelmap, const float * phase, const bool * tree, 
     const float * corr, float corrthr, const size_t length, const size_t width);
 
 template void ICU::growGrass<false>(
-    float * unw, uint8_t * ccl, bool * currcc, float * bsunw, uint8_t * bsccl, 
+    float * unw, label_t * ccl, bool * currcc, float * bsunw, label_t * bsccl, 
     LabelMap & labelmap, const float * phase, const bool * tree, 
     const float * corr, float corrthr, const size_t length, const size_t width);
 
-}
+template bool ICU::bootstrapTile<true>(
+    float * unw, label_t * ccl, bool * bscc, const float * bsunw, 
+    const label_t * bsccl, LabelMap & labelmap, const size_t numTileLabels, 
+    const size_t length, const size_t width);
 
+template bool ICU::bootstrapTile<false>(
+    float * unw, label_t * ccl, bool * bscc, const float * bsunw, 
+    const label_t * bsccl, LabelMap & labelmap, const size_t numTileLabels, 
+    const size_t length, const size_t width);
+
+}
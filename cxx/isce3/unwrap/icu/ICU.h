@@ -3,11 +3,11 @@
 #include <array> // std::array
 #include <complex> // std::complex
 #include <cstddef> // size_t
-#include <cstdint> // uint8_t
+#include <cstdint> // uint32_t
 
 #include <isce3/io/Raster.h> // isce3::io::Raster
 
-#include "LabelMap.h" // LabelMap
+#include "LabelMap.h" // LabelMap, label_t
 
 namespace isce3::unwrap::icu
 {
@@ -117,6 +117,33 @@ public:
     /** Set bootstrap phase variance threshold (default: 8.0). */
     void bsPhaseVarThr(const float);
 
+    /** Get 32-bit connected component labels flag. */
+    bool use32BitLabels() const;
+    /** 
+     * Set 32-bit connected component labels flag (default: false).
+     *
+     * By default at most 255 connected components may be labelled and the 
+     * labels fit any connected component labels raster. With 32-bit labels, 
+     * up to 2^32 - 1 components may be labelled and the connected 
+     * component labels raster must have a 32-bit integer data type.
+     */
+    void use32BitLabels(const bool);
+
+    /** Get parallel tile processing flag. */
+    bool parallelTiles() const;
+    /** 
+     * Set parallel tile processing flag (default: false).
+     *
+     * If enabled, groups of consecutive tiles are unwrapped concurrently 
+     * (one tile per OpenMP thread) and their connected components are then 
+     * bootstrapped and labelled in tile order, at the cost of one set of 
+     * tile buffers per thread. Tiles with no connected components extending 
+     * into the bootstrap lines of the previous tile give identical results 
+     * to sequential processing. Otherwise results may differ by multiples 
+     * of 2 pi at branch cut pixels bordering more than one component.
+     */
+    void parallelTiles(const bool);
+
     /** 
      * \brief Unwrap the target interferogram.
      *
@@ -161,10 +188,10 @@ public:
     template<bool DO_BOOTSTRAP>
     void growGrass(
         float * unw,
-        uint8_t * ccl,
+        label_t * ccl,
         bool * currcc,
         float * bsunw,
-        uint8_t * bsccl, 
+        label_t * bsccl, 
         LabelMap & labelmap,
         const float * phase, 
         const bool * tree, 
@@ -173,6 +200,22 @@ public:
         const size_t length,
         const size_t width);
 
+    // Bootstrap phase and assign global labels to the connected components 
+    // of a tile that was unwrapped without bootstrapping. Returns false if 
+    // bootstrapping failed and the tile must be unwrapped again with 
+    // growGrass<true>.
+    template<bool DO_BOOTSTRAP>
+    bool bootstrapTile(
+        float * unw,
+        label_t * ccl,
+        bool * bscc,
+        const float * bsunw,
+        const label_t * bsccl,
+        LabelMap & labelmap,
+        const size_t numTileLabels,
+        const size_t length,
+        const size_t width);
+
 private:
     // Configuration params
     size_t _NumBufLines = 3700;
@@ -193,6 +236,8 @@ private:
     size_t _NumBsLines = 16;
     size_t _MinBsPts = 16;
     float _BsPhaseVarThr = 8.f;
+    bool _ParallelTiles = false;
+    bool _Use32BitLabels = false;
 };
 
 }
@@ -1,33 +1,49 @@
 #pragma once
 
 #include <cstddef> // size_t
-#include <cstdint> // uint8_t
+#include <cstdint> // uint32_t, UINT8_MAX
 #include <vector> // std::vector
 
 namespace isce3::unwrap::icu
 {
 
+// Connected component label type
+typedef uint32_t label_t;
+
 // \brief Table of connected component label equivalences
 //
 // Maintains a list of all connected component labels along with a mapping 
-// to their minimum equivalent label.
+// to their minimum equivalent label. Equivalences are stored as a union-find 
+// forest (each class is rooted at its minimum label) with path compression, 
+// so merging and looking up labels take near-constant time regardless of the 
+// number of labels.
 class LabelMap
 {
 public:
-    // Constructor
-    LabelMap();
+    // Constructor (maxlabel is the largest label that may be issued)
+    LabelMap(const label_t maxlabel = UINT8_MAX);
     // Add new label to table and return the label.
-    uint8_t nextlabel();
+    label_t nextlabel();
     // Get mapped label.
-    uint8_t getlabel(const uint8_t) const;
-    // Update a label mapping.
-    void setlabel(const uint8_t oldlabel, const uint8_t newlabel);
+    label_t getlabel(const label_t) const;
+    // Update a label mapping (merge the equivalence classes of the two 
+    // labels).
+    void setlabel(const label_t oldlabel, const label_t newlabel);
     // Get number of labels.
     size_t size() const;
+    // Point every label directly at its minimum equivalent label, after 
+    // which getlabel() is a single lookup.
+    void flatten();
 
 private:
-    // Table of label mappings.
-    std::vector<uint8_t> _labels;
+    // Get the root of a label's equivalence class, compressing the path.
+    label_t find(label_t) const;
+
+    // Parent of each label in the union-find forest (roots are their own 
+    // parents)
+    mutable std::vector<label_t> _parents;
+    // Max label
+    label_t _maxlabel;
 };
 
 }
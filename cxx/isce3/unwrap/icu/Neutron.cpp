@@ -1,6 +1,7 @@
 #include <cmath> // sqrt
 #include <complex> // std::abs
 #include <exception> // std::out_of_range
+#include <memory> // std::unique_ptr
 
 #include "ICU.h" // ICU
 #include "PhaseGrad.h" // calcPhaseGrad
@@ -17,29 +18,29 @@ void ICU::genNeutrons(
 {
     // Init neutrons.
     const size_t tilesize = length * width;
+    #pragma omp parallel for
     for (size_t i = 0; i < tilesize; ++i) { neut[i] = false; }
 
     if (_UsePhaseGradNeut)
     {
         // Compute phase gradient along range, azimuth.
-        auto phasegradx = new float[tilesize];
-        auto phasegrady = new float[tilesize];
-        calcPhaseGrad(phasegradx, phasegrady, intf, length, width, _PhaseGradWinSize);
+        std::unique_ptr<float[]> phasegradx(new float[tilesize]);
+        std::unique_ptr<float[]> phasegrady(new float[tilesize]);
+        calcPhaseGrad(phasegradx.get(), phasegrady.get(), intf, length, width, _PhaseGradWinSize);
 
         // Get phase gradient neutrons.
+        #pragma omp parallel for
         for (size_t i = 0; i < tilesize; ++i)
         { 
             neut[i] |= std::abs(phasegradx[i]) > _NeutPhaseGradThr;
         }
-
-        delete[] phasegradx;
-        delete[] phasegrady;
     }
 
     if (_UseIntensityNeut)
     {
         // Compute interferogram intensity.
-        auto intensity = new float[tilesize];
+        std::unique_ptr<float[]> intensity(new float[tilesize]);
+        #pragma omp parallel for
         for (size_t i = 0; i < tilesize; ++i)
         {
             std::complex<float> z = intf[i];
@@ -80,12 +81,11 @@ void ICU::genNeutrons(
         const float intensitythr = mu + _NeutIntensityThr * sigma;
 
         // Get intensity neutrons.
+        #pragma omp parallel for
         for (size_t i = 0; i < tilesize; ++i)
         {
             neut[i] |= (intensity[i] > intensitythr) && (corr[i] < _NeutCorrThr);
         }
-
-        delete[] intensity;
     }
 }
 
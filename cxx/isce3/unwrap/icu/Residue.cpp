@@ -14,6 +14,7 @@ void ICU::getResidues(
     constexpr float twopi = 2.f * M_PI;
 
     // Get residue charge at each pixel (except last row & col).
+    #pragma omp parallel for
     for (size_t j = 0; j < length-1; ++j)
     {
         for (size_t i = 0; i < width-1; ++i)
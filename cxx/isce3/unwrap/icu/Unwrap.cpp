@@ -1,12 +1,76 @@
+#include <algorithm> // std::min, std::sort, std::unique, std::none_of
 #include <complex> // std::complex, std::arg
+#include <cstdint> // UINT8_MAX, UINT32_MAX
 #include <cstring> // std::memcpy
-#include <exception> // std::domain_error
+#include <exception> // std::domain_error, std::exception_ptr
+#include <memory> // std::unique_ptr
+#include <stdexcept> // std::invalid_argument, std::runtime_error
+#include <vector> // std::vector
 
-#include "ICU.h" // ICU, isce3::io::Raster, size_t, uint8_t
+#ifdef _OPENMP
+#include <omp.h> // omp_get_max_threads
+#endif
+
+#include "ICU.h" // ICU, LabelMap, label_t, isce3::io::Raster, size_t
 
 namespace isce3::unwrap::icu
 {
 
+namespace
+{
+
+// Buffers for unwrapping a single tile
+struct TileBuffers
+{
+    TileBuffers(const size_t bufsize)
+    :
+        intf(new std::complex<float>[bufsize]),
+        corr(new float[bufsize]),
+        unw(new float[bufsize]),
+        ccl(new label_t[bufsize]),
+        phase(new float[bufsize]),
+        charge(new signed char[bufsize]),
+        neut(new bool[bufsize]),
+        tree(new bool[bufsize]),
+        currcc(new bool[bufsize])
+    {}
+
+    std::unique_ptr<std::complex<float>[]> intf;
+    std::unique_ptr<float[]> corr;
+    std::unique_ptr<float[]> unw;
+    std::unique_ptr<label_t[]> ccl;
+    std::unique_ptr<float[]> phase;
+    std::unique_ptr<signed char[]> charge;
+    std::unique_ptr<bool[]> neut;
+    std::unique_ptr<bool[]> tree;
+    std::unique_ptr<bool[]> currcc;
+
+    // Number of connected component labels used by the tile
+    size_t numLabels = 0;
+    // Exception thrown while processing the tile
+    std::exception_ptr error;
+};
+
+// Get the distinct connected component labels in a tile.
+std::vector<label_t> tileLabels(const label_t * ccl, const size_t tilesize)
+{
+    std::vector<label_t> labels;
+    label_t prev = 0;
+    for (size_t i = 0; i < tilesize; ++i)
+    {
+        if (ccl[i] != 0 && ccl[i] != prev)
+        {
+            labels.push_back(ccl[i]);
+            prev = ccl[i];
+        }
+    }
+    std::sort(labels.begin(), labels.end());
+    labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+    return labels;
+}
+
+}
+
 void ICU::unwrap(
     isce3::io::Raster & unw,
     isce3::io::Raster & ccl,
@@ -17,34 +81,6 @@ void ICU::unwrap(
     // Raster dims
     const size_t length = intf.length();
     const size_t width = intf.width();
-    
-    // Buffers for single tile from each input, output Raster
-    const size_t bufsize = _NumBufLines * width;
-    auto intftile = new std::complex<float>[bufsize];
-    auto corrtile = new float[bufsize];
-    auto unwtile = new float[bufsize];
-    auto ccltile = new uint8_t[bufsize];
-
-    // Wrapped phase
-    auto phase = new float[bufsize];
-
-    // Residue charges and neutrons
-    auto charge = new signed char[bufsize];
-    auto neut = new bool[bufsize];
-
-    // Branch cuts
-    auto tree = new bool[bufsize];
-
-    // Current connected component
-    auto currcc = new bool[bufsize];
-
-    // Bootstrap lines (unwrapped phase and connected component labels)
-    const size_t bssize = _NumBsLines * width;
-    auto bsunw = new float[bssize];
-    auto bslabels = new uint8_t[bssize];
-
-    // Table of connected component label equivalences
-    auto labelmap = LabelMap();
 
     // Number of lines to next tile
     const size_t step = _NumBufLines - _NumOverlapLines;
@@ -61,108 +97,225 @@ void ICU::unwrap(
         if (length % step <= _NumOverlapLines) { --ntiles; }
     }
 
-    // Loop over tiles.
-    for (int t = 0; t < ntiles; ++t)
-    {
-        // Read interferogram, correlation lines.
-        size_t startline = t * step;
-        size_t tilelen = std::min(_NumBufLines, length - startline);
-        intf.getBlock(intftile, 0, startline, width, tilelen);
-        corr.getBlock(corrtile, 0, startline, width, tilelen);
+    // Number of tiles unwrapped concurrently
+    int nslots = 1;
+#ifdef _OPENMP
+    if (_ParallelTiles) { nslots = std::min(omp_get_max_threads(), ntiles); }
+#endif
 
-        // Compute wrapped phase.
-        size_t tilesize = tilelen * width;
-        for (size_t i = 0; i < tilesize; ++i) { phase[i] = std::arg(intftile[i]); }
-
-        // Get residue charges.
-        getResidues(charge, phase, tilelen, width);
-
-        // Generate neutrons to guide the tree-growing process.
-        genNeutrons(neut, intftile, corrtile, tilelen, width);
+    // Buffers for single tile from each input, output Raster (one set per 
+    // concurrently processed tile)
+    const size_t bufsize = _NumBufLines * width;
+    std::vector<TileBuffers> slots;
+    slots.reserve(nslots);
+    for (int s = 0; s < nslots; ++s) { slots.emplace_back(bufsize); }
 
-        // Grow trees (make branch cuts).
-        growTrees(tree, charge, neut, tilelen, width, seed);
+    // Bootstrap lines (unwrapped phase and connected component labels)
+    const size_t bssize = _NumBsLines * width;
+    std::unique_ptr<float[]> bsunw(new float[bssize]);
+    std::unique_ptr<label_t[]> bslabels(new label_t[bssize]);
 
-        // Grow grass (find connected components and unwrap phase). If not first 
-        // tile, bootstrap phase from previous tile.
-        if (t == 0)
-        {
-            growGrass<false>(
-                unwtile, ccltile, currcc, bsunw, bslabels, labelmap, phase, 
-                tree, corrtile, _InitCorrThr, tilelen, width);
-        }
-        else
-        {
-            growGrass<true>(
-                unwtile, ccltile, currcc, bsunw, bslabels, labelmap, phase, 
-                tree, corrtile, _InitCorrThr, tilelen, width);
-        }
+    // Offset to first bootstrap line of the next tile from start of tile
+    const size_t bsoff = (_NumBufLines -_NumOverlapLines/2 - _NumBsLines/2) * width;
 
-        // If not last tile, get bootstrap data for processing next tile.
-        if (t < ntiles-1)
-        {
-            // Offset to first bootstrap line from start of tile
-            size_t bsoff = (_NumBufLines -_NumOverlapLines/2 - _NumBsLines/2) * width;
+    // Max connected component label
+    const label_t maxlabel = _Use32BitLabels ? UINT32_MAX : UINT8_MAX;
+    if (_Use32BitLabels && ccl.dtype() != GDT_UInt32 && ccl.dtype() != GDT_Int32)
+    {
+        throw std::invalid_argument("32-bit labels require a 32-bit integer connected component labels raster");
+    }
 
-            // Copy bootstrap lines.
-            std::memcpy(bsunw, &unwtile[bsoff], _NumBsLines * width * sizeof(float));
-            std::memcpy(bslabels, &ccltile[bsoff], _NumBsLines * width * sizeof(uint8_t));
-        }
+    // Table of connected component label equivalences
+    auto labelmap = LabelMap(maxlabel);
 
-        // Write out unwrapped phase, connected component labels.
-        unw.setBlock(unwtile, 0, startline, width, tilelen);
-        ccl.setBlock(ccltile, 0, startline, width, tilelen);
-    }
+    // Distinct labels written out for each tile
+    std::vector<std::vector<label_t>> labelsPerTile(ntiles);
 
-    // If all label mappings are identity, then each connected component is 
-    // labelled properly and we are finished. Otherwise, go back and merge 
-    // redundant labels.
-    bool doUpdateLabels = false;
-    for (uint8_t l = 1; l < labelmap.size(); ++l)
+    if (nslots == 1)
     {
-        if (labelmap.getlabel(l) != l) 
-        { 
-            doUpdateLabels = true; 
-            break;
-        }
-    }
+        TileBuffers & b = slots[0];
 
-    if (doUpdateLabels)
-    {
         // Loop over tiles.
         for (int t = 0; t < ntiles; ++t)
         {
-            // Read connected component labels.
+            // Read interferogram, correlation lines.
             size_t startline = t * step;
             size_t tilelen = std::min(_NumBufLines, length - startline);
-            ccl.getBlock(ccltile, 0, startline, width, tilelen);
+            intf.getBlock(b.intf.get(), 0, startline, width, tilelen);
+            corr.getBlock(b.corr.get(), 0, startline, width, tilelen);
 
-            // Update labels.
+            // Compute wrapped phase.
             size_t tilesize = tilelen * width;
-            for (size_t i = 0; i < tilesize; ++i)
+            #pragma omp parallel for
+            for (size_t i = 0; i < tilesize; ++i) { b.phase[i] = std::arg(b.intf[i]); }
+
+            // Get residue charges.
+            getResidues(b.charge.get(), b.phase.get(), tilelen, width);
+
+            // Generate neutrons to guide the tree-growing process.
+            genNeutrons(b.neut.get(), b.intf.get(), b.corr.get(), tilelen, width);
+
+            // Grow trees (make branch cuts).
+            growTrees(b.tree.get(), b.charge.get(), b.neut.get(), tilelen, width, seed);
+
+            // Grow grass (find connected components and unwrap phase). If not 
+            // first tile, bootstrap phase from previous tile.
+            if (t == 0)
+            {
+                growGrass<false>(
+                    b.unw.get(), b.ccl.get(), b.currcc.get(), bsunw.get(), bslabels.get(), 
+                    labelmap, b.phase.get(), b.tree.get(), b.corr.get(), 
+                    _InitCorrThr, tilelen, width);
+            }
+            else
+            {
+                growGrass<true>(
+                    b.unw.get(), b.ccl.get(), b.currcc.get(), bsunw.get(), bslabels.get(), 
+                    labelmap, b.phase.get(), b.tree.get(), b.corr.get(), 
+                    _InitCorrThr, tilelen, width);
+            }
+
+            // If not last tile, get bootstrap data for processing next tile.
+            if (t < ntiles-1)
+            {
+                std::memcpy(bsunw.get(), &b.unw[bsoff], bssize * sizeof(float));
+                std::memcpy(bslabels.get(), &b.ccl[bsoff], bssize * sizeof(label_t));
+            }
+
+            // Write out unwrapped phase, connected component labels.
+            unw.setBlock(b.unw.get(), 0, startline, width, tilelen);
+            ccl.setBlock(b.ccl.get(), 0, startline, width, tilelen);
+            labelsPerTile[t] = tileLabels(b.ccl.get(), tilesize);
+        }
+    }
+    else
+    {
+        // Loop over groups of consecutive tiles.
+        for (int t0 = 0; t0 < ntiles; t0 += nslots)
+        {
+            const int ngroup = std::min(nslots, ntiles - t0);
+
+            // Unwrap each tile of the group independently, with tile-local 
+            // connected component labels.
+            #pragma omp parallel for schedule(dynamic)
+            for (int s = 0; s < ngroup; ++s)
             {
-                if (ccltile[i] != 0)
+                TileBuffers & b = slots[s];
+                try
                 {
-                    ccltile[i] = labelmap.getlabel(ccltile[i]);
+                    size_t startline = (t0 + s) * step;
+                    size_t tilelen = std::min(_NumBufLines, length - startline);
+                    #pragma omp critical(icu_raster_io)
+                    {
+                        intf.getBlock(b.intf.get(), 0, startline, width, tilelen);
+                        corr.getBlock(b.corr.get(), 0, startline, width, tilelen);
+                    }
+
+                    size_t tilesize = tilelen * width;
+                    for (size_t i = 0; i < tilesize; ++i) { b.phase[i] = std::arg(b.intf[i]); }
+
+                    getResidues(b.charge.get(), b.phase.get(), tilelen, width);
+                    genNeutrons(b.neut.get(), b.intf.get(), b.corr.get(), tilelen, width);
+                    growTrees(b.tree.get(), b.charge.get(), b.neut.get(), tilelen, width, seed);
+
+                    auto tilelabels = LabelMap(maxlabel);
+                    growGrass<false>(
+                        b.unw.get(), b.ccl.get(), b.currcc.get(), nullptr, nullptr, 
+                        tilelabels, b.phase.get(), b.tree.get(), b.corr.get(), 
+                        _InitCorrThr, tilelen, width);
+                    b.numLabels = tilelabels.size() - 1;
+                }
+                catch (...)
+                {
+                    b.error = std::current_exception();
                 }
             }
 
-            // Write out updated labels.
-            ccl.setBlock(ccltile, 0, startline, width, tilelen);
+            // Bootstrap phase from the previous tile, assign global labels and 
+            // write out the tiles in order.
+            for (int s = 0; s < ngroup; ++s)
+            {
+                TileBuffers & b = slots[s];
+                if (b.error) { std::rethrow_exception(b.error); }
+
+                const int t = t0 + s;
+                size_t startline = t * step;
+                size_t tilelen = std::min(_NumBufLines, length - startline);
+
+                bool bootstrapped;
+                if (t == 0)
+                {
+                    bootstrapped = bootstrapTile<false>(
+                        b.unw.get(), b.ccl.get(), b.currcc.get(), bsunw.get(), bslabels.get(), 
+                        labelmap, b.numLabels, tilelen, width);
+                }
+                else
+                {
+                    bootstrapped = bootstrapTile<true>(
+                        b.unw.get(), b.ccl.get(), b.currcc.get(), bsunw.get(), bslabels.get(), 
+                        labelmap, b.numLabels, tilelen, width);
+                }
+
+                // If bootstrapping failed, unwrap the tile again with increased 
+                // correlation threshold, as growGrass<true>() would have.
+                if (!bootstrapped)
+                {
+                    if (!(_InitCorrThr < _MaxCorrThr))
+                    {
+                        throw std::runtime_error("failed to unwrap tile at max correlation threshold");
+                    }
+                    growGrass<true>(
+                        b.unw.get(), b.ccl.get(), b.currcc.get(), bsunw.get(), bslabels.get(), 
+                        labelmap, b.phase.get(), b.tree.get(), b.corr.get(), 
+                        _InitCorrThr + _CorrThrInc, tilelen, width);
+                }
+
+                if (t < ntiles-1)
+                {
+                    std::memcpy(bsunw.get(), &b.unw[bsoff], bssize * sizeof(float));
+                    std::memcpy(bslabels.get(), &b.ccl[bsoff], bssize * sizeof(label_t));
+                }
+
+                unw.setBlock(b.unw.get(), 0, startline, width, tilelen);
+                ccl.setBlock(b.ccl.get(), 0, startline, width, tilelen);
+                labelsPerTile[t] = tileLabels(b.ccl.get(), tilelen * width);
+            }
         }
     }
 
-    delete[] intftile;
-    delete[] corrtile;
-    delete[] unwtile;
-    delete[] ccltile;
-    delete[] phase;
-    delete[] charge;
-    delete[] neut;
-    delete[] tree;
-    delete[] bsunw;
-    delete[] bslabels;
-}
+    // Resolve all label equivalences. Tiles whose labels all map to 
+    // themselves are labelled properly; go back and merge redundant labels in 
+    // the others.
+    labelmap.flatten();
+
+    auto ccltile = slots[0].ccl.get();
+    for (int t = 0; t < ntiles; ++t)
+    {
+        const auto & labels = labelsPerTile[t];
+        if (std::none_of(labels.begin(), labels.end(), 
+                [&](label_t l) { return labelmap.getlabel(l) != l; }))
+        {
+            continue;
+        }
+
+        // Read connected component labels.
+        size_t startline = t * step;
+        size_t tilelen = std::min(_NumBufLines, length - startline);
+        ccl.getBlock(ccltile, 0, startline, width, tilelen);
 
+        // Update labels.
+        size_t tilesize = tilelen * width;
+        for (size_t i = 0; i < tilesize; ++i)
+        {
+            if (ccltile[i] != 0)
+            {
+                ccltile[i] = labelmap.getlabel(ccltile[i]);
+            }
+        }
+
+        // Write out updated labels.
+        ccl.setBlock(ccltile, 0, startline, width, tilelen);
+    }
 }
 
+}
@@ -4,7 +4,123 @@
 // Author: Heresh Fattahi
 // Copyright 2019-
 
+#include <algorithm> // std::min, std::sort, std::unique, std::none_of
+#include <cmath> // std::rint
+#include <map> // std::map
+#include <stdexcept> // std::domain_error
+#include <tuple> // std::tuple
+#include <utility> // std::pair
+#include <vector> // std::vector
+
 #include "Phass.h"
+#include "ASSP.h" // no_data_value
+
+namespace {
+
+// Contiguous block of lines along with the line pointers used by the PHASS 
+// core
+template<class T>
+struct Lines
+{
+    Lines(const size_t nrows, const size_t ncols) : data(nrows * ncols), rows(nrows)
+    {
+        for (size_t line = 0; line < nrows; ++line) { rows[line] = &data[line * ncols]; }
+    }
+
+    std::vector<T> data;
+    std::vector<T *> rows;
+};
+
+// Equivalences between the regions of different tiles
+//
+// Regions are stored in a union-find forest rooted at the minimum equivalent 
+// label. Along with its parent, each region keeps the number of cycles to add 
+// to its unwrapped phase to make it consistent with its parent.
+class RegionLinks
+{
+public:
+    RegionLinks() : _parents(1, 0), _cycles(1, 0) {}
+
+    // Add a new region and return its label (labels start at 1).
+    int add()
+    {
+        int label = _parents.size();
+        _parents.push_back(label);
+        _cycles.push_back(0);
+        return label;
+    }
+
+    // Get the root of a region and the cycles from the region to its root.
+    int find(const int label, int & cycles)
+    {
+        int root = label;
+        cycles = 0;
+        while (_parents[root] != root)
+        {
+            cycles += _cycles[root];
+            root = _parents[root];
+        }
+
+        // Compress path.
+        int node = label;
+        int remaining = cycles;
+        while (node != root)
+        {
+            int next = _parents[node];
+            int step = _cycles[node];
+            _parents[node] = root;
+            _cycles[node] = remaining;
+            remaining -= step;
+            node = next;
+        }
+        return root;
+    }
+
+    // Merge two regions, given the cycles to add to the first one to make it 
+    // consistent with the second one.
+    void merge(const int a, const int b, const int cycles)
+    {
+        int ca, cb;
+        int ra = find(a, ca);
+        int rb = find(b, cb);
+        if (ra == rb) { return; }
+
+        if (ra < rb)
+        {
+            _parents[rb] = ra;
+            _cycles[rb] = ca - cycles - cb;
+        }
+        else
+        {
+            _parents[ra] = rb;
+            _cycles[ra] = cycles + cb - ca;
+        }
+    }
+
+private:
+    std::vector<int> _parents;
+    std::vector<int> _cycles;
+};
+
+// Get the distinct region labels in a block of lines.
+std::vector<int> blockLabels(const int * labels, const size_t size)
+{
+    std::vector<int> distinct;
+    int prev = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (labels[i] != 0 && labels[i] != prev)
+        {
+            distinct.push_back(labels[i]);
+            prev = labels[i];
+        }
+    }
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    return distinct;
+}
+
+}
 
 /**
  * @param[in] phaseRaster wrapped phase
@@ -43,83 +159,207 @@ unwrap(isce3::io::Raster & phaseRaster,
         isce3::io::Raster & unwRaster,
         isce3::io::Raster & labelRaster)
 {
+    const size_t nrows = phaseRaster.length();
+    const size_t ncols = phaseRaster.width();
 
-    int nrows = phaseRaster.length();
-    int ncols = phaseRaster.width();
+    // Tile dims
+    size_t buflines = nrows;
+    size_t overlap = 0;
+    int ntiles = 1;
+    if (_numBufLines > 0 && nrows > _numBufLines)
+    {
+        if (_numOverlapLines >= _numBufLines)
+        {
+            throw std::domain_error("number of overlap lines must be less than number of buffer lines");
+        }
+        buflines = _numBufLines;
+        overlap = _numOverlapLines;
+        const size_t step = buflines - overlap;
+        ntiles = 1 + (nrows - buflines + step-1) / step;
+    }
+    const size_t step = buflines - overlap;
 
-    float *phase_data_1D = new float[nrows*ncols];
-    float *corr_data_1D = new float[nrows*ncols];
-    float *power_data_1D = new float[nrows*ncols];
+    // Tile buffers, reused for all tiles
+    Lines<float> phase(buflines, ncols);
+    Lines<float> corr(buflines, ncols);
+    Lines<float> power(_usePower ? buflines : 0, ncols);
+    Lines<int> regions(buflines, ncols);
+    std::vector<int> labels(buflines * ncols);
 
-    phaseRaster.getBlock(phase_data_1D, 0, 0, ncols, nrows);
-    corrRaster.getBlock(corr_data_1D, 0, 0, ncols, nrows);
+    // Unwrapped phase, labels of the overlapping lines of the previous tile
+    std::vector<float> prevunw(overlap * ncols);
+    std::vector<int> prevlabels(overlap * ncols);
 
-    if (_usePower) {
-        powerRaster.getBlock(power_data_1D, 0, 0, ncols, nrows);
-    }
+    // Region equivalences across tiles
+    RegionLinks links;
 
-    float **phase_data  = new float*[nrows];
-    float **corr_data   = new float*[nrows]; 
-    float **power_data  = new float*[nrows];
-        
-        
-    int **region_map = new int*[nrows];
-    for (int line=0; line<nrows; line++){
-        region_map[line] = new int[ncols];
-    }
+    // Distinct labels written out for each tile
+    std::vector<std::vector<int>> labelsPerTile(ntiles);
 
-    for (int line = 0 ; line < nrows ; ++line) {
-        phase_data[line] = &phase_data_1D[line*ncols];
-        corr_data[line] = &corr_data_1D[line*ncols];
-    }
+    const double two_pi = 2.0 * PI;
+
+    // Loop over tiles.
+    for (int t = 0; t < ntiles; ++t)
+    {
+        const size_t startline = t * step;
+        const size_t tilelen = std::min(buflines, nrows - startline);
+        const size_t tilesize = tilelen * ncols;
 
-    if (_usePower) {
-        for (int line = 0 ; line < nrows ; ++line) {
-            power_data[line] = &power_data_1D[line*ncols];
+        phaseRaster.getBlock(phase.data.data(), 0, startline, ncols, tilelen);
+        corrRaster.getBlock(corr.data.data(), 0, startline, ncols, tilelen);
+        if (_usePower) {
+            powerRaster.getBlock(power.data.data(), 0, startline, ncols, tilelen);
         }
-    } else {
-        power_data  = NULL;
-    }
 
+        phass_unwrap(tilelen, ncols, 
+                    phase.rows.data(), corr.rows.data(), 
+                    _usePower ? power.rows.data() : NULL, regions.rows.data(), 
+                    _correlationThreshold, _goodCorrelation, _minPixelsPerRegion); 
 
-    phass_unwrap(nrows, ncols, 
-                phase_data, corr_data, power_data, region_map,
-                _correlationThreshold, _goodCorrelation,  _minPixelsPerRegion); 
+        // Number of regions in tile
+        int nregions = 0;
+        for (size_t i = 0; i < tilesize; ++i) {
+            nregions = std::max(nregions, regions.data[i] + 1);
+        }
+
+        // Label, number of cycles to add to the unwrapped phase of each 
+        // region
+        std::vector<int> regionlabels(nregions);
+        std::vector<int> regioncycles(nregions, 0);
 
-    for (size_t line = 0; line < nrows; ++line) {
-        for (size_t col = 0; col < ncols; ++col) {
-            phase_data_1D[line*ncols + col] = phase_data[line][col];
+        if (ntiles == 1)
+        {
+            for (int r = 0; r < nregions; ++r) { regionlabels[r] = r + 1; }
         }
-    }
+        else
+        {
+            // Count the cycles between the unwrapped phase of this tile and 
+            // the previous one for each pair of overlapping regions.
+            std::map<std::tuple<int, int, int>, size_t> votes;
+            for (size_t i = 0; t > 0 && i < overlap * ncols; ++i)
+            {
+                if (regions.data[i] < 0 || prevlabels[i] == 0 || 
+                    phase.data[i] == no_data_value || prevunw[i] == no_data_value) 
+                { 
+                    continue; 
+                }
+                int cycles = std::rint((prevunw[i] - phase.data[i]) / two_pi);
+                ++votes[std::make_tuple(regions.data[i], prevlabels[i], cycles)];
+            }
 
-    unwRaster.setBlock(phase_data_1D, 0, 0, ncols, nrows);
+            // Most common number of cycles and number of overlapping pixels 
+            // of each pair of regions
+            std::map<std::pair<int, int>, std::pair<int, size_t>> pairs;
+            std::map<std::pair<int, int>, size_t> best;
+            for (const auto & vote : votes)
+            {
+                auto key = std::make_pair(std::get<0>(vote.first), std::get<1>(vote.first));
+                auto & pair = pairs[key];
+                if (vote.second > best[key]) 
+                { 
+                    best[key] = vote.second; 
+                    pair.first = std::get<2>(vote.first);
+                }
+                pair.second += vote.second;
+            }
 
-    float *labels_1D = new float[nrows*ncols];
-    for (size_t line = 0; line < nrows; ++line) {
-        for (size_t col = 0; col < ncols; ++col) {
-            labels_1D[line*ncols + col] = region_map[line][col] + 1;
+            // Previous region with the most overlapping pixels for each 
+            // region
+            std::vector<int> match(nregions, 0);
+            std::vector<size_t> matchsize(nregions, 0);
+            for (const auto & pair : pairs)
+            {
+                int r = pair.first.first;
+                if (pair.second.second > matchsize[r])
+                {
+                    match[r] = pair.first.second;
+                    matchsize[r] = pair.second.second;
+                    regioncycles[r] = pair.second.first;
+                }
+            }
+
+            // Regions of the previous tile that overlap the same region are 
+            // equivalent.
+            for (const auto & pair : pairs)
+            {
+                int r = pair.first.first;
+                int g = pair.first.second;
+                if (g != match[r])
+                {
+                    links.merge(g, match[r], regioncycles[r] - pair.second.first);
+                }
+            }
+
+            // Each region takes the label of its match, and new labels are 
+            // issued for the rest.
+            for (int r = 0; r < nregions; ++r)
+            {
+                if (match[r] == 0) 
+                { 
+                    regionlabels[r] = links.add(); 
+                    continue;
+                }
+                int cycles;
+                regionlabels[r] = links.find(match[r], cycles);
+                regioncycles[r] += cycles;
+            }
         }
-    }
 
-    labelRaster.setBlock(labels_1D, 0, 0, ncols, nrows);
-    
-    /*for (int line = 0; line <nrows; ++line) {
-        std::cout << line << std::endl;
-        delete[] phase_data[line];
-        delete[] corr_data[line];
-        delete[] power_data[line];
-        delete[] region_map[line];
-    }*/ 
-
-    delete[] labels_1D;
-    delete[] phase_data_1D;
-    delete[] power_data_1D;
-
-    delete[] phase_data;
-    delete[] corr_data;
-    delete[] power_data;
-    delete[] region_map;   
+        // Apply the labels and cycles to the tile.
+        for (size_t i = 0; i < tilesize; ++i)
+        {
+            int r = regions.data[i];
+            labels[i] = (r < 0) ? 0 : regionlabels[r];
+            if (r >= 0 && regioncycles[r] != 0 && phase.data[i] != no_data_value)
+            {
+                phase.data[i] += regioncycles[r] * two_pi;
+            }
+        }
 
-}
+        // Keep the overlapping lines for the next tile.
+        if (t < ntiles-1)
+        {
+            std::copy(&phase.data[step * ncols], &phase.data[tilesize], prevunw.begin());
+            std::copy(&labels[step * ncols], &labels[tilesize], prevlabels.begin());
+        }
 
+        // Write out the lines of the tile up to the middle of the overlaps.
+        const size_t first = (t == 0) ? 0 : overlap/2;
+        const size_t last = (t == ntiles-1) ? tilelen : tilelen - (overlap - overlap/2);
+        unwRaster.setBlock(&phase.data[first * ncols], 0, startline + first, ncols, last - first);
+        labelRaster.setBlock(&labels[first * ncols], 0, startline + first, ncols, last - first);
+        labelsPerTile[t] = blockLabels(&labels[first * ncols], (last - first) * ncols);
+    }
 
+    // Go back and merge the regions found to be equivalent by later tiles.
+    for (int t = 0; ntiles > 1 && t < ntiles; ++t)
+    {
+        const auto & tilelabels = labelsPerTile[t];
+        if (std::none_of(tilelabels.begin(), tilelabels.end(), 
+                [&](int l) { int cycles; return links.find(l, cycles) != l || cycles != 0; }))
+        {
+            continue;
+        }
+
+        const size_t startline = t * step;
+        const size_t tilelen = std::min(buflines, nrows - startline);
+        const size_t first = (t == 0) ? 0 : overlap/2;
+        const size_t last = (t == ntiles-1) ? tilelen : tilelen - (overlap - overlap/2);
+        const size_t blocksize = (last - first) * ncols;
+
+        unwRaster.getBlock(phase.data.data(), 0, startline + first, ncols, last - first);
+        labelRaster.getBlock(labels.data(), 0, startline + first, ncols, last - first);
+        for (size_t i = 0; i < blocksize; ++i)
+        {
+            if (labels[i] == 0) { continue; }
+            int cycles;
+            labels[i] = links.find(labels[i], cycles);
+            if (cycles != 0 && phase.data[i] != no_data_value)
+            {
+                phase.data[i] += cycles * two_pi;
+            }
+        }
+        unwRaster.setBlock(phase.data.data(), 0, startline + first, ncols, last - first);
+        labelRaster.setBlock(labels.data(), 0, startline + first, ncols, last - first);
+    }
+}
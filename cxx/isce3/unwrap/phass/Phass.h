@@ -63,12 +63,34 @@ public:
     /** Set minimum size of a region to be unwrapped. */
     void minPixelsPerRegion(const int);
 
+    /** Get number of lines per tile. */
+    size_t numBufLines() const;
+
+    /** 
+     * Set number of lines per tile (default: 0).
+     *
+     * Images longer than this are unwrapped one tile of lines at a time, 
+     * so that memory use is bounded by the tile size rather than the image 
+     * size. Regions of adjacent tiles are merged, and their unwrapped phase 
+     * made consistent, based on the overlapping lines. If zero, the whole 
+     * image is unwrapped at once.
+     */
+    void numBufLines(const size_t);
+
+    /** Get number of overlapping lines between tiles. */
+    size_t numOverlapLines() const;
+
+    /** Set number of overlapping lines between tiles (default: 200). */
+    void numOverlapLines(const size_t);
+
 
     private:
         double _correlationThreshold = 0.2;
         double _goodCorrelation = 0.7; 
         int _minPixelsPerRegion = 200.0;
         bool _usePower = true;
+        size_t _numBufLines = 0;
+        size_t _numOverlapLines = 200;
 
 };
 
@@ -138,7 +138,9 @@ void addbinding(py::class_<LUT2d<T>> &pyLUT2d)
         .def_property_readonly("data", [](const LUT2d<T>& self) {
             return self.data().map();
         })
-        .def("eval", &LUT2d<T>::eval)
+        .def("eval", py::overload_cast<double, double>(&LUT2d<T>::eval,
+                                                       py::const_))
+        .def("eval_dx", &LUT2d<T>::eval_dx)
         ;
 }
 
@@ -13,7 +13,17 @@ namespace py = pybind11;
 
 void addbinding_geocodeslc(py::module & m)
 {
-    m.def("geocode_slc", &isce3::geocode::geocodeSlc,
+    m.def("geocode_slc",
+        py::overload_cast<isce3::io::Raster &, isce3::io::Raster &,
+                isce3::io::Raster &,
+                const isce3::product::RadarGridParameters &,
+                const isce3::product::GeoGridParameters &,
+                const isce3::core::Orbit &,
+                const isce3::core::LUT2d<double> &,
+                const isce3::core::LUT2d<double> &,
+                const isce3::core::Ellipsoid &, const double &, const int &,
+                const size_t &, const double &, const bool>(
+                &isce3::geocode::geocodeSlc),
         py::arg("output_raster"),
         py::arg("input_raster"),
         py::arg("dem_raster"),
@@ -34,8 +34,10 @@ void addbinding(pybind11::class_<DI> & pyDEMInterpolator)
             py::arg("raster"), py::arg("min_x"), py::arg("max_x"),
                 py::arg("min_y"), py::arg("max_y"))
 
-        .def("interpolate_lonlat", &DI::interpolateLonLat)
-        .def("interpolate_xy", &DI::interpolateXY)
+        .def("interpolate_lonlat", py::overload_cast<double, double>(
+                    &DI::interpolateLonLat, py::const_))
+        .def("interpolate_xy", py::overload_cast<double, double>(
+                    &DI::interpolateXY, py::const_))
 
         .def_property("ref_height",
             py::overload_cast<>(&DI::refHeight, py::const_),
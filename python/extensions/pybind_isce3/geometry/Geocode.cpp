@@ -30,6 +30,9 @@ void addbinding(py::class_<Geocode<T>> &pyGeocode)
         .def_property("lines_per_block", nullptr, &Geocode<T>::linesPerBlock)
         .def_property("dem_block_margin", nullptr, &Geocode<T>::demBlockMargin)
         .def_property("radar_block_margin", nullptr, &Geocode<T>::radarBlockMargin)
+        .def_property("deterministic",
+                py::overload_cast<>(&Geocode<T>::deterministic, py::const_),
+                py::overload_cast<bool>(&Geocode<T>::deterministic))
         .def_property("interpolator",
                 nullptr,
                 [](Geocode<T> & self, std::string & method)
@@ -51,5 +51,13 @@ void addbinding(py::class_<Geo2rdr> & pyGeo2Rdr)
         .def_property("numiter",
                 py::overload_cast<>(&Geo2rdr::numiter, py::const_),
                 py::overload_cast<int>(&Geo2rdr::numiter))
+        .def_property("approximation_tolerance",
+                py::overload_cast<>(&Geo2rdr::approximationTolerance, py::const_),
+                py::overload_cast<double>(&Geo2rdr::approximationTolerance))
+        .def_property("approximation_spacing",
+                py::overload_cast<>(&Geo2rdr::approximationSpacing, py::const_),
+                py::overload_cast<size_t>(&Geo2rdr::approximationSpacing))
+        .def_property_readonly("approximation_error",
+                &Geo2rdr::approximationError)
         ;
 }
@@ -1,6 +1,7 @@
 set(TESTFILES
 container/rsd.cpp
 core/attitude/euler.cpp
+core/blockpipeline/blockpipeline.cpp
 core/cube/cube.cpp
 core/datetime/datetime.cpp
 core/ellipsoid/ellipsoid.cpp
@@ -36,9 +37,12 @@ geometry/geometry/geometry_constlat.cpp
 geometry/geometry/geometry.cpp
 geometry/geometry/geometry_equator.cpp
 geometry/rtc/rtc.cpp
+geometry/rtc/rtcbench.cpp
 geometry/topo/topo.cpp
+geometry/topo/topobench.cpp
 geometry/bbox/geoperimeter_equator.cpp
 image/resampslc/resampslc.cpp
+image/sincresampler/sincresampler.cpp
 io/gdal/buffer.cpp
 io/gdal/gdal-dataset.cpp
 io/gdal/geotransform.cpp
@@ -53,6 +57,7 @@ io/raster/raster.cpp
 io/raster/rasterepsg.cpp
 io/raster/rastermatrix.cpp
 io/raster/rasterview.cpp
+io/raster/writequeue.cpp
 matchtemplate/ampcor/ampcor.cpp
 math/bessel/bessel53.cpp
 math/sinc.cpp
@@ -61,6 +66,7 @@ product/serialization/serializeProductMetadata.cpp
 product/radargrid/radargrid.cpp
 signal/covariance.cpp
 signal/crossmul.cpp
+signal/fftplancache.cpp
 signal/filter.cpp
 signal/multilook.cpp
 signal/nfft.cpp
@@ -0,0 +1,147 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <isce3/core/BlockPipeline.h>
+
+using isce3::core::BlockPipeline;
+
+struct BlockPipelineTest : public testing::TestWithParam<bool> {};
+
+TEST_P(BlockPipelineTest, StageOrder)
+{
+    const int nblocks = 17;
+
+    // per-block counter of completed stages
+    std::vector<std::atomic<int>> done(nblocks);
+    for (auto& d : done) {
+        d = 0;
+    }
+    std::atomic<int> errors {0};
+
+    auto stage = [&](int s) {
+        return [&, s](int block, int) {
+            if (done[block] != s) {
+                ++errors;
+            }
+            done[block] = s + 1;
+        };
+    };
+
+    BlockPipeline pipeline;
+    pipeline.io(stage(0))
+            .compute(stage(1))
+            .io(stage(2))
+            .compute(stage(3))
+            .io(stage(4));
+    pipeline.async(GetParam());
+
+    EXPECT_EQ(pipeline.numStages(), 5);
+    EXPECT_EQ(pipeline.numSlots(), 5);
+
+    pipeline.run(nblocks);
+
+    EXPECT_EQ(errors, 0);
+    for (int block = 0; block < nblocks; ++block) {
+        EXPECT_EQ(done[block], 5);
+    }
+}
+
+TEST_P(BlockPipelineTest, SlotsAreExclusive)
+{
+    const int nblocks = 23;
+
+    // block currently owning each slot (-1 if free)
+    std::vector<std::atomic<int>> owner(3);
+    for (auto& o : owner) {
+        o = -1;
+    }
+    std::atomic<int> errors {0};
+
+    BlockPipeline pipeline;
+    pipeline.io([&](int block, int slot) {
+                if (owner[slot] != -1) {
+                    ++errors;
+                }
+                owner[slot] = block;
+            })
+            .compute([&](int block, int slot) {
+                if (owner[slot] != block) {
+                    ++errors;
+                }
+            })
+            .io([&](int block, int slot) {
+                if (owner[slot] != block) {
+                    ++errors;
+                }
+                owner[slot] = -1;
+            });
+    pipeline.async(GetParam());
+    pipeline.run(nblocks);
+
+    EXPECT_EQ(errors, 0);
+}
+
+TEST_P(BlockPipelineTest, BlockOrder)
+{
+    const int nblocks = 11;
+    std::vector<int> reads, writes;
+
+    BlockPipeline pipeline;
+    pipeline.io([&](int block, int) { reads.push_back(block); })
+            .compute([](int, int) {})
+            .io([&](int block, int) { writes.push_back(block); });
+    pipeline.async(GetParam());
+    pipeline.run(nblocks);
+
+    ASSERT_EQ(reads.size(), nblocks);
+    ASSERT_EQ(writes.size(), nblocks);
+    for (int block = 0; block < nblocks; ++block) {
+        EXPECT_EQ(reads[block], block);
+        EXPECT_EQ(writes[block], block);
+    }
+}
+
+TEST_P(BlockPipelineTest, Exceptions)
+{
+    BlockPipeline io_error;
+    io_error.io([](int block, int) {
+                if (block == 3) {
+                    throw std::runtime_error("read error");
+                }
+            })
+            .compute([](int, int) {});
+    io_error.async(GetParam());
+    EXPECT_THROW(io_error.run(10), std::runtime_error);
+
+    BlockPipeline compute_error;
+    compute_error.io([](int, int) {})
+            .compute([](int block, int) {
+                if (block == 5) {
+                    throw std::runtime_error("compute error");
+                }
+            });
+    compute_error.async(GetParam());
+    EXPECT_THROW(compute_error.run(10), std::runtime_error);
+}
+
+TEST_P(BlockPipelineTest, Empty)
+{
+    int count = 0;
+    BlockPipeline pipeline;
+    pipeline.io([&](int, int) { ++count; });
+    pipeline.async(GetParam());
+    pipeline.run(0);
+    EXPECT_EQ(count, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(BlockPipeline, BlockPipelineTest,
+                         testing::Values(true, false));
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -456,6 +456,39 @@ TEST_F(InterpolatorTest, SimpleRampTest) {
 }
 
 
+// Batch interpolation should match point-by-point interpolation
+TEST_F(InterpolatorTest, Batch) {
+    // Interior test points, valid for all methods
+    std::vector<double> x, y;
+    for (size_t i = 0; i < true_values.length(); ++i) {
+        const double xi = (true_values(i,0) - start) / delta;
+        const double yi = (true_values(i,1) - start) / delta;
+        if ((xi < 4) || (yi < 4) || (xi > M.width() - 5) || (yi > M.length() - 5))
+            continue;
+        x.push_back(xi);
+        y.push_back(yi);
+    }
+    ASSERT_GT(x.size(), 0);
+
+    for (auto method : {isce3::core::NEAREST_METHOD,
+                        isce3::core::BILINEAR_METHOD,
+                        isce3::core::BICUBIC_METHOD,
+                        isce3::core::BIQUINTIC_METHOD,
+                        isce3::core::SINC_METHOD}) {
+        isce3::core::Interpolator<std::complex<double>> * interp =
+            isce3::core::createInterpolator<std::complex<double>>(method);
+
+        std::vector<std::complex<double>> z(x.size());
+        interp->interpolate(x.data(), y.data(), x.size(), M_cpx, z.data());
+        for (size_t i = 0; i < x.size(); ++i) {
+            const std::complex<double> zref = interp->interpolate(x[i], y[i], M_cpx);
+            ASSERT_DOUBLE_EQ(z[i].real(), zref.real());
+            ASSERT_DOUBLE_EQ(z[i].imag(), zref.imag());
+        }
+        delete interp;
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -9,6 +9,7 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include "isce3/core/Interpolator.h"
 #include "isce3/core/Matrix.h"
 #include "isce3/core/LUT2d.h"
 #include "isce3/core/Utilities.h"
@@ -60,6 +61,237 @@ TEST(LUT2dTest, Evaluation) {
     ASSERT_TRUE((error / N_pts) < 0.058);
 }
 
+// Batch evaluation should match point-by-point evaluation
+TEST(LUT2dTest, BatchEvaluation) {
+
+    // Create a LUT of z = sin(x**2 + y**2)
+    std::vector<double> xvec = isce3::core::arange(-5.01, 5.01, 0.25);
+    std::vector<double> yvec = isce3::core::arange(-5.01, 5.01, 0.25);
+    std::valarray<double> xindex(xvec.data(), xvec.size());
+    std::valarray<double> yindex(yvec.data(), yvec.size());
+    isce3::core::Matrix<double> M(yvec.size(), xvec.size());
+    for (size_t i = 0; i < yvec.size(); ++i) {
+        for (size_t j = 0; j < xvec.size(); ++j) {
+            M(i,j) = std::sin(yvec[i]*yvec[i] + xvec[j]*xvec[j]);
+        }
+    }
+
+    // A block of points spanning several evaluation chunks
+    const size_t nx = 37, ny = 29;
+    std::vector<double> x(nx * ny), y(nx * ny), z(nx * ny);
+    for (size_t i = 0; i < ny; ++i) {
+        for (size_t j = 0; j < nx; ++j) {
+            y[i * nx + j] = -4.0 + 8.0 * i / (ny - 1);
+            x[i * nx + j] = -4.0 + 8.0 * j / (nx - 1);
+        }
+    }
+
+    for (auto method : {isce3::core::NEAREST_METHOD,
+                        isce3::core::BILINEAR_METHOD,
+                        isce3::core::BICUBIC_METHOD,
+                        isce3::core::BIQUINTIC_METHOD}) {
+        isce3::core::LUT2d<double> lut(xindex, yindex, M, method);
+        lut.eval(y.data(), x.data(), x.size(), z.data());
+        for (size_t i = 0; i < x.size(); ++i) {
+            EXPECT_DOUBLE_EQ(z[i], lut.eval(y[i], x[i]));
+        }
+    }
+
+    // Without data, the reference value is returned
+    isce3::core::LUT2d<double> empty;
+    empty.eval(y.data(), x.data(), x.size(), z.data());
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_EQ(z[i], empty.refValue());
+    }
+}
+
+// Cached polynomials of cells should match the interpolators
+TEST(LUT2dTest, CellPolynomials) {
+
+    // Create a LUT of z = sin(x**2 + y**2)
+    const size_t nx = 31, ny = 23;
+    const double x0 = -2.0, y0 = -1.5, dx = 0.13, dy = 0.17;
+    isce3::core::Matrix<double> M(ny, nx);
+    for (size_t i = 0; i < ny; ++i) {
+        for (size_t j = 0; j < nx; ++j) {
+            const double x = x0 + j * dx, y = y0 + i * dy;
+            M(i,j) = std::sin(y*y + x*x);
+        }
+    }
+
+    for (auto method : {isce3::core::BILINEAR_METHOD,
+                        isce3::core::BICUBIC_METHOD,
+                        isce3::core::BIQUINTIC_METHOD}) {
+        isce3::core::LUT2d<double> lut(x0, y0, dx, dy, M, method);
+        auto interp = isce3::core::createInterpolator<double>(method, 6);
+
+        // Points away from the edges of the LUT, which differ between the
+        // interpolators (see BicubicEdges), and at nodes
+        for (double y_idx = 1.0; y_idx <= ny - 3.0; y_idx += 0.37) {
+            for (double x_idx = 1.0; x_idx <= nx - 3.0; x_idx += 0.29) {
+                const double z = lut.eval(y0 + y_idx * dy, x0 + x_idx * dx);
+                EXPECT_NEAR(z, interp->interpolate(x_idx, y_idx, M), 1.0e-12);
+            }
+        }
+        delete interp;
+    }
+}
+
+// At the edges of the LUT, the cell polynomials and the bicubic interpolator
+// (used by LUTs too large to cache them) both replicate the edge values
+TEST(LUT2dTest, BicubicEdges) {
+
+    const size_t nx = 31, ny = 23;
+    const double x0 = -2.0, y0 = -1.5, dx = 0.13, dy = 0.17;
+    isce3::core::Matrix<double> M(ny, nx);
+    for (size_t i = 0; i < ny; ++i) {
+        for (size_t j = 0; j < nx; ++j) {
+            const double x = x0 + j * dx, y = y0 + i * dy;
+            M(i,j) = std::sin(y*y + x*x);
+        }
+    }
+
+    isce3::core::LUT2d<double> lut(x0, y0, dx, dy, M,
+                                   isce3::core::BICUBIC_METHOD);
+    isce3::core::BicubicInterpolator<double> interp;
+    for (double y_idx = 0.0; y_idx <= ny - 1.0; y_idx += 0.37) {
+        for (double x_idx : {0.0, 0.21, 0.83, nx - 1.74, nx - 1.16, nx - 1.0}) {
+            EXPECT_NEAR(lut.eval(y0 + y_idx * dy, x0 + x_idx * dx),
+                        interp.interpolate(x_idx, y_idx, M), 1.0e-12);
+        }
+    }
+    for (double x_idx = 0.0; x_idx <= nx - 1.0; x_idx += 0.29) {
+        for (double y_idx : {0.0, 0.43, ny - 1.52, ny - 1.0}) {
+            EXPECT_NEAR(lut.eval(y0 + y_idx * dy, x0 + x_idx * dx),
+                        interp.interpolate(x_idx, y_idx, M), 1.0e-12);
+        }
+    }
+}
+
+// Copies share the cell polynomials, which must not be affected by a later
+// change of interpolation method of either LUT
+TEST(LUT2dTest, CopyCellPolynomials) {
+
+    const size_t nx = 31, ny = 23;
+    const double x0 = -2.0, y0 = -1.5, dx = 0.13, dy = 0.17;
+    isce3::core::Matrix<double> M(ny, nx);
+    for (size_t i = 0; i < ny; ++i) {
+        for (size_t j = 0; j < nx; ++j) {
+            const double x = x0 + j * dx, y = y0 + i * dy;
+            M(i,j) = std::sin(y*y + x*x);
+        }
+    }
+
+    isce3::core::LUT2d<double> lut(x0, y0, dx, dy, M,
+                                   isce3::core::BICUBIC_METHOD);
+    isce3::core::LUT2d<double> copy(lut);
+    isce3::core::LUT2d<double> assigned;
+    assigned = lut;
+    copy.interpMethod(isce3::core::BILINEAR_METHOD);
+
+    auto bicubic = isce3::core::createInterpolator<double>(
+            isce3::core::BICUBIC_METHOD);
+    auto bilinear = isce3::core::createInterpolator<double>(
+            isce3::core::BILINEAR_METHOD);
+    for (double y_idx = 1.0; y_idx <= ny - 3.0; y_idx += 0.37) {
+        for (double x_idx = 1.0; x_idx <= nx - 3.0; x_idx += 0.29) {
+            const double y = y0 + y_idx * dy, x = x0 + x_idx * dx;
+            const double z = bicubic->interpolate(x_idx, y_idx, M);
+            EXPECT_NEAR(lut.eval(y, x), z, 1.0e-12);
+            EXPECT_NEAR(assigned.eval(y, x), z, 1.0e-12);
+            EXPECT_NEAR(copy.eval(y, x),
+                        bilinear->interpolate(x_idx, y_idx, M), 1.0e-12);
+        }
+    }
+    delete bicubic;
+    delete bilinear;
+}
+
+// Derivative with respect to X should match a central difference
+TEST(LUT2dTest, Derivative) {
+
+    const size_t nx = 31, ny = 23;
+    const double x0 = -2.0, y0 = -1.5, dx = 0.13, dy = 0.17;
+    isce3::core::Matrix<double> M(ny, nx);
+    for (size_t i = 0; i < ny; ++i) {
+        for (size_t j = 0; j < nx; ++j) {
+            const double x = x0 + j * dx, y = y0 + i * dy;
+            M(i,j) = std::sin(y*y + x*x);
+        }
+    }
+
+    // Large enough LUT to be evaluated without cached polynomials
+    isce3::core::Matrix<double> big(300, 300);
+    big.fill(0.0);
+    for (size_t i = 0; i < ny; ++i) {
+        for (size_t j = 0; j < nx; ++j) {
+            big(i,j) = M(i,j);
+        }
+    }
+
+    const double h = 1.0e-6;
+    for (auto method : {isce3::core::BILINEAR_METHOD,
+                        isce3::core::BICUBIC_METHOD,
+                        isce3::core::BIQUINTIC_METHOD}) {
+        for (const auto & data : {M, big}) {
+            isce3::core::LUT2d<double> lut(x0, y0, dx, dy, data, method);
+            // away from the first cells, where the bicubic interpolator
+            // would access data outside of the LUT
+            for (double y = y0 + dy + 0.1; y < y0 + (ny - 1) * dy; y += 0.23) {
+                for (double x = x0 + dx + 0.05; x < x0 + (nx - 1) * dx; x += 0.11) {
+                    // skip points too close to cell edges
+                    const double u = (x - x0) / dx - std::floor((x - x0) / dx);
+                    if (u < 0.01 || u > 0.99) {
+                        continue;
+                    }
+                    const double ref = (lut.eval(y, x + h) - lut.eval(y, x - h))
+                                       / (2.0 * h);
+                    EXPECT_NEAR(lut.eval_dx(y, x), ref, 1.0e-4);
+                }
+            }
+
+            // Clamped outside of domain
+            EXPECT_EQ(lut.eval_dx(y0 + 1.0, x0 - 1.0), 0.0);
+        }
+    }
+
+    // Without data, the LUT is constant
+    isce3::core::LUT2d<double> empty;
+    EXPECT_EQ(empty.eval_dx(0.0, 0.0), 0.0);
+}
+
+// Evaluation along a line should match point-by-point evaluation
+TEST(LUT2dTest, RowEvaluation) {
+
+    const size_t nx = 31, ny = 23;
+    const double x0 = -2.0, y0 = -1.5, dx = 0.13, dy = 0.17;
+    isce3::core::Matrix<double> M(ny, nx);
+    for (size_t i = 0; i < ny; ++i) {
+        for (size_t j = 0; j < nx; ++j) {
+            const double x = x0 + j * dx, y = y0 + i * dy;
+            M(i,j) = std::sin(y*y + x*x);
+        }
+    }
+
+    std::vector<double> x(500), z(500);
+    for (size_t k = 0; k < x.size(); ++k) {
+        x[k] = x0 + (nx - 1) * dx * k / (x.size() - 1.0);
+    }
+
+    for (auto method : {isce3::core::NEAREST_METHOD,
+                        isce3::core::BILINEAR_METHOD,
+                        isce3::core::BICUBIC_METHOD,
+                        isce3::core::BIQUINTIC_METHOD}) {
+        isce3::core::LUT2d<double> lut(x0, y0, dx, dy, M, method);
+        for (double y : {y0, y0 + 0.77, y0 + (ny - 1) * dy}) {
+            lut.eval(y, x.data(), x.size(), z.data());
+            for (size_t k = 0; k < x.size(); ++k) {
+                EXPECT_NEAR(z[k], lut.eval(y, x[k]), 1.0e-12);
+            }
+        }
+    }
+}
+
 void loadInterpData(isce3::core::Matrix<double> & M) {
     /*
     Load ground truth interpolation data. The test data is the function:
@@ -6,6 +6,7 @@
 
 #include <isce3/error/ErrorCode.h>
 #include <isce3/core/DateTime.h>
+#include <isce3/core/EphemerisTable.h>
 #include <isce3/core/Orbit.h>
 #include <isce3/core/StateVector.h>
 #include <isce3/core/TimeDelta.h>
@@ -13,6 +14,7 @@
 #include <isce3/except/Error.h>
 
 using isce3::core::DateTime;
+using isce3::core::EphemerisTable;
 using isce3::core::Orbit;
 using isce3::core::OrbitInterpBorderMode;
 using isce3::core::OrbitInterpMethod;
@@ -543,6 +545,156 @@ TEST_F(CircularOrbitInterpTest, Legendre)
     }
 }
 
+struct EphemerisTableTest : public testing::Test {
+
+    std::vector<StateVector> statevecs;
+    std::vector<double> interp_times;
+
+    void SetUp() override
+    {
+        DateTime starttime(2000, 1, 1);
+        double spacing = 10.;
+        int size = 21;
+
+        // roughly the orbital period and radius of a LEO satellite
+        double theta0 = 2. * M_PI / 8.;
+        double phi0 = 2. * M_PI / 12.;
+        double dtheta = 2. * M_PI / 5900.;
+        double dphi = 2. * M_PI / 6100.;
+        double r = 7000000.;
+        CircularOrbit reforbit(theta0, phi0, dtheta, dphi, r);
+
+        statevecs.resize(size);
+        for (int i = 0; i < size; ++i) {
+            double t = i * spacing;
+            statevecs[i].datetime = starttime + TimeDelta(t);
+            statevecs[i].position = reforbit.position(t);
+            statevecs[i].velocity = reforbit.velocity(t);
+        }
+
+        // densely cover the orbit, including the state vector times and
+        // points just outside of the orbit domain
+        double tmax = (size - 1) * spacing;
+        for (double t = -2.; t <= tmax + 2.; t += 0.0371) {
+            interp_times.push_back(t);
+        }
+        for (int i = 0; i < size; ++i) {
+            interp_times.push_back(i * spacing);
+        }
+    }
+};
+
+TEST_F(EphemerisTableTest, Hermite)
+{
+    Orbit orbit(statevecs, OrbitInterpMethod::Hermite);
+    EphemerisTable table(orbit);
+
+    EXPECT_EQ( table.size(), orbit.size() );
+    EXPECT_DOUBLE_EQ( table.startTime(), orbit.startTime() );
+    EXPECT_DOUBLE_EQ( table.midTime(), orbit.midTime() );
+    EXPECT_DOUBLE_EQ( table.endTime(), orbit.endTime() );
+
+    auto border_mode = OrbitInterpBorderMode::Extrapolate;
+    for (auto t : interp_times) {
+        Vec3 pos, vel, ref_pos, ref_vel;
+        table.interpolate(&pos, &vel, t, border_mode);
+        orbit.interpolate(&ref_pos, &ref_vel, t, border_mode);
+        EXPECT_PRED3( compareVecs, pos, ref_pos, 1e-6 );
+        EXPECT_PRED3( compareVecs, vel, ref_vel, 1e-6 );
+    }
+}
+
+TEST_F(EphemerisTableTest, Legendre)
+{
+    Orbit orbit(statevecs, OrbitInterpMethod::Legendre);
+    EphemerisTable table(orbit);
+
+    auto border_mode = OrbitInterpBorderMode::Extrapolate;
+    for (auto t : interp_times) {
+        Vec3 pos, vel, ref_pos, ref_vel;
+        table.interpolate(&pos, &vel, t, border_mode);
+        orbit.interpolate(&ref_pos, &ref_vel, t, border_mode);
+        EXPECT_PRED3( compareVecs, pos, ref_pos, 1e-6 );
+        EXPECT_PRED3( compareVecs, vel, ref_vel, 1e-6 );
+    }
+}
+
+TEST_F(EphemerisTableTest, Acceleration)
+{
+    Orbit orbit(statevecs);
+    EphemerisTable table(orbit);
+
+    // compare to central difference of velocity
+    double dt = 1e-3;
+    for (double t = 1.; t < orbit.endTime() - 1.; t += 3.7) {
+        Vec3 acc, vel1, vel2;
+        table.interpolate(nullptr, nullptr, &acc, t);
+        table.interpolate(nullptr, &vel1, t - dt);
+        table.interpolate(nullptr, &vel2, t + dt);
+        EXPECT_PRED3( compareVecs, acc, (vel2 - vel1) / (2. * dt), 1e-5 );
+    }
+}
+
+TEST_F(EphemerisTableTest, Batch)
+{
+    Orbit orbit(statevecs, OrbitInterpMethod::Legendre);
+    EphemerisTable table(orbit);
+
+    auto n = interp_times.size();
+    std::vector<Vec3> pos(n), vel(n), acc(n);
+    auto border_mode = OrbitInterpBorderMode::Extrapolate;
+    auto status = table.interpolate(interp_times.data(), n, pos.data(),
+                                    vel.data(), acc.data(), border_mode);
+    EXPECT_EQ( status, isce3::error::ErrorCode::Success );
+
+    for (size_t i = 0; i < n; ++i) {
+        Vec3 ref_pos, ref_vel, ref_acc;
+        table.interpolate(&ref_pos, &ref_vel, &ref_acc, interp_times[i],
+                          border_mode);
+        EXPECT_EQ( pos[i], ref_pos );
+        EXPECT_EQ( vel[i], ref_vel );
+        EXPECT_EQ( acc[i], ref_acc );
+    }
+}
+
+TEST_F(EphemerisTableTest, OrbitInterpBorderMode)
+{
+    Orbit orbit(statevecs);
+    EphemerisTable table(orbit);
+
+    double t = table.endTime() + 1.;
+    Vec3 pos, vel;
+
+    // throw exception on attempt to interpolate outside orbit domain
+    EXPECT_THROW( table.interpolate(&pos, &vel, t), isce3::except::OutOfRange );
+
+    std::vector<double> times = { table.midTime(), t };
+    std::vector<Vec3> positions(2);
+    EXPECT_THROW( table.interpolate(times.data(), 2, positions.data(), nullptr),
+                  isce3::except::OutOfRange );
+
+    // output NaN on attempt to interpolate outside orbit domain
+    auto border_mode = OrbitInterpBorderMode::FillNaN;
+    auto status = table.interpolate(&pos, &vel, t, border_mode);
+    EXPECT_EQ( status, isce3::error::ErrorCode::OrbitInterpDomainError );
+    EXPECT_TRUE( std::isnan(pos[0]) && std::isnan(pos[1]) && std::isnan(pos[2]) );
+    EXPECT_TRUE( std::isnan(vel[0]) && std::isnan(vel[1]) && std::isnan(vel[2]) );
+
+    status = table.interpolate(times.data(), 2, positions.data(), nullptr,
+                               nullptr, border_mode);
+    EXPECT_EQ( status, isce3::error::ErrorCode::OrbitInterpDomainError );
+    EXPECT_FALSE( std::isnan(positions[0][0]) );
+    EXPECT_TRUE( std::isnan(positions[1][0]) );
+
+    // too few state vectors to form the interpolant
+    Orbit short_orbit(std::vector<StateVector>(statevecs.begin(),
+                                               statevecs.begin() + 3));
+    EphemerisTable short_table(short_orbit);
+    status = short_table.interpolate(&pos, &vel, short_table.startTime(),
+                                     OrbitInterpBorderMode::FillNaN);
+    EXPECT_EQ( status, isce3::error::ErrorCode::OrbitInterpSizeError );
+}
+
 int main(int argc, char * argv[])
 {
     testing::InitGoogleTest(&argc, argv);
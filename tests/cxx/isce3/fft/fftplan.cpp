@@ -1,9 +1,13 @@
 #include <complex>
+#include <cstdio>
 #include <gtest/gtest.h>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include <isce3/except/Error.h>
 #include <isce3/fft/FFTPlan.h>
+#include <isce3/fft/PlanCache.h>
 
 #include "FFTTestHelper.h"
 
@@ -37,6 +41,77 @@ TEST(FFTPlanTest, InvalidPlanConfig)
     EXPECT_THROW( { FwdFFTPlan<double> plan(out.data(), in.data(), -n); }, isce3::except::RuntimeError );
 }
 
+TEST(FFTPlanTest, PlanCache)
+{
+    int n = 15;
+    std::vector<std::complex<double>> in1(n), out1(n), in2(n), out2(n), expected(n);
+
+    isce3::fft::clearPlanCache();
+    ASSERT_EQ( isce3::fft::planCacheSize(), 0u );
+
+    // plans with the same layout share the cached plan
+    FwdFFTPlan<double> plan1(out1.data(), in1.data(), n);
+    std::size_t size = isce3::fft::planCacheSize();
+    ASSERT_GT( size, 0u );
+
+    FwdFFTPlan<double> plan2(out2.data(), in2.data(), n);
+    EXPECT_EQ( isce3::fft::planCacheSize(), size );
+
+    // each plan transforms its own arrays
+    ComplexUniformDistribution<double> U(0., 1.);
+    for (int i = 0; i < n; ++i) { in2[i] = U.sample(); }
+
+    fwd_dft_c2c_1d(expected.data(), in2.data(), n);
+    plan2.execute();
+    EXPECT_PRED3( compareVectors<std::complex<double>>, out2, expected, 1e-8 );
+
+    // cleared cache does not invalidate existing plans
+    isce3::fft::clearPlanCache();
+    EXPECT_EQ( isce3::fft::planCacheSize(), 0u );
+    plan2.execute();
+    EXPECT_PRED3( compareVectors<std::complex<double>>, out2, expected, 1e-8 );
+}
+
+TEST(FFTPlanTest, ConcurrentRelease)
+{
+    // plans released by their last holder after the cache is cleared are
+    // destroyed while other threads are planning
+    auto worker = [](int n) {
+        std::vector<std::complex<float>> in(n), out(n);
+        for (int iter = 0; iter < 50; ++iter) {
+            FwdFFTPlan<float> plan(out.data(), in.data(), n + iter % 7);
+            isce3::fft::clearPlanCache();
+            EXPECT_TRUE( plan );
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back(worker, 16 + t);
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ( isce3::fft::planCacheSize(), 0u );
+}
+
+TEST(FFTPlanTest, Wisdom)
+{
+    int n = 16;
+    std::vector<std::complex<float>> inf(n), outf(n);
+    std::vector<std::complex<double>> in(n), out(n);
+    FwdFFTPlan<float> planf(outf.data(), inf.data(), n);
+    FwdFFTPlan<double> plan(out.data(), in.data(), n);
+
+    std::string filename = "fftplan-wisdom";
+    EXPECT_TRUE( isce3::fft::exportWisdom(filename) );
+    EXPECT_TRUE( isce3::fft::importWisdom(filename) );
+
+    std::remove(filename.c_str());
+    std::remove((filename + "f").c_str());
+    EXPECT_FALSE( isce3::fft::importWisdom(filename) );
+}
+
 struct FFTPlanTest : public testing::TestWithParam<int> {};
 
 TEST_P(FFTPlanTest, FFT1D)
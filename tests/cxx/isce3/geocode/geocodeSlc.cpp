@@ -11,6 +11,8 @@
 #include <isce3/core/LUT2d.h>
 #include <isce3/core/Metadata.h>
 #include <isce3/core/Orbit.h>
+#include <isce3/except/Error.h>
+#include <isce3/geocode/Geo2rdrCache.h>
 #include <isce3/geocode/geocodeSlc.h>
 #include <isce3/geometry/Serialization.h>
 #include <isce3/geometry/Topo.h>
@@ -191,6 +193,122 @@ TEST(GeocodeTest, CheckGeocode)
     ASSERT_LT(maxErrY, 1.0e-5);
 }
 
+TEST(GeocodeTest, Geo2rdrCache)
+{
+    // Geocoding with precomputed radar coordinates, saved to and loaded back
+    // from a file, should reproduce the direct geocoding.
+
+    std::string h5file(TESTDATA_DIR "envisat.h5");
+    isce3::io::IH5File file(h5file);
+    isce3::product::Product product(file);
+
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::Ellipsoid ellipsoid;
+    isce3::core::LUT2d<double> imageGridDoppler =
+            product.metadata().procInfo().dopplerCentroid('A');
+
+    isce3::core::Matrix<double> M(imageGridDoppler.width(),
+                                 imageGridDoppler.length());
+    M.zeros();
+    isce3::core::LUT2d<double> nativeDoppler(
+            imageGridDoppler.xStart(), imageGridDoppler.yStart(),
+            imageGridDoppler.xSpacing(), imageGridDoppler.ySpacing(), M);
+
+    isce3::product::RadarGridParameters radarGrid(product, 'A');
+
+    isce3::product::GeoGridParameters geoGrid(-115.65, 34.84, 0.0002, -8.0e-5,
+                                             500, 500, 4326);
+
+    isce3::io::Raster demRaster("zeroHeightDEM.geo");
+
+    isce3::geocode::Geo2rdrCache cache(
+            geoGrid, demRaster, orbit, imageGridDoppler, ellipsoid,
+            radarGrid.wavelength(), radarGrid.lookSide(), 1.0e-9, 25);
+
+    ASSERT_EQ(cache.key(),
+              isce3::geocode::Geo2rdrCache::key(
+                      geoGrid, demRaster, orbit, imageGridDoppler, ellipsoid,
+                      radarGrid.wavelength(), radarGrid.lookSide(), 1.0e-9,
+                      25));
+
+    cache.save("geo2rdr.cache");
+    isce3::geocode::Geo2rdrCache loaded =
+            isce3::geocode::Geo2rdrCache::load("geo2rdr.cache");
+
+    ASSERT_EQ(loaded.key(), cache.key());
+    ASSERT_EQ(loaded.geometryKey(), cache.geometryKey());
+    ASSERT_EQ(loaded.pixelOffset(), 0.0);
+    ASSERT_NO_THROW(loaded.checkGeoGrid(geoGrid));
+    ASSERT_NO_THROW(loaded.checkGeometry(orbit, imageGridDoppler, ellipsoid,
+                                         radarGrid.wavelength(),
+                                         radarGrid.lookSide()));
+    for (int line = 0; line < geoGrid.length(); line += 7) {
+        for (int pixel = 0; pixel < geoGrid.width(); pixel += 7) {
+            const double aztime = cache.azimuthTime(line, pixel);
+            if (std::isnan(aztime)) {
+                ASSERT_TRUE(std::isnan(loaded.azimuthTime(line, pixel)));
+                continue;
+            }
+            ASSERT_EQ(loaded.azimuthTime(line, pixel), aztime);
+            ASSERT_EQ(loaded.slantRange(line, pixel),
+                      cache.slantRange(line, pixel));
+        }
+    }
+
+    isce3::io::Raster inputSlc("x.slc", GA_ReadOnly);
+    isce3::io::Raster geocodedSlc("xslc_cache.geo", geoGrid.width(),
+                                 geoGrid.length(), 1, GDT_CFloat32, "ENVI");
+    isce3::geocode::geocodeSlc(geocodedSlc, inputSlc, loaded, radarGrid, orbit,
+                              nativeDoppler, imageGridDoppler, ellipsoid, 1000,
+                              false);
+
+    isce3::io::Raster xRaster("xslc.geo");
+    const size_t length = xRaster.length();
+    const size_t width = xRaster.width();
+    std::valarray<std::complex<float>> expected(length * width);
+    std::valarray<std::complex<float>> actual(length * width);
+    xRaster.getBlock(expected, 0, 0, width, length);
+    geocodedSlc.getBlock(actual, 0, 0, width, length);
+
+    double maxErr = 0.0;
+    for (size_t i = 0; i < length * width; ++i) {
+        maxErr = std::max(maxErr,
+                          (double) std::abs(std::arg(actual[i]) -
+                                            std::arg(expected[i])));
+    }
+    ASSERT_LT(maxErr, 1.0e-6);
+
+    // a cache cannot be used for a different grid
+    isce3::product::GeoGridParameters otherGrid(
+            -115.65, 34.84, 0.0002, -8.0e-5, 400, 500, 4326);
+    ASSERT_THROW(loaded.checkGeoGrid(otherGrid),
+                 isce3::except::InvalidArgument);
+
+    // nor for the same grid sampled at pixel centers
+    ASSERT_THROW(loaded.checkGeoGrid(geoGrid, 0.5),
+                 isce3::except::InvalidArgument);
+
+    // nor for another frequency band, Doppler or orbit
+    ASSERT_THROW(loaded.checkGeometry(orbit, imageGridDoppler, ellipsoid,
+                                      2.0 * radarGrid.wavelength(),
+                                      radarGrid.lookSide()),
+                 isce3::except::InvalidArgument);
+    ASSERT_THROW(loaded.checkGeometry(orbit, nativeDoppler, ellipsoid,
+                                      radarGrid.wavelength(),
+                                      radarGrid.lookSide()),
+                 isce3::except::InvalidArgument);
+    isce3::core::Orbit otherOrbit = orbit;
+    otherOrbit.interpMethod(
+            orbit.interpMethod() == isce3::core::OrbitInterpMethod::Hermite
+                    ? isce3::core::OrbitInterpMethod::Legendre
+                    : isce3::core::OrbitInterpMethod::Hermite);
+    ASSERT_THROW(isce3::geocode::geocodeSlc(
+                         geocodedSlc, inputSlc, loaded, radarGrid, otherOrbit,
+                         nativeDoppler, imageGridDoppler, ellipsoid, 1000,
+                         false),
+                 isce3::except::InvalidArgument);
+}
+
 int main(int argc, char* argv[])
 {
     testing::InitGoogleTest(&argc, argv);
@@ -5,11 +5,14 @@
 // Copyright 2018
 //
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <complex>
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <valarray>
 #include <gtest/gtest.h>
 
 // isce3::core
@@ -79,6 +82,158 @@ TEST(Geo2rdrTest, CheckResults) {
     EXPECT_LT(az_error, 1e-9);
 }
 
+TEST(Geo2rdrTest, RunApproximateGeo2rdr) {
+
+    // Open the HDF5 product
+    std::string h5file(TESTDATA_DIR "envisat.h5");
+    isce3::io::IH5File file(h5file);
+
+    // Load the product
+    isce3::product::Product product(file);
+
+    // Create geo2rdr instance
+    isce3::geometry::Geo2rdr geo(product, 'A', true);
+
+    // Load topo processing parameters to finish configuration
+    std::ifstream xmlfid(TESTDATA_DIR "topo.xml", std::ios::in);
+    {
+    cereal::XMLInputArchive archive(xmlfid);
+    archive(cereal::make_nvp("Geo2rdr", geo));
+    }
+
+    // Interpolate between sparse solutions
+    const double tol = 1.0e-3;
+    geo.approximationTolerance(tol);
+    geo.approximationSpacing(16);
+
+    // Run geo2rdr
+    isce3::io::Raster topoRaster("../topo/topo.vrt");
+    isce3::io::Raster rgoffRaster("range_approx.off", topoRaster.width(),
+        topoRaster.length(), 1, GDT_Float32, "ISCE");
+    isce3::io::Raster azoffRaster("azimuth_approx.off", topoRaster.width(),
+        topoRaster.length(), 1, GDT_Float32, "ISCE");
+    geo.geo2rdr(topoRaster, rgoffRaster, azoffRaster);
+
+    // The interpolation errors are within the tolerance
+    EXPECT_LE(geo.approximationError(), tol);
+}
+
+// Approximate results should match exact ones within the tolerance
+TEST(Geo2rdrTest, CheckApproximateResults) {
+    isce3::io::Raster rgoffRaster("range.off");
+    isce3::io::Raster azoffRaster("azimuth.off");
+    isce3::io::Raster rgoffApproxRaster("range_approx.off");
+    isce3::io::Raster azoffApproxRaster("azimuth_approx.off");
+    double max_error = 0.0;
+    for (size_t i = 0; i < rgoffRaster.length(); ++i) {
+        for (size_t j = 0; j < rgoffRaster.width(); ++j) {
+            double rgoff, azoff, rgoffApprox, azoffApprox;
+            rgoffRaster.getValue(rgoff, j, i);
+            azoffRaster.getValue(azoff, j, i);
+            rgoffApproxRaster.getValue(rgoffApprox, j, i);
+            azoffApproxRaster.getValue(azoffApprox, j, i);
+            // Skip null values (pixels on the edges of the radar grid may
+            // fall either side of it)
+            if (std::abs(rgoff) > 999.0 || std::abs(azoff) > 999.0 ||
+                std::abs(rgoffApprox) > 999.0 || std::abs(azoffApprox) > 999.0)
+                continue;
+            max_error = std::max({max_error, std::abs(rgoff - rgoffApprox),
+                                  std::abs(azoff - azoffApprox)});
+        }
+    }
+    EXPECT_LE(max_error, 1.0e-3);
+}
+
+// Run geo2rdr of the steep topo, exactly when tol is zero, returning the
+// largest interpolation error
+double runSteepGeo2rdr(double tol, const std::string & suffix) {
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::Product product(file);
+    isce3::geometry::Geo2rdr geo(product, 'A', true);
+    std::ifstream xmlfid(TESTDATA_DIR "topo.xml", std::ios::in);
+    {
+    cereal::XMLInputArchive archive(xmlfid);
+    archive(cereal::make_nvp("Geo2rdr", geo));
+    }
+    geo.approximationTolerance(tol);
+    geo.approximationSpacing(16);
+
+    isce3::io::Raster topoRaster("topo_steep.rdr");
+    isce3::io::Raster rgoffRaster("range_steep" + suffix + ".off",
+        topoRaster.width(), topoRaster.length(), 1, GDT_Float32, "ISCE");
+    isce3::io::Raster azoffRaster("azimuth_steep" + suffix + ".off",
+        topoRaster.width(), topoRaster.length(), 1, GDT_Float32, "ISCE");
+    geo.geo2rdr(topoRaster, rgoffRaster, azoffRaster);
+    return geo.approximationError();
+}
+
+// Exact and approximate geo2rdr of the reference topo with steep, aliased
+// terrain added to its heights
+TEST(Geo2rdrTest, RunSteepTerrain) {
+
+    // Add a few km of relief varying over a few pixels
+    isce3::io::Raster refRaster(TESTDATA_DIR "topo/topo.vrt");
+    const size_t width = refRaster.width();
+    const size_t length = refRaster.length();
+    {
+    isce3::io::Raster topoRaster("topo_steep.rdr", width, length, 3,
+        GDT_Float64, "ENVI");
+    topoRaster.setEPSG(refRaster.getEPSG());
+    std::valarray<double> data(width * length);
+    for (size_t band = 1; band <= 2; ++band) {
+        refRaster.getBlock(data, 0, 0, width, length, band);
+        topoRaster.setBlock(data, 0, 0, width, length, band);
+    }
+    refRaster.getBlock(data, 0, 0, width, length, 3);
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < width; ++j) {
+            data[i * width + j] += 2000.0 * std::sin(0.37 * j) *
+                                   std::cos(0.23 * i + 0.05 * j);
+        }
+    }
+    topoRaster.setBlock(data, 0, 0, width, length, 3);
+    }
+
+    runSteepGeo2rdr(0.0, "");
+}
+
+// Every approximate pixel should be within the tolerance of the exact one
+TEST(Geo2rdrTest, CheckSteepTerrainApproximate) {
+    const double tol = 1.0e-3;
+    EXPECT_LE(runSteepGeo2rdr(tol, "_approx"), tol);
+
+    isce3::io::Raster rgoffRaster("range_steep.off");
+    isce3::io::Raster azoffRaster("azimuth_steep.off");
+    isce3::io::Raster rgoffApproxRaster("range_steep_approx.off");
+    isce3::io::Raster azoffApproxRaster("azimuth_steep_approx.off");
+    const size_t width = rgoffRaster.width();
+    const size_t length = rgoffRaster.length();
+    std::valarray<float> rgoff(width * length), azoff(width * length),
+        rgoffApprox(width * length), azoffApprox(width * length);
+    rgoffRaster.getBlock(rgoff, 0, 0, width, length);
+    azoffRaster.getBlock(azoff, 0, 0, width, length);
+    rgoffApproxRaster.getBlock(rgoffApprox, 0, 0, width, length);
+    azoffApproxRaster.getBlock(azoffApprox, 0, 0, width, length);
+
+    double max_error = 0.0;
+    size_t count = 0;
+    for (size_t k = 0; k < width * length; ++k) {
+        // Skip null values (pixels on the edges of the radar grid may
+        // fall either side of it)
+        if (std::abs(rgoff[k]) > 999.0 || std::abs(azoff[k]) > 999.0 ||
+            std::abs(rgoffApprox[k]) > 999.0 ||
+            std::abs(azoffApprox[k]) > 999.0)
+            continue;
+        max_error = std::max({max_error,
+                              std::abs(double(rgoff[k]) - rgoffApprox[k]),
+                              std::abs(double(azoff[k]) - azoffApprox[k])});
+        ++count;
+    }
+    EXPECT_GT(count, width * length / 2);
+    // allow for the rounding of the offsets to float
+    EXPECT_LE(max_error, tol + 1.0e-5);
+}
+
 int main(int argc, char * argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
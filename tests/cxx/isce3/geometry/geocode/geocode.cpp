@@ -4,14 +4,21 @@
 // Author: Heresh Fattahi
 // Copyright 2019-
 //
+#include <algorithm>
 #include <iostream>
 #include <cstdio>
 #include <sstream>
 #include <fstream>
 #include <cmath>
 #include <complex>
+#include <limits>
+#include <valarray>
 #include <gtest/gtest.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "isce3/io/Raster.h"
 #include <isce3/io/IH5.h>
 #include <isce3/product/Serialization.h>
@@ -24,6 +31,9 @@
 #include <isce3/core/Projections.h>
 #include <isce3/core/Interpolator.h>
 #include <isce3/core/Constants.h>
+#include <isce3/except/Error.h>
+#include <isce3/geocode/Geo2rdrCache.h>
+#include <isce3/product/GeoGridParameters.h>
 
 // isce3::geometry
 #include "isce3/geometry/Serialization.h"
@@ -240,6 +250,200 @@ TEST(GeocodeTest, CheckGeocode) {
     }
 }
 
+TEST(GeocodeTest, Geo2rdrCache) {
+    // Interpolation geocoding with precomputed radar coordinates of the
+    // geogrid pixel centers should reproduce geocoding with the DEM
+
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::Product product(file);
+
+    const isce3::product::Swath & swath = product.swath('A');
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::Ellipsoid ellipsoid;
+    isce3::core::LUT2d<double> doppler =
+            product.metadata().procInfo().dopplerCentroid('A');
+    isce3::product::RadarGridParameters radar_grid(swath, product.lookSide());
+
+    const double threshold = 1.0e-9;
+    const int numiter = 25;
+    const int reduction_factor = 10;
+    isce3::product::GeoGridParameters geoGrid(
+            -115.6, 34.832, reduction_factor * 0.0002,
+            reduction_factor * -8.0e-5, 400 / reduction_factor,
+            380 / reduction_factor, 4326);
+
+    isce3::geometry::Geocode<double> geoObj;
+    geoObj.orbit(orbit);
+    geoObj.doppler(doppler);
+    geoObj.ellipsoid(ellipsoid);
+    geoObj.thresholdGeo2rdr(threshold);
+    geoObj.numiterGeo2rdr(numiter);
+    geoObj.linesPerBlock(1000);
+    geoObj.demBlockMargin(0.1);
+    geoObj.radarBlockMargin(10);
+    geoObj.interpolator(isce3::core::BIQUINTIC_METHOD);
+    geoObj.geoGrid(geoGrid.startX(), geoGrid.startY(), geoGrid.spacingX(),
+                   geoGrid.spacingY(), geoGrid.width(), geoGrid.length(),
+                   geoGrid.epsg());
+
+    isce3::io::Raster demRaster("zeroHeightDEM.geo");
+    isce3::io::Raster radarRasterX("x.rdr");
+
+    // geocode with the DEM
+    isce3::io::Raster demGeocoded("x.dem.geo", geoGrid.width(),
+                                  geoGrid.length(), 1, GDT_Float64, "ENVI");
+    geoObj.geocode(radar_grid, radarRasterX, demGeocoded, demRaster,
+                   isce3::geometry::geocodeOutputMode::INTERP);
+
+    // a cache sampled at the start of each pixel is rejected
+    geoObj.geo2rdrCache(std::make_shared<isce3::geocode::Geo2rdrCache>(
+            geoGrid, demRaster, orbit, doppler, ellipsoid,
+            radar_grid.wavelength(), radar_grid.lookSide(), threshold,
+            numiter));
+    isce3::io::Raster rejected("x.rejected.geo", geoGrid.width(),
+                               geoGrid.length(), 1, GDT_Float64, "ENVI");
+    ASSERT_THROW(geoObj.geocode(radar_grid, radarRasterX, rejected, demRaster,
+                                isce3::geometry::geocodeOutputMode::INTERP),
+                 isce3::except::InvalidArgument);
+
+    // and so is a cache computed for another wavelength
+    geoObj.geo2rdrCache(std::make_shared<isce3::geocode::Geo2rdrCache>(
+            geoGrid, demRaster, orbit, doppler, ellipsoid,
+            2.0 * radar_grid.wavelength(), radar_grid.lookSide(), threshold,
+            numiter, 1000, 0.1, 0.5));
+    ASSERT_THROW(geoObj.geocode(radar_grid, radarRasterX, rejected, demRaster,
+                                isce3::geometry::geocodeOutputMode::INTERP),
+                 isce3::except::InvalidArgument);
+
+    // geocode with a cache of the pixel centers
+    geoObj.geo2rdrCache(std::make_shared<isce3::geocode::Geo2rdrCache>(
+            geoGrid, demRaster, orbit, doppler, ellipsoid,
+            radar_grid.wavelength(), radar_grid.lookSide(), threshold,
+            numiter, 1000, 0.1, 0.5));
+    isce3::io::Raster cacheGeocoded("x.cache.geo", geoGrid.width(),
+                                    geoGrid.length(), 1, GDT_Float64, "ENVI");
+    geoObj.geocode(radar_grid, radarRasterX, cacheGeocoded, demRaster,
+                   isce3::geometry::geocodeOutputMode::INTERP);
+    geoObj.geo2rdrCache(nullptr);
+
+    const size_t size = static_cast<size_t>(geoGrid.width()) * geoGrid.length();
+    std::valarray<double> expected(size);
+    std::valarray<double> actual(size);
+    demGeocoded.getBlock(expected, 0, 0, geoGrid.width(), geoGrid.length());
+    cacheGeocoded.getBlock(actual, 0, 0, geoGrid.width(), geoGrid.length());
+
+    size_t nvalid = 0;
+    for (size_t i = 0; i < size; ++i) {
+        if (std::isnan(expected[i])) {
+            EXPECT_TRUE(std::isnan(actual[i]));
+            continue;
+        }
+        // within the threshold of geo2rdr, far below the grid spacing
+        EXPECT_NEAR(actual[i], expected[i], 1.0e-8);
+        ++nvalid;
+    }
+    ASSERT_GT(nvalid, 0);
+}
+
+TEST(GeocodeTest, DeterministicAreaProj) {
+    // In deterministic mode, area-projection geocoding (including the RTC
+    // area factor, accumulated in per-block tiles) must give bitwise
+    // identical results for any number of threads
+
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::Product product(file);
+
+    const isce3::product::Swath & swath = product.swath('A');
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::Ellipsoid ellipsoid;
+    isce3::core::LUT2d<double> doppler =
+            product.metadata().procInfo().dopplerCentroid('A');
+    isce3::product::RadarGridParameters radar_grid(swath, product.lookSide());
+
+    isce3::geometry::Geocode<double> geoObj;
+    geoObj.orbit(orbit);
+    geoObj.doppler(doppler);
+    geoObj.ellipsoid(ellipsoid);
+    geoObj.thresholdGeo2rdr(1.0e-9);
+    geoObj.numiterGeo2rdr(25);
+    geoObj.linesPerBlock(1000);
+    geoObj.demBlockMargin(0.1);
+    geoObj.radarBlockMargin(10);
+    geoObj.deterministic(true);
+
+    // fine enough grid to be split into several blocks
+    const int reduction_factor = 2;
+    const int geoGridLength = 380 / reduction_factor;
+    const int geoGridWidth = 400 / reduction_factor;
+    geoObj.geoGrid(-115.6, 34.832, reduction_factor * 0.0002,
+                   reduction_factor * -8.0e-5, geoGridWidth, geoGridLength,
+                   4326);
+
+    isce3::io::Raster demRaster("zeroHeightDEM.geo");
+    isce3::io::Raster radarRasterX("x.rdr");
+
+#ifdef _OPENMP
+    const int maxThreads = omp_get_max_threads();
+#else
+    const int maxThreads = 1;
+#endif
+
+    // Compare the outputs (NaN-aware) of a run with those of the first run
+    auto compare = [](const std::valarray<double> & reference,
+                      const std::valarray<double> & values) {
+        ASSERT_EQ(values.size(), reference.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (std::isnan(reference[i]))
+                EXPECT_TRUE(std::isnan(values[i]));
+            else
+                EXPECT_EQ(values[i], reference[i]);
+        }
+    };
+
+    std::valarray<double> referenceGeo, referenceRtc;
+    for (int nthreads : {1, std::max(2, maxThreads)}) {
+#ifdef _OPENMP
+        omp_set_num_threads(nthreads);
+#endif
+        isce3::io::Raster geocodedRaster("x.deterministic.geo", geoGridWidth,
+                                         geoGridLength, 1, GDT_Float64, "ENVI");
+        isce3::io::Raster rtcRaster("rtc.deterministic.rdr", radar_grid.width(),
+                                    radar_grid.length(), 1, GDT_Float32,
+                                    "ENVI");
+        geoObj.geocode(radar_grid, radarRasterX, geocodedRaster, demRaster,
+                isce3::geometry::geocodeOutputMode::
+                        AREA_PROJECTION_GAMMA_NAUGHT,
+                1, isce3::geometry::rtcInputRadiometry::BETA_NAUGHT, 0,
+                std::numeric_limits<float>::quiet_NaN(),
+                std::numeric_limits<double>::quiet_NaN(),
+                isce3::geometry::rtcAlgorithm::RTC_AREA_PROJECTION, 1,
+                std::numeric_limits<float>::quiet_NaN(),
+                std::numeric_limits<float>::quiet_NaN(),
+                std::numeric_limits<float>::quiet_NaN(), 1, nullptr, nullptr,
+                nullptr, nullptr, nullptr, &rtcRaster);
+
+        std::valarray<double> geoX(geoGridLength * geoGridWidth);
+        geocodedRaster.getBlock(geoX, 0, 0, geoGridWidth, geoGridLength);
+        std::valarray<double> rtc(radar_grid.length() * radar_grid.width());
+        rtcRaster.getBlock(rtc, 0, 0, radar_grid.width(), radar_grid.length());
+
+        if (referenceGeo.size() == 0) {
+            // the RTC must have been computed
+            ASSERT_GT(std::count_if(std::begin(rtc), std::end(rtc),
+                                    [](double v) { return v > 0; }), 0);
+            referenceGeo = geoX;
+            referenceRtc = rtc;
+            continue;
+        }
+        compare(referenceGeo, geoX);
+        compare(referenceRtc, rtc);
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads(maxThreads);
+#endif
+}
+
 int main(int argc, char * argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -10,16 +10,19 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <gtest/gtest.h>
 
 // isce3::io
 #include <isce3/io/IH5.h>
 
 // isce3::core
+#include <isce3/core/Basis.h>
 #include <isce3/core/Constants.h>
 #include <isce3/core/DateTime.h>
 #include <isce3/core/Ellipsoid.h>
 #include <isce3/core/Orbit.h>
+#include <isce3/core/Pixel.h>
 #include <isce3/core/Serialization.h>
 #include <isce3/core/TimeDelta.h>
 
@@ -155,6 +158,53 @@ TEST_F(GeometryTest, GeoToRdr) {
     ASSERT_NEAR(slantRange, 830449.6727720434, 1.0e-6);
 }
 
+TEST_F(GeometryTest, BatchMatchesScalar) {
+
+    // Range bins of an azimuth line (not a multiple of the batch size)
+    const size_t n = 37;
+    const double tmid = doppler.yStart() + 0.5 * (doppler.length() - 1)
+                      * doppler.ySpacing();
+    const double rmid = doppler.xStart() + 0.5 * (doppler.width() - 1)
+                      * doppler.xSpacing();
+    const double wvl = swath.processedWavelength();
+
+    isce3::core::Vec3 pos, vel;
+    orbit.interpolate(&pos, &vel, tmid);
+    const isce3::core::Basis TCNbasis(pos, vel);
+
+    std::vector<double> ranges(n), dopfacts(n);
+    for (size_t j = 0; j < n; ++j) {
+        ranges[j] = rmid + 150.0 * (j - 0.5 * n);
+        dopfacts[j] = 0.5 * wvl * doppler.eval(tmid, ranges[j]) * ranges[j]
+                    / vel.norm();
+    }
+
+    // Constant DEM
+    const double h0 = 1000.0;
+    isce3::geometry::DEMInterpolator dem(h0);
+
+    // Batch rdr2geo
+    std::vector<double> lon(n), lat(n), hgt(n, h0);
+    std::vector<unsigned char> conv(n);
+    const size_t nconv = isce3::geometry::rdr2geoBatch(ranges.data(),
+        dopfacts.data(), n, TCNbasis, pos, vel, ellipsoid, dem, lon.data(),
+        lat.data(), hgt.data(), lookSide, 1.0e-8, 25, 15, conv.data());
+    ASSERT_EQ(nconv, n);
+
+    // Compare with scalar rdr2geo
+    for (size_t j = 0; j < n; ++j) {
+        isce3::core::Vec3 llh = {0.0, 0.0, h0};
+        const isce3::core::Pixel pixel(ranges[j], dopfacts[j], j);
+        const int stat = isce3::geometry::rdr2geo(pixel, TCNbasis, pos, vel,
+            ellipsoid, dem, llh, lookSide, 1.0e-8, 25, 15);
+        ASSERT_EQ(stat, conv[j]);
+        const isce3::core::Vec3 xyz = ellipsoid.lonLatToXyz(llh);
+        const isce3::core::Vec3 xyz_batch =
+            ellipsoid.lonLatToXyz({lon[j], lat[j], hgt[j]});
+        ASSERT_LT((xyz - xyz_batch).norm(), 1.0e-8);
+    }
+}
+
 
 int main(int argc, char * argv[]) {
     testing::InitGoogleTest(&argc, argv);
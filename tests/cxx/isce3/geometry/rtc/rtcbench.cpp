@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <valarray>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <isce3/core/Constants.h>
+#include <isce3/core/Orbit.h>
+#include <isce3/geometry/RTC.h>
+#include <isce3/io/IH5.h>
+#include <isce3/io/Raster.h>
+#include <isce3/product/Product.h>
+#include <isce3/product/RadarGridParameters.h>
+
+using isce3::geometry::rtcAccumulationMode;
+
+struct RTCBench : public ::testing::Test {
+    isce3::core::Orbit orbit;
+    isce3::core::LUT2d<double> dop;
+    isce3::product::RadarGridParameters radar_grid;
+
+    RTCBench()
+    {
+        isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+        isce3::product::Product product(file);
+        orbit = product.metadata().orbit();
+        dop = product.metadata().procInfo().dopplerCentroid('A');
+        dop.boundsError(false);
+        radar_grid = isce3::product::RadarGridParameters(product, 'A')
+                             .multilook(5, 5);
+    }
+
+    // Run area-projection RTC with in-memory outputs and return the area
+    // factor (and optionally the number of looks)
+    std::valarray<float> runRTC(rtcAccumulationMode mode,
+                                std::valarray<float>* nlooks = nullptr)
+    {
+        isce3::io::Raster dem(TESTDATA_DIR "srtm_cropped.tif");
+        isce3::io::Raster out_raster("/vsimem/rtcbench.bin",
+                                     radar_grid.width(), radar_grid.length(),
+                                     1, GDT_Float32, "ENVI");
+        isce3::io::Raster nlooks_raster("/vsimem/rtcbench_nlooks.bin",
+                                        radar_grid.width(),
+                                        radar_grid.length(), 1, GDT_Float32,
+                                        "ENVI");
+        isce3::geometry::facetRTC(
+                radar_grid, orbit, dop, dem, out_raster,
+                isce3::geometry::rtcInputRadiometry::BETA_NAUGHT,
+                isce3::geometry::rtcAreaMode::AREA_FACTOR,
+                isce3::geometry::rtcAlgorithm::RTC_AREA_PROJECTION, 2,
+                std::numeric_limits<float>::quiet_NaN(), 1,
+                nlooks != nullptr ? &nlooks_raster : nullptr,
+                isce3::geometry::rtcMemoryMode::RTC_AUTO,
+                isce3::core::dataInterpMethod::BIQUINTIC_METHOD, 1e-4, 100,
+                1e-4, mode);
+
+        std::valarray<float> area(radar_grid.size());
+        out_raster.getBlock(area, 0, 0, radar_grid.width(),
+                            radar_grid.length());
+        if (nlooks != nullptr) {
+            nlooks->resize(radar_grid.size());
+            nlooks_raster.getBlock(*nlooks, 0, 0, radar_grid.width(),
+                                   radar_grid.length());
+        }
+        return area;
+    }
+};
+
+// Report area-projection RTC run time against thread count for both
+// accumulation modes
+TEST_F(RTCBench, Scaling)
+{
+#ifdef _OPENMP
+    const int maxThreads = omp_get_max_threads();
+#else
+    const int maxThreads = 1;
+#endif
+
+    std::valarray<float> atomic_reference, tiles_reference;
+    for (auto mode : {rtcAccumulationMode::RTC_ACCUMULATE_ATOMIC,
+                      rtcAccumulationMode::RTC_ACCUMULATE_TILES}) {
+        const bool tiles = (mode == rtcAccumulationMode::RTC_ACCUMULATE_TILES);
+
+        for (int nthreads = 1;; nthreads = std::min(2 * nthreads, maxThreads)) {
+#ifdef _OPENMP
+            omp_set_num_threads(nthreads);
+#endif
+            const auto start = std::chrono::steady_clock::now();
+            const auto area = runRTC(mode);
+            const std::chrono::duration<double> elapsed =
+                    std::chrono::steady_clock::now() - start;
+
+            std::cout << (tiles ? "tiles" : "atomic")
+                      << " accumulation, threads: " << nthreads
+                      << ", time: " << elapsed.count() << " s" << std::endl;
+
+            if (nthreads == 1 and not tiles)
+                atomic_reference = area;
+
+            // tiled accumulation must not depend on the number of threads
+            if (tiles) {
+                if (tiles_reference.size() == 0) {
+                    tiles_reference = area;
+                } else {
+                    ASSERT_EQ(area.size(), tiles_reference.size());
+                    for (size_t i = 0; i < area.size(); ++i) {
+                        if (std::isnan(tiles_reference[i])) {
+                            EXPECT_TRUE(std::isnan(area[i]));
+                        } else {
+                            EXPECT_EQ(area[i], tiles_reference[i]);
+                        }
+                    }
+                }
+            }
+
+            if (nthreads == maxThreads)
+                break;
+        }
+    }
+
+    // both modes accumulate the same areas up to round-off
+    ASSERT_EQ(atomic_reference.size(), tiles_reference.size());
+    for (size_t i = 0; i < tiles_reference.size(); ++i) {
+        if (std::isnan(atomic_reference[i]) or std::isnan(tiles_reference[i]))
+            continue;
+        EXPECT_NEAR(tiles_reference[i], atomic_reference[i],
+                    1e-4 * std::max(1.f, std::abs(atomic_reference[i])));
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads(maxThreads);
+#endif
+}
+
+// The number of looks accumulated over the block tiles must match the
+// atomic accumulation
+TEST_F(RTCBench, NLooks)
+{
+    std::valarray<float> atomic_nlooks, tiles_nlooks;
+    const auto atomic_area =
+            runRTC(rtcAccumulationMode::RTC_ACCUMULATE_ATOMIC, &atomic_nlooks);
+    const auto tiles_area =
+            runRTC(rtcAccumulationMode::RTC_ACCUMULATE_TILES, &tiles_nlooks);
+
+    ASSERT_EQ(atomic_nlooks.size(), tiles_nlooks.size());
+    size_t nvalid = 0;
+    for (size_t i = 0; i < tiles_nlooks.size(); ++i) {
+        if (std::isnan(atomic_nlooks[i])) {
+            EXPECT_TRUE(std::isnan(tiles_nlooks[i]));
+            continue;
+        }
+        EXPECT_NEAR(tiles_nlooks[i], atomic_nlooks[i],
+                    1e-4 * std::max(1.f, std::abs(atomic_nlooks[i])));
+        if (atomic_nlooks[i] > 0)
+            ++nvalid;
+    }
+    EXPECT_GT(nvalid, 0);
+
+    // requesting the number of looks does not change the area factor
+    for (size_t i = 0; i < tiles_area.size(); ++i) {
+        if (std::isnan(atomic_area[i]) or std::isnan(tiles_area[i]))
+            continue;
+        EXPECT_NEAR(tiles_area[i], atomic_area[i],
+                    1e-4 * std::max(1.f, std::abs(atomic_area[i])));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
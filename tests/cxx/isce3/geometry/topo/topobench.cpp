@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <string>
+#include <valarray>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <isce3/core/Basis.h>
+#include <isce3/core/Pixel.h>
+#include <isce3/core/Serialization.h>
+#include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/Serialization.h>
+#include <isce3/geometry/Topo.h>
+#include <isce3/geometry/TopoLayers.h>
+#include <isce3/geometry/geometry.h>
+#include <isce3/io/IH5.h>
+#include <isce3/io/Raster.h>
+#include <isce3/product/Product.h>
+
+using isce3::io::Raster;
+
+// Run topo with in-memory outputs and return the x layer
+std::valarray<double> runTopo(isce3::geometry::Topo& topo, Raster& demRaster)
+{
+    const auto& grid = topo.radarGridParameters();
+    const size_t width = grid.width(), length = grid.length();
+
+    std::vector<std::string> names {"x", "y", "z", "inc", "hdg", "localInc",
+                                    "localPsi", "sim", "mask"};
+    std::vector<Raster> rasters;
+    for (const auto& name : names) {
+        const GDALDataType dtype = (name == "x" or name == "y" or name == "z")
+                                           ? GDT_Float64
+                                           : (name == "mask" ? GDT_Byte
+                                                             : GDT_Float32);
+        rasters.emplace_back("/vsimem/topobench_" + name + ".rdr", width,
+                             length, 1, dtype, "ENVI");
+    }
+
+    isce3::geometry::TopoLayers layers;
+    layers.setRasters(rasters[0], rasters[1], rasters[2], rasters[3],
+                      rasters[4], rasters[5], rasters[6], rasters[7],
+                      rasters[8]);
+    topo.computeMask(true);
+    topo.topo(demRaster, layers);
+
+    std::valarray<double> x(width * length);
+    rasters[0].getBlock(x, 0, 0, width, length);
+    return x;
+}
+
+// Report topo throughput against thread count
+TEST(TopoBench, Throughput)
+{
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::Product product(file);
+
+    isce3::geometry::Topo topo(product, 'A', true);
+    std::ifstream xmlfid(TESTDATA_DIR "topo.xml", std::ios::in);
+    {
+        cereal::XMLInputArchive archive(xmlfid);
+        archive(cereal::make_nvp("Topo", topo));
+    }
+
+    Raster demRaster(TESTDATA_DIR "srtm_cropped.tif");
+
+    const double npixels = topo.radarGridParameters().size();
+
+#ifdef _OPENMP
+    const int maxThreads = omp_get_max_threads();
+#else
+    const int maxThreads = 1;
+#endif
+
+    std::valarray<double> reference;
+    for (int nthreads = 1;; nthreads = std::min(2 * nthreads, maxThreads)) {
+#ifdef _OPENMP
+        omp_set_num_threads(nthreads);
+#endif
+        const auto start = std::chrono::steady_clock::now();
+        const auto x = runTopo(topo, demRaster);
+        const std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+
+        std::cout << "threads: " << nthreads
+                  << ", time: " << elapsed.count() << " s"
+                  << ", throughput: " << npixels / elapsed.count()
+                  << " pixels/s" << std::endl;
+
+        // results must not depend on the number of threads
+        if (reference.size() == 0) {
+            reference = x;
+        } else {
+            ASSERT_EQ(x.size(), reference.size());
+            for (size_t i = 0; i < x.size(); ++i) {
+                if (std::isnan(reference[i])) {
+                    EXPECT_TRUE(std::isnan(x[i]));
+                } else {
+                    EXPECT_EQ(x[i], reference[i]);
+                }
+            }
+        }
+
+        if (nthreads == maxThreads)
+            break;
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads(maxThreads);
+#endif
+}
+
+// Report the run time of the batch rdr2geo used by Topo against per-pixel
+// rdr2geo calls, over the range lines of the radar grid
+TEST(TopoBench, BatchRdr2geo)
+{
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::Product product(file);
+
+    isce3::geometry::Topo topo(product, 'A', true);
+    std::ifstream xmlfid(TESTDATA_DIR "topo.xml", std::ios::in);
+    {
+        cereal::XMLInputArchive archive(xmlfid);
+        archive(cereal::make_nvp("Topo", topo));
+    }
+    const auto& grid = topo.radarGridParameters();
+    const auto& orbit = topo.orbit();
+    const auto& ellipsoid = topo.ellipsoid();
+    const auto& doppler = topo.doppler();
+
+    Raster demRaster(TESTDATA_DIR "srtm_cropped.tif");
+    isce3::geometry::DEMInterpolator dem;
+    dem.loadDEM(demRaster);
+    const double h0 = dem.midLonLat()[2];
+
+    // same tile width as Topo, in which each tile is one batch call
+    const size_t width = grid.width(), length = grid.length();
+    const size_t tileWidth = topo.tileWidth();
+    std::vector<double> rngs(width), dopfacts(width);
+    std::vector<double> lons(width), lats(width), hs(width);
+    std::vector<isce3::core::Vec3> llhScalar(width * length);
+    std::vector<isce3::core::Vec3> llhBatch(width * length);
+
+    std::chrono::duration<double> scalarTime(0.0), batchTime(0.0);
+    for (size_t line = 0; line < length; ++line) {
+        const double t = grid.sensingTime(line);
+        isce3::core::Vec3 pos, vel;
+        orbit.interpolate(&pos, &vel, t);
+        const isce3::core::Basis TCNbasis(pos, vel);
+        for (size_t i = 0; i < width; ++i) {
+            rngs[i] = grid.slantRange(i);
+            dopfacts[i] = 0.5 * grid.wavelength() * doppler.eval(t, rngs[i])
+                        / vel.norm() * rngs[i];
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < width; ++i) {
+            isce3::core::Vec3 llh {0.0, 0.0, h0};
+            isce3::geometry::rdr2geo(
+                    isce3::core::Pixel(rngs[i], dopfacts[i], i), TCNbasis,
+                    pos, vel, ellipsoid, dem, llh, grid.lookSide(),
+                    topo.threshold(), topo.numiter(), topo.extraiter());
+            llhScalar[line * width + i] = llh;
+        }
+        scalarTime += std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        std::fill(hs.begin(), hs.end(), h0);
+        for (size_t i0 = 0; i0 < width; i0 += tileWidth) {
+            const size_t n = std::min(tileWidth, width - i0);
+            isce3::geometry::rdr2geoBatch(
+                    &rngs[i0], &dopfacts[i0], n, TCNbasis, pos, vel,
+                    ellipsoid, dem, &lons[i0], &lats[i0], &hs[i0],
+                    grid.lookSide(), topo.threshold(), topo.numiter(),
+                    topo.extraiter());
+        }
+        batchTime += std::chrono::steady_clock::now() - start;
+        for (size_t i = 0; i < width; ++i) {
+            llhBatch[line * width + i] = {lons[i], lats[i], hs[i]};
+        }
+    }
+
+    const double npixels = width * length;
+    std::cout << "per-pixel rdr2geo: " << scalarTime.count() << " s ("
+              << npixels / scalarTime.count() << " pixels/s)" << std::endl;
+    std::cout << "batch rdr2geo: " << batchTime.count() << " s ("
+              << npixels / batchTime.count() << " pixels/s)" << std::endl;
+    std::cout << "speedup: " << scalarTime.count() / batchTime.count()
+              << std::endl;
+
+    // both give the same targets
+    for (size_t k = 0; k < llhScalar.size(); ++k) {
+        const auto xyzScalar = ellipsoid.lonLatToXyz(llhScalar[k]);
+        const auto xyzBatch = ellipsoid.lonLatToXyz(llhBatch[k]);
+        ASSERT_LT((xyzScalar - xyzBatch).norm(), 1.0e-6);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
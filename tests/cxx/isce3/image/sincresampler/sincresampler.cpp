@@ -0,0 +1,73 @@
+//-*- C++ -*-
+//-*- coding: utf-8 -*-
+
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+// isce3::core
+#include "isce3/core/Constants.h"
+#include "isce3/core/Interpolator.h"
+#include "isce3/core/Matrix.h"
+
+// isce3::image
+#include "isce3/image/SincResampler.h"
+
+// Compare against deramping a chip and interpolating it with the generic 2D
+// sinc interpolator, as done historically in ResampSlc
+TEST(SincResamplerTest, MatchesChipInterpolation) {
+
+    using cfloat = std::complex<float>;
+    const int chipSize = isce3::core::SINC_ONE;
+    const int chipHalf = chipSize / 2;
+    const int width = 64, length = 48;
+
+    // Random complex image
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<cfloat> image(width * length);
+    for (auto & z : image) {
+        z = cfloat(dist(gen), dist(gen));
+    }
+
+    const isce3::core::Sinc2dInterpolator<cfloat> interp(chipSize - 1,
+                                                        isce3::core::SINC_SUB);
+    const isce3::image::SincResampler resampler(chipSize - 1,
+                                                isce3::core::SINC_SUB);
+    isce3::core::Matrix<cfloat> chip(chipSize, chipSize);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        const int intAz = chipHalf + trial % (length - chipSize);
+        const int intRg = chipHalf + (7 * trial) % (width - chipSize);
+        const double fracAz = (trial % 17) / 17.0;
+        const double fracRg = (trial % 13) / 13.0;
+        const double dop = 0.05 * (trial % 11) - 0.25;
+
+        // Reference: deramped chip + generic interpolator
+        for (int ii = 0; ii < chipSize; ++ii) {
+            const double phase = dop * (ii - 4.0);
+            const cfloat cval(std::cos(phase), -std::sin(phase));
+            for (int jj = 0; jj < chipSize; ++jj) {
+                chip(ii, jj) = image[(intAz + ii - chipHalf) * width
+                                     + intRg + jj - chipHalf] * cval;
+            }
+        }
+        const cfloat ref = interp.interpolate(
+            isce3::core::SINC_HALF + fracRg, isce3::core::SINC_HALF + fracAz,
+            chip);
+
+        const cfloat val = resampler.interpolate(image.data(), width, intAz,
+                                                 intRg, fracAz, fracRg, dop);
+        ASSERT_NEAR(val.real(), ref.real(), 1.0e-5);
+        ASSERT_NEAR(val.imag(), ref.imag(), 1.0e-5);
+    }
+}
+
+int main(int argc, char * argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+// end of file
@@ -1,5 +1,9 @@
 //
 
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <limits>
 #include <numeric>
 #include <gtest/gtest.h>
 
@@ -1168,6 +1172,79 @@ TEST_F(IH5Test, createFloat16Dataset) {
 }
 
 
+TEST_F(IH5Test, createDataSetWithProps) {
+
+    std::string fileName("dummyHdf5Props.h5");
+    std::remove(fileName.c_str());
+
+    // Align large objects to 4 kB blocks
+    isce3::io::FileAccessProps fileProps;
+    fileProps.alignment = 4096;
+    fileProps.alignThreshold = 64 * 1024;
+    isce3::io::IH5File fic(fileName, 'x', fileProps);
+    isce3::io::IGroup grp = fic.openGroup("/");
+
+    const int length = 300, width = 500;
+    std::array<int, 2> dims = {length, width};
+    std::vector<float> v1(length * width);
+    std::iota(v1.begin(), v1.end(), 0.0f);
+
+    // Full-width strips of 64 lines, shuffled and compressed, NaN filled
+    isce3::io::DataSetCreateProps props;
+    props.chunks = {64, 1000};
+    props.shuffle = true;
+    props.deflate = 4;
+    props.useFillValue = true;
+    props.fillValue = std::numeric_limits<double>::quiet_NaN();
+    props.chunkCache.nbytes = 4 * 64 * width * sizeof(float);
+
+    isce3::io::IDataSet dset = grp.createDataSet<float>("strips", dims, props);
+
+    // Chunks are clipped to the dataset dimensions
+    std::vector<int> chunks = dset.getChunkSize();
+    ASSERT_EQ(chunks[0], 64);
+    ASSERT_EQ(chunks[1], width);
+
+    // Unwritten elements hold the fill value
+    std::vector<float> v1r;
+    dset.read(v1r);
+    ASSERT_EQ(v1r.size(), length * width);
+    ASSERT_TRUE(std::isnan(v1r[0]));
+
+    // Whole rows of chunks (including the partial last one) are compressed
+    // in parallel, other lines go through HDF5
+    dset.writeLines(v1.data(), 0, 128);
+    dset.writeLines(v1.data() + 128 * width, 128, 100);
+    dset.writeLines(v1.data() + 228 * width, 228, 28);
+    dset.writeLines(v1.data() + 256 * width, 256, length - 256);
+
+    dset.read(v1r);
+    ASSERT_EQ(v1r, v1);
+    EXPECT_LT(dset.getStorageSize(), v1.size() * sizeof(float));
+
+    EXPECT_THROW(dset.writeLines(v1.data(), 256, 64),
+                 isce3::except::OutOfRange);
+
+    // Complex dataset with default 128x128 chunks written in one go
+    std::vector<std::complex<float>> v2(length * width);
+    for (int i = 0; i < length * width; i++)
+        v2[i] = std::complex<float>(i, -i);
+    isce3::io::DataSetCreateProps cprops;
+    cprops.deflate = 1;
+    dset = grp.createDataSet<std::complex<float>>("complex", dims, cprops);
+    dset.writeLines(v2.data(), 0, length);
+
+    std::vector<std::complex<float>> v2r;
+    dset.read(v2r);
+    ASSERT_EQ(v2r, v2);
+
+    dset.close();
+    grp.close();
+    fic.close();
+    std::remove(fileName.c_str());
+}
+
+
 int main( int argc, char * argv[] ) {
     testing::InitGoogleTest( &argc, argv );
     return RUN_ALL_TESTS();
@@ -1,6 +1,12 @@
 //
 
+#include <array>
+#include <chrono>
+#include <cstdio>
 #include <gtest/gtest.h>
+#include <iostream>
+#include <numeric>
+#include <vector>
 
 #include "isce3/io/IH5Dataset.h"
 #include "gdal_alg.h"
@@ -73,6 +79,93 @@ TEST_F(IH5Test, dataSet3D) {
 }
 
 
+// Read a chunked dataset in full-width strips and in tiles through GDAL and
+// report the throughput of each access pattern
+TEST_F(IH5Test, chunkedReads) {
+    const std::string wFileName("ih5gdal_chunked.h5");
+    std::remove(wFileName.c_str());
+
+    const int length = 1000, width = 1500;
+    std::vector<float> data(length * width);
+    std::iota(data.begin(), data.end(), 0.0f);
+    {
+        isce3::io::IH5File file(wFileName, 'x');
+        std::array<int, 2> dims = {length, width};
+        isce3::io::IDataSet dset =
+                file.createDataSet<float>("data", dims, 1, 0, 1);
+        dset.write(data.data(), data.size());
+        dset.close();
+        file.close();
+    }
+
+    isce3::io::IH5File file(wFileName);
+    isce3::io::IDataSet dset = file.openDataSet("data");
+
+    // cache sized for strips of full rows, one row of chunks deep
+    const int stripLines = isce3::io::chunkSizeX;
+    isce3::io::ChunkCache cache = dset.getChunkCache(stripLines);
+    const size_t chunkBytes = isce3::io::chunkSizeX * isce3::io::chunkSizeY *
+                              sizeof(float);
+    ASSERT_GE(cache.nbytes, ((width + isce3::io::chunkSizeY - 1) /
+                             isce3::io::chunkSizeY) * chunkBytes);
+    ASSERT_GT(cache.nslots, cache.nbytes / chunkBytes);
+
+    // the driver reopens the dataset with that cache
+    ASSERT_LT(dset.getAccessChunkCache().nbytes, cache.nbytes);
+    GDALDataset *ds = static_cast<GDALDataset*>(
+            GDALOpen(dset.toGDAL(stripLines).c_str(), GA_ReadOnly));
+    auto h5ds = static_cast<isce3::io::IDataSet*>(ds->GetInternalHandle(nullptr));
+    const isce3::io::ChunkCache applied = h5ds->getAccessChunkCache();
+    ASSERT_EQ(applied.nbytes, cache.nbytes);
+    ASSERT_EQ(applied.nslots, cache.nslots);
+    ASSERT_EQ(applied.w0, cache.w0);
+
+    // by default, for reads of single lines
+    {
+        GDALDataset *lineds = static_cast<GDALDataset*>(
+                GDALOpen(dset.toGDAL().c_str(), GA_ReadOnly));
+        auto lineh5ds = static_cast<isce3::io::IDataSet*>(
+                lineds->GetInternalHandle(nullptr));
+        ASSERT_EQ(lineh5ds->getAccessChunkCache().nbytes,
+                  dset.getChunkCache(1).nbytes);
+        GDALClose(lineds);
+    }
+
+    GDALRasterBand *band = ds->GetRasterBand(1);
+
+    auto readWindows = [&](int nlines, int ncols, const char * name) {
+        std::vector<float> out(data.size(), -1.0f);
+        const auto start = std::chrono::steady_clock::now();
+        for (int y = 0; y < length; y += nlines) {
+            for (int x = 0; x < width; x += ncols) {
+                const int ny = std::min(nlines, length - y);
+                const int nx = std::min(ncols, width - x);
+                ASSERT_EQ(band->RasterIO(GF_Read, x, y, nx, ny,
+                                         &out[y * width + x], nx, ny,
+                                         GDT_Float32, sizeof(float),
+                                         width * sizeof(float)),
+                          CE_None);
+            }
+        }
+        const std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+        std::cout << name << " reads: "
+                  << data.size() * sizeof(float) / 1e6 / elapsed.count()
+                  << " MB/s" << std::endl;
+        ASSERT_EQ(out, data);
+    };
+
+    readWindows(stripLines, width, "row-strip");
+    readWindows(200, 300, "tile");
+    readWindows(1, width, "line");
+
+    GDALClose(ds);
+    dset.close();
+    file.close();
+    std::remove(wFileName.c_str());
+}
+
+
 // Main
 int main( int argc, char * argv[] ) {
     testing::InitGoogleTest( &argc, argv );
@@ -7,6 +7,7 @@
 
 #include <numeric>
 #include <gtest/gtest.h>
+#include <thread>
 #include <vector>
 
 #include <isce3/io/Raster.h>
@@ -273,6 +274,210 @@ TEST_F(RasterTest, pushBack) {
 }
 
 
+// Read blocks from many threads at once through the pooled handles
+TEST_F(RasterTest, concurrentReads) {
+  const std::string filename = "concurrent.bin";
+  std::remove(filename.c_str());
+  isce3::io::Raster raster(filename, nc, nl, 1, GDT_Float32, "ENVI");
+
+  std::vector<float> data(nc * nl);
+  std::iota(data.begin(), data.end(), 0.0f);
+  raster.setBlock(data, 0, 0, nc, nl);
+
+  raster.concurrentReads(true);
+  ASSERT_TRUE(raster.concurrentReads());
+
+  // blocks of nby lines, each read by one of nthreads threads
+  const uint nthreads = 4;
+  const uint nblocks = (nl + nby - 1) / nby;
+  std::vector<float> out(nc * nl, -1.0f);
+  std::vector<std::thread> threads;
+  for (uint t = 0; t < nthreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (uint b = t; b < nblocks; b += nthreads) {
+        const uint y0 = b * nby;
+        const uint ny = std::min(nby, nl - y0);
+        raster.getBlock(&out[y0 * nc], 0, y0, nc, ny);
+      }
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  ASSERT_EQ(out, data);
+
+  raster.concurrentReads(false);
+  ASSERT_FALSE(raster.concurrentReads());
+}
+
+
+// Read blocks from many threads at once through the tile cache
+TEST_F(RasterTest, blockCache) {
+  const std::string filename = "blockcache.bin";
+  std::remove(filename.c_str());
+  isce3::io::Raster raster(filename, nc, nl, 1, GDT_Float32, "ENVI");
+
+  std::vector<float> data(nc * nl);
+  std::iota(data.begin(), data.end(), 0.0f);
+  raster.setBlock(data, 0, 0, nc, nl);
+
+  // tiles of 16 x 32 pixels, budget of a few tiles per shard
+  raster.blockCache(true, 32, 16, 4 * 4 * 16 * 32 * sizeof(float), 4);
+  ASSERT_TRUE(raster.blockCache());
+
+  // blocks of nby lines, each read twice by one of nthreads threads
+  const uint nthreads = 4;
+  const uint nblocks = (nl + nby - 1) / nby;
+  std::vector<float> out(nc * nl, -1.0f);
+  std::vector<std::thread> threads;
+  for (uint t = 0; t < nthreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (uint b = t; b < nblocks; b += nthreads) {
+        const uint y0 = b * nby;
+        const uint ny = std::min(nby, nl - y0);
+        raster.getBlock(&out[y0 * nc], 0, y0, nc, ny);
+        raster.getBlock(&out[y0 * nc], 0, y0, nc, ny);
+      }
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  ASSERT_EQ(out, data);
+
+  auto stats = raster.blockCacheStats();
+  EXPECT_GT(stats.hits, 0u);
+  EXPECT_GT(stats.misses, 0u);
+  EXPECT_GT(stats.evictions, 0u);
+  EXPECT_LE(stats.bytes, 4 * 4 * 16 * 32 * sizeof(float));
+
+  // reads with data type conversion and a window not aligned to tiles
+  std::vector<double> window(nbx * nby);
+  raster.getBlock(window, 13, 27, nbx, nby);
+  for (uint y = 0; y < nby; ++y)
+    for (uint x = 0; x < nbx; ++x)
+      ASSERT_EQ(window[y * nbx + x], data[(27 + y) * nc + 13 + x]);
+
+  // writes invalidate the cached tiles
+  std::vector<float> ones(nbx * nby, 1.0f);
+  raster.setBlock(ones, 13, 27, nbx, nby);
+  raster.getBlock(window, 13, 27, nbx, nby);
+  for (auto value : window)
+    ASSERT_EQ(value, 1.0);
+
+  raster.blockCache(false);
+  ASSERT_FALSE(raster.blockCache());
+  ASSERT_EQ(raster.blockCacheStats().hits, 0u);
+}
+
+
+// The least recently used tile is evicted first
+TEST_F(RasterTest, blockCacheRecency) {
+  const std::string filename = "blockcacherecency.bin";
+  std::remove(filename.c_str());
+  isce3::io::Raster raster(filename, nc, nl, 1, GDT_Float32, "ENVI");
+  std::vector<float> data(nc * nl, 0.0f);
+  raster.setBlock(data, 0, 0, nc, nl);
+
+  // single shard holding two full-width tiles of 16 lines
+  raster.blockCache(true, 0, 16, 2 * 16 * nc * sizeof(float), 1);
+  std::vector<float> line(nc);
+  auto readTile = [&](uint tile) { raster.getBlock(line, 0, 16 * tile, nc, 1); };
+
+  // read tiles 0, 1, then 0 again, so that 1 is the least recently used
+  readTile(0);
+  readTile(1);
+  readTile(0);
+  ASSERT_EQ(raster.blockCacheStats().hits, 1u);
+
+  // reading tile 2 evicts tile 1 and keeps tile 0
+  readTile(2);
+  ASSERT_EQ(raster.blockCacheStats().evictions, 1u);
+  readTile(0);
+  EXPECT_EQ(raster.blockCacheStats().hits, 2u);
+  readTile(1);
+  EXPECT_EQ(raster.blockCacheStats().misses, 4u);
+}
+
+
+// Writes are visible to later reads through the pooled handles, with
+// and without the tile cache
+TEST_F(RasterTest, concurrentReadsAfterWrite) {
+  const std::string filename = "concurrentwrite.bin";
+  std::remove(filename.c_str());
+  isce3::io::Raster raster(filename, nc, nl, 1, GDT_Float32, "ENVI");
+
+  std::vector<float> data(nc * nl);
+  std::iota(data.begin(), data.end(), 0.0f);
+  raster.setBlock(data, 0, 0, nc, nl);
+  raster.concurrentReads(true);
+
+  for (bool cached : {false, true}) {
+    raster.blockCache(cached, 32, 16);
+
+    // read the window first so that it is cached by the read handle (and
+    // the tile cache), then overwrite it and read it back from a thread
+    std::vector<float> window(nbx * nby);
+    raster.getBlock(window, 13, 27, nbx, nby);
+
+    const float value = cached ? 2.0f : 1.0f;
+    std::vector<float> written(nbx * nby, value);
+    raster.setBlock(written, 13, 27, nbx, nby);
+
+    std::thread reader([&]() { raster.getBlock(window, 13, 27, nbx, nby); });
+    reader.join();
+    for (auto v : window)
+      ASSERT_EQ(v, value);
+
+    raster.getBlock(window, 13, 27, nbx, nby);
+    for (auto v : window)
+      ASSERT_EQ(v, value);
+  }
+}
+
+
+// Memory-mapped views of a flat binary raster
+TEST_F(RasterTest, memmap) {
+  const std::string filename = "memmap.bin";
+  std::remove(filename.c_str());
+  isce3::io::Raster raster(filename, nc, nl, 1, GDT_Float32, "ENVI");
+
+  std::vector<float> data(nc * nl);
+  std::iota(data.begin(), data.end(), 0.0f);
+  raster.setBlock(data, 0, 0, nc, nl);
+
+  auto view = raster.memmap<float>();
+  ASSERT_EQ(view.length(), int(nl));
+  ASSERT_EQ(view.width(), int(nc));
+  const char * base = reinterpret_cast<const char *>(view.data());
+  for (uint y = 0; y < nl; ++y)
+    for (uint x = 0; x < nc; ++x) {
+      const char * pixel = base + y * view.rowstride() + x * view.colstride();
+      ASSERT_EQ(*reinterpret_cast<const float *>(pixel), data[y * nc + x]);
+    }
+
+  raster.memmapAdvise(isce3::io::Raster::MEMMAP_SEQUENTIAL, 0, nl);
+  raster.memmapAdvise(isce3::io::Raster::MEMMAP_WILLNEED, nl - nby, 2 * nby);
+
+  // in-place updates are visible to getBlock
+  auto matrix = raster.memmapMatrix<float>();
+  ASSERT_EQ(matrix.length(), nl);
+  ASSERT_EQ(matrix.width(), nc);
+  ASSERT_EQ(matrix(27, 13), data[27 * nc + 13]);
+  matrix(27, 13) = -1.0f;
+  float value;
+  raster.getValue(value, 13, 27);
+  ASSERT_EQ(value, -1.0f);
+
+  // copies share the mapping
+  isce3::io::Raster copy(raster);
+  ASSERT_EQ(copy.memmap<float>().data(), view.data());
+
+  EXPECT_THROW(raster.memmap<double>(), isce3::except::RuntimeError);
+  EXPECT_THROW(raster.memmap<float>(2), isce3::except::OutOfRange);
+}
+
+
 // Main
 int main( int argc, char * argv[] ) {
     testing::InitGoogleTest( &argc, argv );
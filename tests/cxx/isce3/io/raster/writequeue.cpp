@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <isce3/core/Matrix.h>
+#include <isce3/io/Raster.h>
+#include <isce3/io/WriteQueue.h>
+
+TEST(WriteQueueTest, TaskOrder)
+{
+    std::vector<int> order;
+    {
+        isce3::io::WriteQueue queue(2);
+        for (int i = 0; i < 100; ++i) {
+            queue.push([&order, i]() { order.push_back(i); });
+        }
+        queue.flush();
+    }
+
+    std::vector<int> expected(100);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(order, expected);
+}
+
+TEST(WriteQueueTest, SetBlock)
+{
+    const size_t width = 20, length = 30, block_length = 7;
+    isce3::io::Raster raster("writequeue.bin", width, length, 1, GDT_Float32,
+                             "ENVI");
+
+    isce3::io::WriteQueue queue;
+    for (size_t y0 = 0; y0 < length; y0 += block_length) {
+        const size_t ny = std::min(block_length, length - y0);
+        auto block = std::make_unique<isce3::core::Matrix<float>>(ny, width);
+        for (size_t i = 0; i < ny; ++i)
+            for (size_t j = 0; j < width; ++j)
+                (*block)(i, j) = (y0 + i) * width + j;
+        queue.setBlock(raster, std::move(block), 0, y0, width, ny);
+    }
+    queue.flush();
+
+    std::vector<float> data(width * length);
+    raster.getBlock(data, 0, 0, width, length);
+    for (size_t k = 0; k < data.size(); ++k)
+        EXPECT_EQ(data[k], k);
+}
+
+TEST(WriteQueueTest, Exceptions)
+{
+    isce3::io::WriteQueue queue;
+    bool ran = false;
+    queue.push([]() { throw std::runtime_error("write failed"); });
+    queue.push([&ran]() { ran = true; });
+    EXPECT_THROW(queue.flush(), std::runtime_error);
+
+    // tasks submitted after a failure are discarded
+    EXPECT_FALSE(ran);
+
+    // the error is reported once
+    EXPECT_NO_THROW(queue.flush());
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,10 +1,12 @@
 
 #include <complex>
+#include <fstream>
 #include <gtest/gtest.h>
 
 // support
 #include <numeric>
 #include <random>
+#include <vector>
 #include <pyre/grid.h>
 #include <pyre/journal.h>
 // ampcor
@@ -954,6 +956,111 @@ TEST(Ampcor, Correlate)
 
 
 
+// Testing that the frequency domain correlator reproduces the direct sum
+TEST(Ampcor, CorrelateFFT)
+{
+    // the reference tile extent
+    int refDim = 32;
+    // the margin around the reference tile
+    int margin = 12;
+    // therefore, the target tile extent
+    auto tgtDim = refDim + 2*margin;
+    //  the dimension of the correlation matrix
+    auto corDim = 2*margin + 1;
+    // the number of pairs
+    auto pairs = 5;
+
+    // the number of cells in a reference tile
+    auto refCells = refDim * refDim;
+    // the number of cells in a target tile
+    auto tgtCells = tgtDim * tgtDim;
+    // the number of cells in a correlation matrix
+    auto corCells = corDim * corDim;
+
+    // the reference shape
+    slc_t::shape_type refShape = {refDim, refDim};
+    // the search window shape
+    slc_t::shape_type tgtShape = {tgtDim, tgtDim};
+
+    // the reference layout with the given shape and default packing
+    slc_t::layout_type refLayout = { refShape };
+    // the search window layout with the given shape and default packing
+    slc_t::layout_type tgtLayout = { tgtShape };
+
+    // make a correlator
+    correlator_t c(pairs, refLayout, tgtLayout);
+
+    // a random number generator
+    std::mt19937 rng { 2020 };
+    // use it to build a normal distribution
+    std::normal_distribution<float> normal {};
+
+    // build the tile pairs
+    for (auto pid=0; pid<pairs; ++pid) {
+        // make a reference raster
+        slc_t ref(refLayout);
+        // and fill it with speckle
+        for (auto idx : ref.layout()) {
+            ref[idx] = pixel_t(normal(rng), normal(rng));
+        }
+        // make a target tile
+        slc_t tgt(tgtLayout);
+        // fill it with speckle as well
+        for (auto idx : tgt.layout()) {
+            tgt[idx] = pixel_t(normal(rng), normal(rng));
+        }
+        // and hide a noisy copy of the reference tile in it
+        auto slice = tgt.layout().slice({pid, 2*pid}, {pid+refDim, 2*pid+refDim});
+        auto tgtView = tgt.view(slice);
+        std::transform(ref.view().begin(), ref.view().end(), tgtView.begin(), tgtView.begin(),
+                       [](pixel_t r, pixel_t t) { return r + 0.5f * t; });
+
+        // add this pair to the correlator
+        c.addReferenceTile(pid, ref.constview());
+        c.addTargetTile(pid, tgt.constview());
+    }
+
+    // compute the amplitude of every pixel
+    auto rArena = c._detect(c.arena(), refDim, tgtDim);
+    // compute reference tile statistics
+    auto refStats = c._refStats(rArena, refDim, tgtDim);
+    // compute the sum area tables
+    auto sat = c._sat(rArena, refDim, tgtDim);
+    // compute the average amplitude of all possible ref shaped sub-tiles in the target tile
+    auto tgtStats = c._tgtStats(sat, refDim, tgtDim, corDim);
+
+    // correlate directly
+    std::vector<value_t> direct(pairs * corCells);
+    ampcor::kernels::correlate(rArena, refStats, tgtStats, pairs,
+                               refCells, tgtCells, corCells, refDim, tgtDim, corDim,
+                               direct.data());
+    // and in the frequency domain
+    std::vector<value_t> fft(pairs * corCells);
+    ampcor::kernels::correlateFFT(rArena, refStats, tgtStats, pairs,
+                                  refCells, tgtCells, corCells, refDim, tgtDim, corDim,
+                                  fft.data());
+
+    // the two surfaces agree to within single precision round-off
+    for (std::size_t cell = 0; cell < direct.size(); ++cell) {
+        ASSERT_NEAR(direct[cell], fft[cell], 1e-5);
+    }
+    // and both peak at the hidden copy of the reference tile
+    for (auto pid=0; pid<pairs; ++pid) {
+        auto begin = fft.begin() + pid*corCells;
+        auto peak = std::max_element(begin, begin + corCells) - begin;
+        EXPECT_EQ(peak, pid*corDim + 2*pid);
+    }
+
+    // clean up
+    delete [] tgtStats;
+    delete [] sat;
+    delete [] refStats;
+    delete [] rArena;
+}
+
+
+
+
 // Testing identification of the correlation peak
 TEST(Ampcor, MaxCor)
 {
@@ -1084,6 +1191,95 @@ TEST(Ampcor, MaxCor)
 
 
 
+// Testing the out-of-core driver on a pair of SLCs related by a constant shift
+TEST(Ampcor, Streaming)
+{
+    // the SLC type
+    using raster_t = ampcor::dom::SLC;
+    // the driver
+    using driver_t = ampcor::correlators::streaming_t<raster_t>;
+
+    // the reference tile extent
+    std::size_t refDim = 32;
+    // the margin around the reference tile
+    std::size_t margin = 8;
+    // therefore, the target tile extent
+    auto tgtDim = refDim + 2*margin;
+    // the shape of the offset grid
+    raster_t::shape_type gridShape = {3, 4};
+    // the shape of the rasters
+    raster_t::shape_type shape = {128, 160};
+    // the shift of the target raster relative to the reference raster
+    int rowShift = 2;
+    int colShift = -3;
+
+    // make a field of speckle large enough to accommodate the shift
+    auto rows = shape[0] + 2*margin;
+    auto cols = shape[1] + 2*margin;
+    std::mt19937 rng { 2020 };
+    std::normal_distribution<float> normal {};
+    std::vector<pixel_t> field(rows * cols);
+    for (auto & pixel : field) {
+        pixel = pixel_t(normal(rng), normal(rng));
+    }
+    // carve the two rasters out of it and save them
+    std::ofstream refFile("ampcor-streaming-ref.slc", std::ios::binary);
+    std::ofstream tgtFile("ampcor-streaming-tgt.slc", std::ios::binary);
+    for (std::size_t row = 0; row < shape[0]; ++row) {
+        auto ref = &field[(row + margin)*cols + margin];
+        auto tgt = &field[(row + margin - rowShift)*cols + margin - colShift];
+        refFile.write(reinterpret_cast<const char *>(ref), shape[1]*sizeof(pixel_t));
+        tgtFile.write(reinterpret_cast<const char *>(tgt), shape[1]*sizeof(pixel_t));
+    }
+    refFile.close();
+    tgtFile.close();
+
+    // map them
+    raster_t ref("ampcor-streaming-ref.slc", shape);
+    raster_t tgt("ampcor-streaming-tgt.slc", shape);
+
+    // the tile layouts
+    raster_t::layout_type refLayout { raster_t::shape_type{refDim, refDim} };
+    raster_t::layout_type tgtLayout { raster_t::shape_type{tgtDim, tgtDim} };
+    // a budget that fits five pairs at a time
+    auto memory = 5 * driver_t::footprint(refLayout, tgtLayout) + 1;
+    // make the driver
+    driver_t driver(refLayout, tgtLayout, {margin, margin}, {refDim, refDim}, gridShape, memory);
+    // verify that the grid is split in batches
+    ASSERT_EQ(driver.pairs(), 12u);
+    ASSERT_EQ(driver.batch(), 5u);
+    ASSERT_EQ(driver.batches(), 3u);
+
+    // collect the offset field
+    std::vector<value_t> offsets(2 * driver.pairs(), std::numeric_limits<value_t>::quiet_NaN());
+    std::size_t calls = 0;
+    driver.adjust(ref, tgt, [&](std::size_t first, std::size_t pairs, const value_t * batch) {
+        // the batches arrive in order
+        EXPECT_EQ(first, calls * driver.batch());
+        std::copy(batch, batch + 2*pairs, offsets.begin() + 2*first);
+        ++calls;
+    });
+    ASSERT_EQ(calls, driver.batches());
+
+    // every pair sees the shift
+    for (std::size_t pid = 0; pid < driver.pairs(); ++pid) {
+        EXPECT_NEAR(offsets[2*pid], rowShift, 0.125);
+        EXPECT_NEAR(offsets[2*pid + 1], colShift, 0.125);
+    }
+
+    // a budget too small for a single pair is an error
+    EXPECT_THROW(driver_t(refLayout, tgtLayout, {margin, margin}, {refDim, refDim}, gridShape,
+                          driver_t::footprint(refLayout, tgtLayout) - 1),
+                 std::invalid_argument);
+    // and so is a grid that does not fit in the rasters
+    driver_t big(refLayout, tgtLayout, {margin, margin}, {refDim, refDim}, {4, 4}, memory);
+    EXPECT_THROW(big.adjust(ref, tgt, [](std::size_t, std::size_t, const value_t *) {}),
+                 std::out_of_range);
+}
+
+
+
+
 int main(int argc, char * argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -14,6 +14,15 @@
 #include <map>
 #include <gtest/gtest.h>
 #include <isce3/io/Raster.h>
+#include <isce3/io/IH5.h>
+#include <isce3/core/Ellipsoid.h>
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/Orbit.h>
+#include <isce3/except/Error.h>
+#include <isce3/geocode/Geo2rdrCache.h>
+#include <isce3/product/GeoGridParameters.h>
+#include <isce3/product/Product.h>
+#include <isce3/product/RadarGridParameters.h>
 #include <isce3/signal/Covariance.h>
 #include <isce3/geometry/Geocode.h>
 #include <isce3/signal/Crossmul.h>
@@ -120,6 +129,109 @@ TEST(Covariance, DualpolCheck)
 
 }
 
+TEST(Covariance, Geo2rdrCache)
+{
+    // Geocoding covariance components with precomputed radar coordinates of
+    // the geocoded pixel centers should reproduce geocoding with the DEM
+
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::Product product(file);
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::Ellipsoid ellipsoid;
+    isce3::core::LUT2d<double> doppler =
+            product.metadata().procInfo().dopplerCentroid('A');
+    isce3::product::RadarGridParameters radarGrid(product, 'A');
+
+    const double threshold = 1.0e-9;
+    const int numiter = 25;
+    isce3::product::GeoGridParameters geoGrid(-115.6, 34.832, 0.002, -0.0008,
+                                             40, 38, 4326);
+
+    // radar coordinates encoded in the covariance values
+    const size_t rdrWidth = radarGrid.width();
+    const size_t rdrLength = radarGrid.length();
+    std::valarray<std::complex<float>> rdrData(rdrWidth * rdrLength);
+    for (size_t line = 0; line < rdrLength; ++line)
+        for (size_t pixel = 0; pixel < rdrWidth; ++pixel)
+            rdrData[line * rdrWidth + pixel] =
+                    std::complex<float>(pixel, line);
+    isce3::io::Raster rdrCov("cov_rdr.bin", rdrWidth, rdrLength, 1,
+                             GDT_CFloat32, "ENVI");
+    rdrCov.setBlock(rdrData, 0, 0, rdrWidth, rdrLength);
+
+    isce3::io::Raster demRaster(TESTDATA_DIR "srtm_cropped.tif");
+
+    auto geocodeCov = [&](
+            std::shared_ptr<const isce3::geocode::Geo2rdrCache> cache,
+            const std::string & filename) {
+        isce3::signal::Covariance<std::complex<float>> covarianceObj;
+        covarianceObj.orbit(orbit);
+        covarianceObj.ellipsoid(ellipsoid);
+        covarianceObj.thresholdGeo2rdr(threshold);
+        covarianceObj.numiterGeo2rdr(numiter);
+        covarianceObj.demBlockMargin(0.1);
+        covarianceObj.radarBlockMargin(10);
+        covarianceObj.interpolator(isce3::core::BILINEAR_METHOD);
+        covarianceObj.radarGrid(doppler, radarGrid.refEpoch(),
+                                radarGrid.sensingStart(),
+                                radarGrid.azimuthTimeInterval(),
+                                radarGrid.length(), radarGrid.startingRange(),
+                                radarGrid.rangePixelSpacing(),
+                                radarGrid.lookSide(), radarGrid.wavelength(),
+                                radarGrid.width());
+        covarianceObj.geoGrid(geoGrid.startX(), geoGrid.startY(),
+                              geoGrid.spacingX(), geoGrid.spacingY(),
+                              geoGrid.width(), geoGrid.length(),
+                              geoGrid.epsg());
+        covarianceObj.geo2rdrCache(cache);
+
+        isce3::io::Raster geoCov(filename, geoGrid.width(), geoGrid.length(),
+                                 1, GDT_CFloat32, "ENVI");
+        covarianceObj.geocodeCovariance(rdrCov, geoCov, demRaster);
+
+        std::valarray<std::complex<float>> geoData(geoGrid.width() *
+                                                   geoGrid.length());
+        geoCov.getBlock(geoData, 0, 0, geoGrid.width(), geoGrid.length());
+        return geoData;
+    };
+
+    const std::valarray<std::complex<float>> expected =
+            geocodeCov(nullptr, "cov_dem.geo");
+
+    // a cache sampled at the start of each pixel is rejected
+    ASSERT_THROW(geocodeCov(std::make_shared<isce3::geocode::Geo2rdrCache>(
+                                    geoGrid, demRaster, orbit, doppler,
+                                    ellipsoid, radarGrid.wavelength(),
+                                    radarGrid.lookSide(), threshold, numiter),
+                            "cov_rejected.geo"),
+                 isce3::except::InvalidArgument);
+
+    // and so is a cache computed for another wavelength
+    ASSERT_THROW(geocodeCov(std::make_shared<isce3::geocode::Geo2rdrCache>(
+                                    geoGrid, demRaster, orbit, doppler,
+                                    ellipsoid, 2.0 * radarGrid.wavelength(),
+                                    radarGrid.lookSide(), threshold, numiter,
+                                    1000, 0.1, 0.5),
+                            "cov_rejected.geo"),
+                 isce3::except::InvalidArgument);
+
+    const std::valarray<std::complex<float>> actual =
+            geocodeCov(std::make_shared<isce3::geocode::Geo2rdrCache>(
+                               geoGrid, demRaster, orbit, doppler, ellipsoid,
+                               radarGrid.wavelength(), radarGrid.lookSide(),
+                               threshold, numiter, 1000, 0.1, 0.5),
+                       "cov_cache.geo");
+
+    size_t nvalid = 0;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(actual[i].real(), expected[i].real(), 1.0e-3);
+        EXPECT_NEAR(actual[i].imag(), expected[i].imag(), 1.0e-3);
+        if (std::abs(expected[i]) > 0)
+            ++nvalid;
+    }
+    ASSERT_GT(nvalid, 0);
+}
+
 int main(int argc, char * argv[]) {
       testing::InitGoogleTest(&argc, argv);
       return RUN_ALL_TESTS();
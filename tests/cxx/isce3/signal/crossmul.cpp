@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <iostream>
 #include <cstdio>
 #include <sstream>
@@ -184,6 +185,125 @@ TEST(Crossmul, RunCrossmulWithAzimuthCommonBandFilter)
          
 
 
+TEST(Crossmul, ReuseCrossmul)
+{
+    // Running several pairs through one Crossmul object reuses its block
+    // buffers and must give the same interferogram every time
+    isce3::io::Raster referenceSlc(TESTDATA_DIR "warped_envisat.slc.vrt");
+    int width = referenceSlc.width();
+    int length = referenceSlc.length();
+
+    isce3::signal::Crossmul crsmul;
+    crsmul.rangeLooks(1);
+    crsmul.azimuthLooks(1);
+    crsmul.doCommonAzimuthbandFiltering(false);
+
+    std::valarray<std::complex<float>> first(width*length), data(width*length);
+    for (int run = 0; run < 3; ++run) {
+        isce3::io::Raster interferogram("igram_reuse.int", width, length, 1,
+                                        GDT_CFloat32, "ISCE");
+        crsmul.crossmul(referenceSlc, referenceSlc, interferogram);
+        interferogram.getBlock(data, 0, 0, width, length);
+
+        if (run == 0) {
+            first = data;
+            continue;
+        }
+        for (size_t i = 0; i < data.size(); ++i)
+            ASSERT_EQ(data[i], first[i]);
+    }
+}
+
+TEST(Crossmul, RunCrossmulOversampled)
+{
+    // Interferogram formed with range oversampling (fused upsample, multiply
+    // and look-down path) must match the block-wise Signal::upsample path.
+    // The secondary SLC is the reference SLC shifted by one pixel in range
+    // with a phase ramp, so that the interferogram depends on the upsampled
+    // data of both SLCs.
+    isce3::io::Raster referenceSlc(TESTDATA_DIR "warped_envisat.slc.vrt");
+    const size_t width = referenceSlc.width();
+    const size_t length = referenceSlc.length();
+    const size_t oversample = 2;
+
+    std::valarray<std::complex<float>> refData(width*length),
+            secData(width*length);
+    referenceSlc.getBlock(refData, 0, 0, width, length);
+    for (size_t line = 0; line < length; ++line) {
+        for (size_t col = 0; col < width; ++col) {
+            const size_t shifted = std::min(col + 1, width - 1);
+            const double phase = 0.05*col;
+            secData[line*width + col] = refData[line*width + shifted] *
+                    std::complex<float>(std::cos(phase), std::sin(phase));
+        }
+    }
+    isce3::io::Raster secondarySlc("secondary_ovs.slc", width, length, 1,
+                                   GDT_CFloat32, "ISCE");
+    secondarySlc.setBlock(secData, 0, 0, width, length);
+
+    isce3::io::Raster interferogram("igram_ovs.int", width, length, 1,
+                                    GDT_CFloat32, "ISCE");
+
+    isce3::signal::Crossmul crsmul;
+    crsmul.rangeLooks(1);
+    crsmul.azimuthLooks(1);
+    crsmul.doCommonAzimuthbandFiltering(false);
+    crsmul.oversampleFactor(oversample);
+    crsmul.crossmul(referenceSlc, secondarySlc, interferogram);
+
+    std::valarray<std::complex<float>> data(width*length);
+    interferogram.getBlock(data, 0, 0, width, length);
+
+    // Reference: upsample each line with Signal::upsample, cross-multiply
+    // and take the oversample looks down
+    size_t fft_size;
+    isce3::signal::Signal<float>().nextPowerOfTwo(width, fft_size);
+    std::valarray<std::complex<float>> refLine(fft_size), secLine(fft_size),
+            spectrum(fft_size), spectrumUpsampled(oversample*fft_size),
+            refUpsampled(oversample*fft_size),
+            secUpsampled(oversample*fft_size),
+            shiftImpact(oversample*fft_size);
+    crsmul.lookdownShiftImpact(oversample, fft_size, 1, shiftImpact);
+
+    isce3::signal::Signal<float> refSignal, secSignal;
+    refSignal.forwardRangeFFT(refLine, spectrum, fft_size, 1);
+    refSignal.inverseRangeFFT(spectrumUpsampled, refUpsampled,
+                              oversample*fft_size, 1);
+    secSignal.forwardRangeFFT(secLine, spectrum, fft_size, 1);
+    secSignal.inverseRangeFFT(spectrumUpsampled, secUpsampled,
+                              oversample*fft_size, 1);
+
+    std::valarray<std::complex<float>> expected(width*length);
+    for (size_t line = 0; line < length; ++line) {
+        refLine = 0;
+        secLine = 0;
+        refLine[std::slice(0, width, 1)] =
+                refData[std::slice(line*width, width, 1)];
+        secLine[std::slice(0, width, 1)] =
+                secData[std::slice(line*width, width, 1)];
+        refSignal.upsample(refLine, refUpsampled, 1, fft_size, oversample,
+                           shiftImpact);
+        secSignal.upsample(secLine, secUpsampled, 1, fft_size, oversample,
+                           shiftImpact);
+        for (size_t col = 0; col < width; ++col) {
+            std::complex<float> sum = 0;
+            for (size_t j = 0; j < oversample; ++j)
+                sum += refUpsampled[col*oversample + j] *
+                       std::conj(secUpsampled[col*oversample + j]);
+            expected[line*width + col] = sum / (float) oversample;
+        }
+    }
+
+    double max_amp = 0.0, max_err = 0.0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        max_amp = std::max(max_amp, (double) std::abs(expected[i]));
+        max_err = std::max(max_err, (double) std::abs(data[i] - expected[i]));
+    }
+
+    ASSERT_GT(max_amp, 0.0);
+    ASSERT_LT(max_err, 1.0e-4*max_amp);
+}
+
 int main(int argc, char * argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,69 @@
+#include <cmath>
+#include <complex>
+#include <gtest/gtest.h>
+#include <valarray>
+
+#include <isce3/fft/PlanCache.h>
+#include <isce3/signal/FFTPlanCache.h>
+
+using isce3::signal::FFTPlanCache;
+
+TEST(FFTPlanCache, ReusePlans)
+{
+    isce3::fft::clearPlanCache();
+
+    const int n = 64, rows = 8;
+    std::valarray<std::complex<float>> a(n*rows), b(n*rows), c(n*rows);
+
+    const auto plan = FFTPlanCache<float>::rangePlan(&a[0], &b[0], n, rows,
+                                                     FFTW_FORWARD);
+    const size_t nplans = isce3::fft::planCacheSize();
+    ASSERT_EQ(nplans, 1u);
+
+    // same layout and alignment: cached plan is reused
+    EXPECT_EQ(FFTPlanCache<float>::rangePlan(&a[0], &b[0], n, rows,
+                                             FFTW_FORWARD), plan);
+    EXPECT_EQ(isce3::fft::planCacheSize(), nplans);
+
+    // different direction, size or in-place transform: new plans
+    FFTPlanCache<float>::rangePlan(&b[0], &c[0], n, rows, FFTW_BACKWARD);
+    FFTPlanCache<float>::rangePlan(&a[0], &b[0], n/2, 2*rows, FFTW_FORWARD);
+    FFTPlanCache<float>::rangePlan(&a[0], &a[0], n, rows, FFTW_FORWARD);
+    EXPECT_GE(isce3::fft::planCacheSize(), nplans + 3);
+
+    // plans handed out stay valid after the cache is cleared
+    isce3::fft::clearPlanCache();
+    EXPECT_EQ(isce3::fft::planCacheSize(), 0u);
+    a = std::complex<float>(1.0f, 0.0f);
+    FFTPlanCache<float>::execute(*plan, &a[0], &b[0]);
+    EXPECT_NEAR(std::abs(b[0] - std::complex<float>(n, 0.0f)), 0.0, 1.0e-4);
+}
+
+TEST(FFTPlanCache, ForwardBackwardRange)
+{
+    const int n = 128, rows = 16;
+    std::valarray<std::complex<float>> data(n*rows), spectrum(n*rows),
+            inverted(n*rows);
+    for (int i = 0; i < n*rows; ++i)
+        data[i] = std::complex<float>(std::cos(0.1*i), std::sin(0.03*i));
+
+    // run twice so that the second pass uses the cached plans
+    for (int pass = 0; pass < 2; ++pass) {
+        FFTPlanCache<float>::rangeFFT(&data[0], &spectrum[0], n, rows,
+                                      FFTW_FORWARD);
+        FFTPlanCache<float>::rangeFFT(&spectrum[0], &inverted[0], n, rows,
+                                      FFTW_BACKWARD);
+
+        double max_err = 0.0;
+        for (int i = 0; i < n*rows; ++i)
+            max_err = std::max(max_err,
+                               (double) std::abs(inverted[i] / (float) n -
+                                                 data[i]));
+        ASSERT_LT(max_err, 1.0e-5);
+    }
+}
+
+int main(int argc, char * argv[]) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
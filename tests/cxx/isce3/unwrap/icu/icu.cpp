@@ -1,7 +1,8 @@
 #include <cmath> // cos, sin, sqrt, fmod
 #include <complex> // std::complex, std::arg
-#include <cstdint> // uint8_t
-#include <gtest/gtest.h> // TEST, ASSERT_EQ, ASSERT_TRUE, testing::InitGoogleTest, RUN_ALL_TESTS
+#include <cstdint> // uint8_t, uint32_t, UINT8_MAX, UINT32_MAX
+#include <gtest/gtest.h> // TEST, ASSERT_EQ, ASSERT_TRUE, ASSERT_THROW, testing::InitGoogleTest, RUN_ALL_TESTS
+#include <stdexcept> // std::invalid_argument, std::out_of_range, std::overflow_error
 #include <valarray> // std::valarray, std::abs
 
 #include "isce3/unwrap/icu/ICU.h" // isce3::unwrap::icu::ICU
@@ -47,6 +48,46 @@ TEST(ICU, GetSetters)
     ASSERT_EQ(icuobj.minBsPts(), 12);
     icuobj.bsPhaseVarThr(3.f);
     ASSERT_EQ(icuobj.bsPhaseVarThr(), 3.f);
+    icuobj.parallelTiles(true);
+    ASSERT_EQ(icuobj.parallelTiles(), true);
+    icuobj.use32BitLabels(true);
+    ASSERT_EQ(icuobj.use32BitLabels(), true);
+}
+
+TEST(ICU, LabelMap)
+{
+    using isce3::unwrap::icu::LabelMap;
+    using isce3::unwrap::icu::label_t;
+
+    // Label 0 is reserved for unlabeled pixels.
+    LabelMap labelmap;
+    ASSERT_EQ(labelmap.size(), 1u);
+    for (label_t l = 1; l <= 6; ++l) { ASSERT_EQ(labelmap.nextlabel(), l); }
+
+    // Merged labels map to the minimum label of the class.
+    labelmap.setlabel(6, 4);
+    labelmap.setlabel(4, 5);
+    labelmap.setlabel(5, 2);
+    labelmap.setlabel(3, 1);
+    ASSERT_EQ(labelmap.getlabel(6), 2u);
+    ASSERT_EQ(labelmap.getlabel(4), 2u);
+    ASSERT_EQ(labelmap.getlabel(3), 1u);
+    ASSERT_EQ(labelmap.getlabel(2), 2u);
+
+    // Merging two classes keeps the overall minimum.
+    labelmap.setlabel(2, 3);
+    labelmap.flatten();
+    for (label_t l = 1; l <= 6; ++l) { ASSERT_EQ(labelmap.getlabel(l), 1u); }
+
+    // Default label map is limited to 8-bit labels.
+    LabelMap small;
+    for (int i = 1; i <= UINT8_MAX; ++i) { small.nextlabel(); }
+    ASSERT_THROW(small.nextlabel(), std::overflow_error);
+
+    // 32-bit label map is not.
+    LabelMap large(UINT32_MAX);
+    for (int i = 1; i <= 100000; ++i) { large.nextlabel(); }
+    ASSERT_EQ(large.size(), 100001u);
 }
 
 TEST(ICU, ResidueCalculation)
@@ -291,6 +332,90 @@ TEST(ICU, CheckConnCompLabels)
     ASSERT_TRUE((ccl == refccl).min());
 }
 
+TEST(ICU, RunICUParallelTiles)
+{
+    // Read interferogram, correlation from prior test.
+    isce3::io::Raster intfRaster("./intf");
+    isce3::io::Raster corrRaster("./corr");
+    const size_t l = intfRaster.length();
+    const size_t w = intfRaster.width();
+
+    // Unwrap the tiles concurrently.
+    isce3::io::Raster unwRaster("./unw_par", w, l, 1, GDT_Float32, "ENVI");
+    isce3::io::Raster cclRaster("./ccl_par", w, l, 1, GDT_Byte, "ENVI");
+
+    isce3::unwrap::icu::ICU icuobj;
+    icuobj.numBufLines(400);
+    icuobj.numOverlapLines(50);
+    icuobj.parallelTiles(true);
+
+    icuobj.unwrap(unwRaster, cclRaster, intfRaster, corrRaster);
+
+    // Results should be identical to sequential processing.
+    std::valarray<float> unw(l*w), refunw(l*w);
+    unwRaster.getBlock(unw, 0, 0, w, l);
+    isce3::io::Raster("./unw").getBlock(refunw, 0, 0, w, l);
+    ASSERT_TRUE((unw == refunw).min());
+
+    std::valarray<uint8_t> ccl(l*w), refccl(l*w);
+    cclRaster.getBlock(ccl, 0, 0, w, l);
+    isce3::io::Raster("./ccl").getBlock(refccl, 0, 0, w, l);
+    ASSERT_TRUE((ccl == refccl).min());
+}
+
+TEST(ICU, RunICU32BitLabels)
+{
+    // Read interferogram, correlation from prior test.
+    isce3::io::Raster intfRaster("./intf");
+    isce3::io::Raster corrRaster("./corr");
+    const size_t l = intfRaster.length();
+    const size_t w = intfRaster.width();
+
+    isce3::io::Raster unwRaster("./unw_32", w, l, 1, GDT_Float32, "ENVI");
+    isce3::io::Raster cclRaster("./ccl_32", w, l, 1, GDT_UInt32, "ENVI");
+
+    isce3::unwrap::icu::ICU icuobj;
+    icuobj.numBufLines(400);
+    icuobj.numOverlapLines(50);
+    icuobj.use32BitLabels(true);
+
+    // 32-bit labels require a 32-bit connected component raster.
+    isce3::io::Raster byteRaster("./ccl_32_byte", w, l, 1, GDT_Byte, "ENVI");
+    ASSERT_THROW(icuobj.unwrap(unwRaster, byteRaster, intfRaster, corrRaster),
+                 std::invalid_argument);
+
+    icuobj.unwrap(unwRaster, cclRaster, intfRaster, corrRaster);
+
+    // Labels should be the same as with 8-bit labels.
+    std::valarray<uint32_t> ccl(l*w), refccl(l*w);
+    cclRaster.getBlock(ccl, 0, 0, w, l);
+    isce3::io::Raster("./ccl").getBlock(refccl, 0, 0, w, l);
+    ASSERT_TRUE((ccl == refccl).min());
+}
+
+TEST(ICU, RunICUParallelTilesError)
+{
+    // Read interferogram, correlation from prior test.
+    isce3::io::Raster intfRaster("./intf");
+    isce3::io::Raster corrRaster("./corr");
+    const size_t l = intfRaster.length();
+    const size_t w = intfRaster.width();
+
+    isce3::io::Raster unwRaster("./unw_err", w, l, 1, GDT_Float32, "ENVI");
+    isce3::io::Raster cclRaster("./ccl_err", w, l, 1, GDT_Byte, "ENVI");
+
+    // Tiles too short for intensity neutron statistics fail in the tile 
+    // workers, and the failure is rethrown.
+    isce3::unwrap::icu::ICU icuobj;
+    icuobj.numBufLines(32);
+    icuobj.numOverlapLines(8);
+    icuobj.numBsLines(4);
+    icuobj.useIntensityNeut(true);
+    icuobj.parallelTiles(true);
+    ASSERT_THROW(icuobj.unwrap(unwRaster, cclRaster, intfRaster, corrRaster),
+                 std::out_of_range);
+}
+
 int main(int argc, char * argv[])
 {
     testing::InitGoogleTest(&argc, argv);
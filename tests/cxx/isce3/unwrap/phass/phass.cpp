@@ -1,7 +1,9 @@
-#include <cmath> // cos, sin, sqrt, fmod
+#include <cmath> // cos, sin, sqrt, fmod, round, M_PI
 #include <complex> // std::complex, std::arg
 #include <cstdint> // uint8_t
-#include <gtest/gtest.h> // TEST, ASSERT_EQ, ASSERT_TRUE, testing::InitGoogleTest, RUN_ALL_TE  STS
+#include <gtest/gtest.h> // TEST, ASSERT_EQ, ASSERT_NE, ASSERT_TRUE, testing::InitGoogleTest, RUN_ALL_TE  STS
+#include <map> // std::map
+#include <utility> // std::pair, std::make_pair
 #include <valarray> // std::valarray, std::abs
 
 #include "isce3/unwrap/phass/Phass.h" // isce3::unwrap::phass::Phass
@@ -23,6 +25,12 @@ TEST(Phass, GetSetters)
     phassObj.minPixelsPerRegion(100);
     ASSERT_EQ(phassObj.minPixelsPerRegion(), 100);
 
+    phassObj.numBufLines(400);
+    ASSERT_EQ(phassObj.numBufLines(), 400);
+
+    phassObj.numOverlapLines(100);
+    ASSERT_EQ(phassObj.numOverlapLines(), 100);
+
 }
 
 
@@ -89,6 +97,59 @@ TEST(Phass, CheckConnCompLabels)
 }
 
 
+TEST(Phass, CheckTiledUnwrap)
+{
+    // Read wrapped phase, correlation from prior test.
+    isce3::io::Raster wrappedPhaseRaster("./intf");
+    isce3::io::Raster corrRaster("./corr");
+    const size_t l = wrappedPhaseRaster.length();
+    const size_t w = wrappedPhaseRaster.width();
+
+    // Unwrap in tiles that split both connected components.
+    isce3::io::Raster unwRaster("./unw_tiled", w, l, 1, GDT_Float32, "ENVI");
+    isce3::io::Raster labelsRaster("./labels_tiled", w, l, 1, GDT_Int32, "ENVI");
+
+    isce3::unwrap::phass::Phass phassObj;
+    phassObj.numBufLines(400);
+    phassObj.numOverlapLines(100);
+    phassObj.unwrap(wrappedPhaseRaster, corrRaster, unwRaster, labelsRaster);
+
+    std::valarray<float> unw(l*w), refunw(l*w);
+    unwRaster.getBlock(unw, 0, 0, w, l);
+    isce3::io::Raster("./unw").getBlock(refunw, 0, 0, w, l);
+
+    std::valarray<int> ccl(l*w), refccl(l*w);
+    labelsRaster.getBlock(ccl, 0, 0, w, l);
+    isce3::io::Raster("./labels").getBlock(refccl, 0, 0, w, l);
+
+    // Each connected component should have a single label, and its 
+    // unwrapped phase should only differ from the untiled result by a 
+    // constant number of cycles.
+    std::map<int, std::pair<int, float>> components;
+    for (size_t i = 0; i < l*w; ++i)
+    {
+        ASSERT_EQ(ccl[i] != 0, refccl[i] != 0);
+        if (refccl[i] == 0) { continue; }
+
+        const float offset = unw[i] - refunw[i];
+        auto it = components.find(refccl[i]);
+        if (it == components.end())
+        {
+            const float cycles = offset / (2 * M_PI);
+            ASSERT_TRUE(std::abs(cycles - std::round(cycles)) < 1e-3);
+            components[refccl[i]] = std::make_pair(ccl[i], offset);
+            continue;
+        }
+        ASSERT_EQ(ccl[i], it->second.first);
+        ASSERT_TRUE(std::abs(offset - it->second.second) < 1e-3);
+    }
+
+    // Distinct components should have distinct labels.
+    ASSERT_EQ(components.size(), 2u);
+    ASSERT_NE(components[1].first, components[2].first);
+}
+
+
 int main(int argc, char * argv[])
 {
     testing::InitGoogleTest(&argc, argv);